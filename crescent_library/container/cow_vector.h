@@ -0,0 +1,348 @@
+#ifndef COW_VECTOR_H
+#define COW_VECTOR_H
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace crsc {
+	/**
+	 * \class cow_allocator
+	 *
+	 * \brief Allocator requesting copy-on-write storage from the containers which recognise it.
+	 *
+	 * `dynamic_matrix<Ty, cow_allocator<Ty>>` stores its elements in a `cow_vector`, such that copies of a matrix
+	 * share one buffer until either is modified. Every other container (and every function which creates temporary
+	 * storage with the allocator of a matrix) treats it as `Allocator`, from which all allocations are made.
+	 *
+	 * \tparam Ty Type of the elements.
+	 * \tparam Allocator Allocator used for the shared storage.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>
+	> class cow_allocator : public std::allocator_traits<Allocator>::template rebind_alloc<Ty> {
+	public:
+		typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Ty> base_type;
+		typedef Ty value_type;
+		template<class Uty>
+		struct rebind {
+			typedef cow_allocator<Uty, typename std::allocator_traits<Allocator>::template rebind_alloc<Uty>> other;
+		};
+		cow_allocator() noexcept(noexcept(base_type())) {}
+		cow_allocator(const base_type& _alloc) noexcept : base_type(_alloc) {}
+		template<class Uty, class UAllocator>
+		cow_allocator(const cow_allocator<Uty, UAllocator>& _other) noexcept
+			: base_type(static_cast<const UAllocator&>(_other)) {}
+	};
+	template<typename Ty, typename Uty, class Allocator, class UAllocator>
+	bool operator==(const cow_allocator<Ty, Allocator>& _lhs, const cow_allocator<Uty, UAllocator>& _rhs) noexcept {
+		return static_cast<const typename cow_allocator<Ty, Allocator>::base_type&>(_lhs)
+			== static_cast<const typename cow_allocator<Uty, UAllocator>::base_type&>(_rhs);
+	}
+	template<typename Ty, typename Uty, class Allocator, class UAllocator>
+	bool operator!=(const cow_allocator<Ty, Allocator>& _lhs, const cow_allocator<Uty, UAllocator>& _rhs) noexcept {
+		return !(_lhs == _rhs);
+	}
+	/**
+	 * \class cow_vector
+	 *
+	 * \brief A sequence container with the interface of `std::vector` whose copies share a single buffer, through an
+	 *        atomic reference count, until one of them is accessed mutably.
+	 *
+	 * Copy construction and copy assignment are constant time. The first call of any non-const member function
+	 * (including non-const `operator[]`, `data()` and `begin()`) on a container whose buffer is shared copies the
+	 * buffer, after which the container is its sole owner and behaves exactly as a `std::vector`. Reads through a
+	 * const container never copy, so a matrix passed by value through stages which only read it is never duplicated.
+	 *
+	 * Distinct containers sharing a buffer may be used concurrently from different threads, as may distinct
+	 * `std::vector`s; a single container requires external synchronisation as usual.
+	 *
+	 * \remark References, pointers and iterators obtained from a non-const container remain valid across a later copy
+	 *         of that container, so writing through them after the copy is also visible through the copy. Obtain them
+	 *         after copying, or access the copied-from container as const.
+	 * \tparam Ty Type of the elements.
+	 * \tparam Allocator Allocator of the elements and of the shared buffer.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>
+	> class cow_vector {
+		typedef std::vector<Ty, Allocator> vector_type;
+		typedef std::allocator_traits<Allocator> alloc_traits;
+		// shared buffer: the elements together with the number of containers referring to them
+		struct block {
+			template<class... Args>
+			explicit block(Args&&... _args) : refs(1U), vec(std::forward<Args>(_args)...) {}
+			std::atomic<std::size_t> refs;
+			vector_type vec;
+		};
+		typedef typename alloc_traits::template rebind_alloc<block> block_allocator;
+		typedef std::allocator_traits<block_allocator> block_traits;
+	public:
+		// PUBLIC API TYPE DEFINITIONS
+		typedef Ty value_type;
+		typedef Allocator allocator_type;
+		typedef typename vector_type::size_type size_type;
+		typedef typename vector_type::difference_type difference_type;
+		typedef Ty& reference;
+		typedef const Ty& const_reference;
+		typedef typename vector_type::pointer pointer;
+		typedef typename vector_type::const_pointer const_pointer;
+		typedef typename vector_type::iterator iterator;
+		typedef typename vector_type::const_iterator const_iterator;
+		typedef typename vector_type::reverse_iterator reverse_iterator;
+		typedef typename vector_type::const_reverse_iterator const_reverse_iterator;
+		// CONSTRUCTION/ASSIGNMENT
+		cow_vector() noexcept(noexcept(Allocator())) : cow_vector(Allocator()) {}
+		explicit cow_vector(const Allocator& _alloc) noexcept : alloc(_alloc), ptr(nullptr) {}
+		explicit cow_vector(size_type _count, const Allocator& _alloc = Allocator()) : alloc(_alloc), ptr(nullptr) {
+			if (_count) ptr = make(_alloc, _count);
+		}
+		cow_vector(size_type _count, const value_type& _val, const Allocator& _alloc = Allocator()) : alloc(_alloc), ptr(nullptr) {
+			if (_count) ptr = make(_alloc, _count, _val);
+		}
+		template<class InputIt,
+			class = std::enable_if_t<!std::is_integral<InputIt>::value>
+		> cow_vector(InputIt _first, InputIt _last, const Allocator& _alloc = Allocator()) : alloc(_alloc), ptr(nullptr) {
+			if (_first != _last) ptr = make(_alloc, _first, _last);
+		}
+		cow_vector(std::initializer_list<value_type> _init_list, const Allocator& _alloc = Allocator())
+			: cow_vector(_init_list.begin(), _init_list.end(), _alloc) {}
+		/**
+		 * \brief Copy constructor. Shares the buffer of `_other`, unless the allocator selected for the copy does
+		 *        not compare equal to that of `_other`, in which case the elements are copied.
+		 *
+		 * \complexity Constant if the buffer is shared, otherwise linear in `_other.size()`.
+		 */
+		cow_vector(const cow_vector& _other)
+			: cow_vector(_other, alloc_traits::select_on_container_copy_construction(_other.alloc)) {}
+		cow_vector(const cow_vector& _other, const Allocator& _alloc) : alloc(_alloc), ptr(nullptr) {
+			if (!_other.ptr) return;
+			if (_alloc == _other.alloc) {
+				ptr = _other.ptr;
+				ptr->refs.fetch_add(1U, std::memory_order_relaxed);
+			}
+			else ptr = make(_alloc, _other.ptr->vec);
+		}
+		cow_vector(cow_vector&& _other) noexcept : alloc(std::move(_other.alloc)), ptr(_other.ptr) {
+			_other.ptr = nullptr;
+		}
+		cow_vector(cow_vector&& _other, const Allocator& _alloc) : alloc(_alloc), ptr(nullptr) {
+			if (!_other.ptr) return;
+			if (_alloc == _other.alloc) std::swap(ptr, _other.ptr);
+			else ptr = make(_alloc, _other.ptr->vec);
+		}
+		~cow_vector() { release(); }
+		cow_vector& operator=(const cow_vector& _other) {
+			if (this != &_other) cow_vector(_other).swap(*this);
+			return *this;
+		}
+		cow_vector& operator=(cow_vector&& _other) noexcept {
+			if (this != &_other) {
+				release();
+				alloc = std::move(_other.alloc);
+				ptr = _other.ptr;
+				_other.ptr = nullptr;
+			}
+			return *this;
+		}
+		cow_vector& operator=(std::initializer_list<value_type> _init_list) {
+			assign(_init_list.begin(), _init_list.end());
+			return *this;
+		}
+		template<class InputIt,
+			class = std::enable_if_t<!std::is_integral<InputIt>::value>
+		> void assign(InputIt _first, InputIt _last) {
+			cow_vector(_first, _last, alloc).swap(*this);
+		}
+		void assign(size_type _count, const value_type& _val) {
+			cow_vector(_count, _val, alloc).swap(*this);
+		}
+		allocator_type get_allocator() const { return alloc; }
+		// SHARING
+		/**
+		 * \brief Returns the number of containers sharing the buffer of this container, zero if it has no buffer.
+		 *
+		 * \remark The value may be stale by the time it is used if other containers sharing the buffer are
+		 *         concurrently copied or destroyed.
+		 */
+		size_type use_count() const noexcept { return ptr ? ptr->refs.load(std::memory_order_acquire) : 0U; }
+		/**
+		 * \brief Ensures that this container is the sole owner of its buffer, copying the buffer if it is shared.
+		 *
+		 * \complexity Linear in `size()` if the buffer is shared, otherwise constant.
+		 */
+		void detach() { mut(); }
+		// CAPACITY
+		bool empty() const noexcept { return get().empty(); }
+		size_type size() const noexcept { return get().size(); }
+		size_type max_size() const noexcept { return get().max_size(); }
+		size_type capacity() const noexcept { return get().capacity(); }
+		void reserve(size_type _new_cap) {
+			if (_new_cap > capacity()) mut().reserve(_new_cap);
+		}
+		/**
+		 * \brief Reduces the capacity to `size()`. Has no effect while the buffer is shared.
+		 */
+		void shrink_to_fit() {
+			if (ptr && use_count() == 1U) ptr->vec.shrink_to_fit();
+		}
+		// ELEMENT ACCESS
+		reference at(size_type _pos) { return mut().at(_pos); }
+		const_reference at(size_type _pos) const { return get().at(_pos); }
+		reference operator[](size_type _pos) { return mut()[_pos]; }
+		const_reference operator[](size_type _pos) const { return get()[_pos]; }
+		reference front() { return mut().front(); }
+		const_reference front() const { return get().front(); }
+		reference back() { return mut().back(); }
+		const_reference back() const { return get().back(); }
+		pointer data() { return mut().data(); }
+		const_pointer data() const noexcept { return get().data(); }
+		// ITERATORS
+		iterator begin() { return mut().begin(); }
+		const_iterator begin() const noexcept { return get().begin(); }
+		const_iterator cbegin() const noexcept { return get().cbegin(); }
+		iterator end() { return mut().end(); }
+		const_iterator end() const noexcept { return get().end(); }
+		const_iterator cend() const noexcept { return get().cend(); }
+		reverse_iterator rbegin() { return mut().rbegin(); }
+		const_reverse_iterator rbegin() const noexcept { return get().rbegin(); }
+		const_reverse_iterator crbegin() const noexcept { return get().crbegin(); }
+		reverse_iterator rend() { return mut().rend(); }
+		const_reverse_iterator rend() const noexcept { return get().rend(); }
+		const_reverse_iterator crend() const noexcept { return get().crend(); }
+		// MODIFIERS
+		/**
+		 * \brief Removes all elements, releasing a shared buffer rather than copying it.
+		 */
+		void clear() noexcept {
+			if (ptr && use_count() == 1U) ptr->vec.clear();
+			else release();
+		}
+		// positions are converted to offsets before detaching, as detaching invalidates iterators into a shared buffer
+		iterator insert(const_iterator _pos, const value_type& _val) {
+			const difference_type off = _pos - cbegin();
+			vector_type& v = mut();
+			return v.insert(v.cbegin() + off, _val);
+		}
+		iterator insert(const_iterator _pos, value_type&& _val) {
+			const difference_type off = _pos - cbegin();
+			vector_type& v = mut();
+			return v.insert(v.cbegin() + off, std::move(_val));
+		}
+		iterator insert(const_iterator _pos, size_type _count, const value_type& _val) {
+			const difference_type off = _pos - cbegin();
+			vector_type& v = mut();
+			return v.insert(v.cbegin() + off, _count, _val);
+		}
+		template<class InputIt,
+			class = std::enable_if_t<!std::is_integral<InputIt>::value>
+		> iterator insert(const_iterator _pos, InputIt _first, InputIt _last) {
+			const difference_type off = _pos - cbegin();
+			vector_type& v = mut();
+			return v.insert(v.cbegin() + off, _first, _last);
+		}
+		iterator insert(const_iterator _pos, std::initializer_list<value_type> _init_list) {
+			return insert(_pos, _init_list.begin(), _init_list.end());
+		}
+		template<class... Args>
+		iterator emplace(const_iterator _pos, Args&&... _args) {
+			const difference_type off = _pos - cbegin();
+			vector_type& v = mut();
+			return v.emplace(v.cbegin() + off, std::forward<Args>(_args)...);
+		}
+		iterator erase(const_iterator _pos) {
+			const difference_type off = _pos - cbegin();
+			vector_type& v = mut();
+			return v.erase(v.cbegin() + off);
+		}
+		iterator erase(const_iterator _first, const_iterator _last) {
+			const difference_type first = _first - cbegin(), last = _last - cbegin();
+			vector_type& v = mut();
+			return v.erase(v.cbegin() + first, v.cbegin() + last);
+		}
+		void push_back(const value_type& _val) { mut().push_back(_val); }
+		void push_back(value_type&& _val) { mut().push_back(std::move(_val)); }
+		template<class... Args>
+		reference emplace_back(Args&&... _args) {
+			vector_type& v = mut();
+			v.emplace_back(std::forward<Args>(_args)...);
+			return v.back();
+		}
+		void pop_back() { mut().pop_back(); }
+		void resize(size_type _count) {
+			if (_count != size()) mut().resize(_count);
+		}
+		void resize(size_type _count, const value_type& _val) {
+			if (_count != size()) mut().resize(_count, _val);
+		}
+		/**
+		 * \brief Exchanges the buffers, and the allocators, of this container and `_other`.
+		 *
+		 * \complexity Constant.
+		 */
+		void swap(cow_vector& _other) noexcept {
+			using std::swap;
+			swap(alloc, _other.alloc);
+			swap(ptr, _other.ptr);
+		}
+	private:
+		allocator_type alloc;
+		block* ptr;
+		static const vector_type& empty_vector() {
+			static const vector_type v;
+			return v;
+		}
+		const vector_type& get() const noexcept { return ptr ? ptr->vec : empty_vector(); }
+		// allocates a buffer whose elements are constructed from (_args..., _alloc)
+		template<class... Args>
+		static block* make(const Allocator& _alloc, Args&&... _args) {
+			block_allocator balloc(_alloc);
+			block* p = block_traits::allocate(balloc, 1U);
+			try {
+				block_traits::construct(balloc, p, std::forward<Args>(_args)..., _alloc);
+			}
+			catch (...) {
+				block_traits::deallocate(balloc, p, 1U);
+				throw;
+			}
+			return p;
+		}
+		// the buffer for mutation, allocated if absent and copied if shared
+		vector_type& mut() {
+			if (!ptr) ptr = make(alloc);
+			else if (ptr->refs.load(std::memory_order_acquire) != 1U) {
+				block* copy = make(alloc, ptr->vec);
+				release();
+				ptr = copy;
+			}
+			return ptr->vec;
+		}
+		void release() noexcept {
+			if (ptr && ptr->refs.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+				block_allocator balloc(alloc);
+				block_traits::destroy(balloc, ptr);
+				block_traits::deallocate(balloc, ptr, 1U);
+			}
+			ptr = nullptr;
+		}
+	};
+	template<typename Ty, class Allocator>
+	bool operator==(const cow_vector<Ty, Allocator>& _lhs, const cow_vector<Ty, Allocator>& _rhs) {
+		return _lhs.size() == _rhs.size() && (_lhs.data() == _rhs.data() || std::equal(_lhs.cbegin(), _lhs.cend(), _rhs.cbegin()));
+	}
+	template<typename Ty, class Allocator>
+	bool operator!=(const cow_vector<Ty, Allocator>& _lhs, const cow_vector<Ty, Allocator>& _rhs) {
+		return !(_lhs == _rhs);
+	}
+	template<typename Ty, class Allocator>
+	void swap(cow_vector<Ty, Allocator>& _lhs, cow_vector<Ty, Allocator>& _rhs) noexcept {
+		_lhs.swap(_rhs);
+	}
+}
+
+#endif // !COW_VECTOR_H
@@ -1,11 +1,14 @@
 #ifndef DYNAMIC_ARRAY_H
 #define DYNAMIC_ARRAY_H
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <initializer_list>
 #include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 template<typename T> class dynamic_array_const_iterator;
 
@@ -160,19 +163,55 @@ bool operator>=(const dynamic_array_iterator<Ty>& iter, const dynamic_array_cons
 	return iter.get_ptr() >= citer.get_ptr();
 }
 
+/**
+* \struct geometric_growth
+*
+* \brief Growth policy of `dynamic_array` multiplying the capacity by `Num / Den` (e.g. 2 or 1.5) whenever
+*        an insertion exceeds it, such that building an array element by element costs amortized constant
+*        time per element. The first allocation is of at least `Initial` elements.
+*/
+template<std::size_t Num = 2,
+	std::size_t Den = 1,
+	std::size_t Initial = 8
+>
+struct geometric_growth {
+	static_assert(Den > 0 && Num > Den, "geometric_growth factor must be greater than one.");
+	// capacity to allocate when `required` elements no longer fit in `capacity`
+	static std::size_t next_capacity(std::size_t capacity, std::size_t required) noexcept {
+		const std::size_t increase = capacity / Den * (Num - Den) + capacity % Den * (Num - Den) / Den;
+		return std::max({ required, Initial, capacity + std::max<std::size_t>(increase, 1) });
+	}
+};
+
 /**
 * \class dynamic_array
 *
 * \brief A container storing an array in contiguous storage with methods to expand and contract
 *        the storage as necessary.
 *
-* \tparam The type of the stored elements.
+* Storage is obtained uninitialized from `Allocator` and elements are constructed in place
+* (via `std::allocator_traits`) only as they are added, so the capacity beyond `size()` costs
+* no constructions. On reallocation elements are moved (or copied, if their move constructor
+* may throw) into the new storage, or copied bytewise when `Ty` is trivially copyable.
+*
+* \tparam Ty The type of the stored elements.
+* \tparam Allocator The type of the allocator used to acquire and release storage and to
+*         construct and destroy the elements.
+* \tparam GrowthPolicy The type providing `next_capacity(capacity, required)`, the capacity to
+*         reallocate to when inserting would exceed the current capacity (see `geometric_growth`).
 */
-template<typename Ty>
+template<typename Ty,
+	class Allocator = std::allocator<Ty>,
+	class GrowthPolicy = geometric_growth<>
+>
 class dynamic_array {
+	typedef std::allocator_traits<Allocator> alloc_traits;
+	static_assert(std::is_same<typename alloc_traits::pointer, Ty*>::value,
+		"dynamic_array requires an allocator whose pointer type is Ty*.");
 public:
 	// PUBLIC API TYPE DEFINITIONS
 	typedef Ty value_type;
+	typedef Allocator allocator_type;
 	typedef Ty& reference;
 	typedef const Ty& const_reference;
 	typedef Ty* pointer;
@@ -184,43 +223,65 @@ public:
 	typedef std::reverse_iterator<iterator> reverse_iterator;
 	typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 	// CONSTRUCTION/ASSIGNMENT
-	dynamic_array()
-		: arr_capacity(0), arr_size(0) { allocate(0); }
-	dynamic_array(size_type count)
-		: arr_capacity(count), arr_size(count) { allocate(count); }
-	dynamic_array(size_type count, const value_type& _val)
-		: arr_capacity(count), arr_size(count) { allocate(count); fill(_val); }
-	dynamic_array(const dynamic_array& _other)
-		: arr_capacity(_other.arr_capacity), arr_size(_other.arr_size) { 
-		allocate(arr_capacity);
-		std::copy(_other.arr, _other.arr + _other.arr_size, arr);
+	dynamic_array() : dynamic_array(allocator_type()) {}
+	explicit dynamic_array(const allocator_type& _alloc)
+		: alloc(_alloc), arr(nullptr), arr_capacity(0), arr_size(0) {}
+	explicit dynamic_array(size_type count, const allocator_type& _alloc = allocator_type())
+		: dynamic_array(_alloc) {
+		arr = allocate(count);
+		arr_capacity = count;
+		construct_default(arr, count);
+		arr_size = count;
+	}
+	dynamic_array(size_type count, const value_type& _val, const allocator_type& _alloc = allocator_type())
+		: dynamic_array(_alloc) {
+		arr = allocate(count);
+		arr_capacity = count;
+		construct_fill(arr, count, _val);
+		arr_size = count;
 	}
-	dynamic_array(dynamic_array&& _other)
-		: arr_capacity(std::move(_other.arr_capacity)), arr_size(std::move(_other.arr_size)) {
-		allocate(arr_capacity);
-		std::move(_other.arr, _other.arr + arr_size, arr);
-	}
-	dynamic_array(std::initializer_list<value_type> ilist)
-		: arr_capacity(ilist.size()), arr_size(ilist.size()) {
-		allocate(arr_capacity);
-		std::move(ilist.begin(), ilist.end(), arr);
+	dynamic_array(const dynamic_array& _other)
+		: dynamic_array(_other, alloc_traits::select_on_container_copy_construction(_other.alloc)) {}
+	dynamic_array(const dynamic_array& _other, const allocator_type& _alloc)
+		: dynamic_array(_alloc) {	// copies only the elements, the copy's capacity is _other.size()
+		arr = allocate(_other.arr_size);
+		arr_capacity = _other.arr_size;
+		construct_copy(_other.arr, _other.arr_size, arr);
+		arr_size = _other.arr_size;
+	}
+	dynamic_array(dynamic_array&& _other) noexcept
+		: alloc(std::move(_other.alloc)), arr(_other.arr), arr_capacity(_other.arr_capacity), arr_size(_other.arr_size) {
+		_other.arr = nullptr;	// _other is left empty, its storage now owned by this
+		_other.arr_capacity = 0;
+		_other.arr_size = 0;
+	}
+	dynamic_array(std::initializer_list<value_type> ilist, const allocator_type& _alloc = allocator_type())
+		: dynamic_array(_alloc) {
+		arr = allocate(ilist.size());
+		arr_capacity = ilist.size();
+		construct_copy(ilist.begin(), ilist.size(), arr);
+		arr_size = ilist.size();
 	}
 	~dynamic_array() { destroy(); }
 	dynamic_array& operator=(const dynamic_array& _other) { // copy-assign
-		if (this != &_other)
-			dynamic_array<value_type>(_other).swap(*this);
+		if (this != &_other) {
+			dynamic_array tmp(_other, alloc_traits::propagate_on_container_copy_assignment::value ? _other.alloc : alloc);
+			swap_storage(tmp);
+			if (alloc_traits::propagate_on_container_copy_assignment::value) std::swap(alloc, tmp.alloc);
+		}
 		return *this;
 	}
-	dynamic_array& operator=(dynamic_array&& _other) { // move-assign
-		destroy();
-		arr = _other.arr;
-		_other.arr = nullptr;
+	dynamic_array& operator=(dynamic_array&& _other) noexcept(alloc_traits::propagate_on_container_move_assignment::value) { // move-assign
+		if (this != &_other)
+			move_assign(_other, typename alloc_traits::propagate_on_container_move_assignment());
 		return *this;
 	}
+	allocator_type get_allocator() const { return alloc; }
 	// CAPACITY
-	bool empty() const noexcept { return arr_size; }
+	bool empty() const noexcept { return !arr_size; }
 	size_type size() const noexcept { return arr_size; }
 	size_type capacity() const noexcept { return arr_capacity; }
+	size_type max_size() const noexcept { return alloc_traits::max_size(alloc); }
 	void reserve(size_type new_cap) { if (new_cap > arr_capacity) reallocate(new_cap); }
 	void shrink_to_fit() { if (arr_size < arr_capacity) reallocate(arr_size); }
 	// ELEMENT ACCESS
@@ -234,13 +295,11 @@ public:
 		if (!(n < arr_size)) throw std::out_of_range("dynamic_array index out of bounds.");
 		return arr[n];
 	}
-	pointer data() { return &arr[0]; }
-	const_pointer data() const { return &arr[0]; }
+	pointer data() noexcept { return arr; }
+	const_pointer data() const noexcept { return arr; }
 	// MODIFIERS
-	void clear() {
-		for (size_type i = 0; i < arr_size; ++i) { // destruct each element
-			(&arr[i])->~value_type();
-		}
+	void clear() noexcept {	// destruct each element, retaining the storage
+		destroy_range(arr, arr_size);
 		arr_size = 0;
 	}
 	iterator erase(const_iterator pos) {	// erase element at position pos
@@ -279,105 +338,253 @@ public:
 		return iterator(&arr[pos_index]);
 	}
 	iterator insert(const_iterator pos, size_type count, const value_type& _val) {	// insert count copies of _val at position pos
-		while (count) {
-			pos = insert(pos, _val);
-			--count;
+		const size_type pos_index = std::distance(cbegin(), pos);
+		const size_type old_size = arr_size;
+		if (arr_size + count > arr_capacity) {
+			reallocate_with(GrowthPolicy::next_capacity(arr_capacity, arr_size + count), count,
+				[this, count, &_val](value_type* dst) { construct_fill(dst, count, _val); });
 		}
-		return iterator(&arr[std::distance(cbegin(), pos)]);
-	}
-	template<class InputIt>
-	iterator insert(const_iterator pos, InputIt first, InputIt last) {	// insert range of elements in [first, last) at position pos
-		while (last != first) pos = insert(pos, *(--last));
-		return iterator(&arr[std::distance(cbegin(), pos)]);
-	}
-	void push_back(const value_type& _val) {	// push _val to back of container
-		// if size of container has reached capacity perform
-		// reallocation to larger storage 
-		if (arr_size == arr_capacity) reallocate((arr_capacity != 0) ? arr_capacity * 2 : 8);
-		// use placement-new to push back _val
-		pointer val = new (arr + arr_size) value_type(_val);
-		++arr_size;
-	}
-	void push_back(value_type&& _val) {		// push _val to back of container via move-semantics
-		// if size of container has reached capacity perform
-		// reallocation to larger storage 
-		if (arr_size == arr_capacity) reallocate((arr_capacity != 0) ? arr_capacity * 2 : 8);
-		// use placement-new to push back _val
-		pointer val = new (arr + arr_size) value_type(std::move(_val));
-		++arr_size;
+		else {
+			construct_fill(arr + arr_size, count, _val);
+			arr_size += count;
+		}
+		std::rotate(arr + pos_index, arr + old_size, arr + arr_size);	// copies appended, then rotated into place
+		return iterator(arr + pos_index);
+	}
+	template<class InputIt,
+		class = std::enable_if_t<!std::is_integral<InputIt>::value>
+	> iterator insert(const_iterator pos, InputIt first, InputIt last) {	// insert range of elements in [first, last) at position pos
+		const size_type pos_index = std::distance(cbegin(), pos);
+		const size_type old_size = arr_size;
+		append(first, last);
+		std::rotate(arr + pos_index, arr + old_size, arr + arr_size);
+		return iterator(arr + pos_index);
+	}
+	template<class InputIt,
+		class = std::enable_if_t<!std::is_integral<InputIt>::value>
+	> void append(InputIt first, InputIt last) {	// append range of elements in [first, last), reserving once for forward iterators
+		append_range(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+	}
+	template<class... Args>
+	reference emplace_back(Args&&... args) {	// construct element in place at back of container from args
+		if (arr_size == arr_capacity) {
+			// the element is constructed in the new storage before the existing elements are moved, such
+			// that args may refer to an element of this container
+			reallocate_with(GrowthPolicy::next_capacity(arr_capacity, arr_size + 1), 1,
+				[this, &args...](value_type* dst) { alloc_traits::construct(alloc, dst, std::forward<Args>(args)...); });
+		}
+		else {
+			alloc_traits::construct(alloc, arr + arr_size, std::forward<Args>(args)...);
+			++arr_size;
+		}
+		return arr[arr_size - 1];
 	}
+	void push_back(const value_type& _val) { emplace_back(_val); }	// push _val to back of container
+	void push_back(value_type&& _val) { emplace_back(std::move(_val)); }	// push _val to back of container via move-semantics
 	void pop_back() {	// remove last element of container
-		(&arr[arr_size - 1])->~value_type();	// destruct last element
+		alloc_traits::destroy(alloc, arr + arr_size - 1);	// destruct last element
 		--arr_size;
 	}
-	void resize(size_type count) {	// resize container to contain count elements
-		if (count == arr_size) return;
-		size_type tmp_size_cpy = arr_size;
-		if (count > arr_size) { // expand container
-			reallocate(count); // reallocate storage to count elements
-							   // push back count - arr_size default-constructed values
-			for (size_type i = 0; i < count - tmp_size_cpy; ++i)
-				push_back(std::move(value_type()));
+	void resize(size_type count) {	// resize container to contain count elements, extra elements value-initialized
+		if (count <= arr_size) { // contract container
+			destroy_range(arr + count, arr_size - count);
+			arr_size = count;
 		}
-		else if (count < arr_size) { // contract container
-									 // pop back size() - count elements
-			for (size_type i = 0; i < tmp_size_cpy - count; ++i)
-				pop_back();
+		else { // expand container, constructing the count - size() new elements in one pass
+			const size_type n = count - arr_size;
+			if (count > arr_capacity) reallocate_with(GrowthPolicy::next_capacity(arr_capacity, count), n,
+				[this, n](value_type* dst) { construct_default(dst, n); });
+			else {
+				construct_default(arr + arr_size, n);
+				arr_size = count;
+			}
 		}
 	}
 	void resize(size_type count, const value_type& _val) {	// resize container where extra values take value _val
-		if (count == arr_size) return;
-		size_type tmp_size_cpy = arr_size;
-		if (count > arr_size) { // expand container
-			reallocate(count); // realloc storage to count elements
-							   // push back count - arr_size copies of _val
-			for (size_type i = 0; i < count - tmp_size_cpy; ++i)
-				push_back(_val);
+		if (count <= arr_size) { // contract container
+			destroy_range(arr + count, arr_size - count);
+			arr_size = count;
 		}
-		else if (count < arr_size) { // contract container
-									 // pop back size() - count elements
-			for (size_type i = 0; i < tmp_size_cpy - count; ++i)
-				pop_back();
+		else { // expand container, _val may be an element of this container
+			const size_type n = count - arr_size;
+			if (count > arr_capacity) reallocate_with(GrowthPolicy::next_capacity(arr_capacity, count), n,
+				[this, n, &_val](value_type* dst) { construct_fill(dst, n, _val); });
+			else {
+				construct_fill(arr + arr_size, n, _val);
+				arr_size = count;
+			}
 		}
 	}
-	void swap(dynamic_array& _other) {	// exchange contents of container with those of _other
-		std::swap(arr, _other.arr);
-		std::swap(arr_capacity, _other.arr_capacity);
-		std::swap(arr_size, _other.arr_size);
+	void swap(dynamic_array& _other) noexcept {	// exchange contents of container with those of _other
+		swap_storage(_other);
+		if (alloc_traits::propagate_on_container_swap::value) std::swap(alloc, _other.alloc);
 	}
-	static void swap(dynamic_array& lhs, dynamic_array& rhs) { lhs.swap(rhs); }
+	static void swap(dynamic_array& lhs, dynamic_array& rhs) noexcept { lhs.swap(rhs); }
 	// ITERATORS
-	iterator begin() const noexcept { return iterator(&arr[0]); }
-	iterator end() const noexcept { return iterator(&arr[arr_size]); }
-	const_iterator cbegin() const noexcept { return const_iterator(&arr[0]); }
-	const_iterator cend() const noexcept { return const_iterator(&arr[arr_size]); }
-	reverse_iterator rbegin() const noexcept { return reverse_iterator(&arr[0]); }
-	reverse_iterator rend() const noexcept { return reverse_iterator(&arr[arr_size]); }
-	const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(&arr[0]); }
-	const_reverse_iterator crend() const noexcept { return const_reverse_iterator(&arr[arr_size]); }
+	iterator begin() const noexcept { return iterator(arr); }
+	iterator end() const noexcept { return iterator(arr + arr_size); }
+	const_iterator cbegin() const noexcept { return const_iterator(arr); }
+	const_iterator cend() const noexcept { return const_iterator(arr + arr_size); }
+	reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+	reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+	const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+	const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
 private:
+	allocator_type alloc;
 	value_type* arr;
 	size_type arr_capacity;
 	size_type arr_size;
-	void allocate(size_type n) {	// dynamically allocate memory to array
-		arr = new value_type[n];
-	}
-	void reallocate(size_type new_cap) {	// rellocate array memory to new_cap block
-		value_type* tmp = new value_type[new_cap];	// allocate temp array
-		size_type tmp_rows = (new_cap > arr_capacity) ? arr_capacity : new_cap;
-		// move all elements from arr to temp array
-		for (size_type i = 0; i < tmp_rows; ++i)
-			tmp[i] = std::move(arr[i]);
-		delete[] arr; // deallocate arr
-		arr = tmp; // reassign arr to tmp
+	// elements of trivially copyable types are relocated and copied with memcpy, provided the allocator
+	// does not customise their construction
+	typedef std::integral_constant<bool, std::is_trivially_copyable<value_type>::value
+		&& std::is_same<allocator_type, std::allocator<value_type>>::value> is_bitwise_copyable;
+	value_type* allocate(size_type n) {	// obtain uninitialized storage for n elements
+		return n ? alloc_traits::allocate(alloc, n) : nullptr;
+	}
+	void deallocate(value_type* p, size_type n) noexcept {
+		if (p) alloc_traits::deallocate(alloc, p, n);
+	}
+	void destroy_range(value_type* p, size_type n) noexcept {
+		for (size_type i = 0; i < n; ++i)
+			alloc_traits::destroy(alloc, p + i);
+	}
+	// each construct_* constructs n elements at dst, destroying those already constructed if one throws
+	template<class... Args>
+	void construct_each(value_type* dst, size_type n, const Args&... args) {
+		size_type i = 0;
+		try {
+			for (; i < n; ++i)
+				alloc_traits::construct(alloc, dst + i, args...);
+		}
+		catch (...) {
+			destroy_range(dst, i);
+			throw;
+		}
+	}
+	void construct_default(value_type* dst, size_type n) { construct_each(dst, n); }
+	void construct_fill(value_type* dst, size_type n, const value_type& _val) { construct_each(dst, n, _val); }
+	template<class InputIt>
+	void construct_copy(InputIt src, size_type n, value_type* dst) {
+		construct_copy(src, n, dst, std::integral_constant<bool, is_bitwise_copyable::value
+			&& std::is_convertible<InputIt, const value_type*>::value>());
+	}
+	void construct_copy(const value_type* src, size_type n, value_type* dst, std::true_type) {
+		if (n) std::memcpy(dst, src, n * sizeof(value_type));
+	}
+	template<class InputIt>
+	void construct_copy(InputIt src, size_type n, value_type* dst, std::false_type) {
+		size_type i = 0;
+		try {
+			for (; i < n; ++i, ++src)
+				alloc_traits::construct(alloc, dst + i, *src);
+		}
+		catch (...) {
+			destroy_range(dst, i);
+			throw;
+		}
+	}
+	// moves the n elements at src into uninitialized dst - copies if the move constructor may throw, such that
+	// src is intact if an exception is thrown - then destroys those at src
+	void relocate(value_type* src, size_type n, value_type* dst, std::true_type) noexcept {
+		if (n) std::memcpy(dst, src, n * sizeof(value_type));
+	}
+	void relocate(value_type* src, size_type n, value_type* dst, std::false_type) {
+		size_type i = 0;
+		try {
+			for (; i < n; ++i)
+				alloc_traits::construct(alloc, dst + i, std::move_if_noexcept(src[i]));
+		}
+		catch (...) {
+			destroy_range(dst, i);
+			throw;
+		}
+		destroy_range(src, n);
+	}
+	void reallocate(size_type new_cap) {	// reallocate array memory to an uninitialized new_cap block
+		value_type* tmp = allocate(new_cap);
+		const size_type kept = (new_cap < arr_size) ? new_cap : arr_size;
+		try {
+			relocate(arr, kept, tmp, is_bitwise_copyable());
+		}
+		catch (...) {
+			deallocate(tmp, new_cap);
+			throw;
+		}
+		destroy_range(arr + kept, arr_size - kept);
+		deallocate(arr, arr_capacity);
+		arr = tmp;
 		arr_capacity = new_cap;
+		arr_size = kept;
+	}
+	// reallocates to new_cap, first constructing n elements at the back of the new storage by construct(dst)
+	// and then moving the existing elements before them - construct may therefore read from this container
+	template<class Construct>
+	void reallocate_with(size_type new_cap, size_type n, Construct construct) {
+		value_type* tmp = allocate(new_cap);
+		try {
+			construct(tmp + arr_size);
+		}
+		catch (...) {
+			deallocate(tmp, new_cap);
+			throw;
+		}
+		try {
+			relocate(arr, arr_size, tmp, is_bitwise_copyable());
+		}
+		catch (...) {
+			destroy_range(tmp + arr_size, n);
+			deallocate(tmp, new_cap);
+			throw;
+		}
+		deallocate(arr, arr_capacity);
+		arr = tmp;
+		arr_capacity = new_cap;
+		arr_size += n;
+	}
+	template<class InputIt>
+	void append_range(InputIt first, InputIt last, std::input_iterator_tag) {
+		for (; first != last; ++first) emplace_back(*first);
+	}
+	template<class FwdIt>
+	void append_range(FwdIt first, FwdIt last, std::forward_iterator_tag) {
+		const size_type n = std::distance(first, last);
+		if (arr_size + n > arr_capacity) {
+			reallocate_with(GrowthPolicy::next_capacity(arr_capacity, arr_size + n), n,
+				[this, first, n](value_type* dst) { construct_copy(first, n, dst); });
+		}
+		else {
+			construct_copy(first, n, arr + arr_size);
+			arr_size += n;
+		}
 	}
-	void destroy() {	// deallocate array memory
-		delete[] arr;
+	void destroy() noexcept {	// destruct elements and deallocate array memory
+		destroy_range(arr, arr_size);
+		deallocate(arr, arr_capacity);
 	}
-	void fill(const value_type& _val) {	// fill array with _val
-		for (size_type i = 0; i < arr_size; ++i)
-			arr[i] = _val;
+	void swap_storage(dynamic_array& _other) noexcept {
+		std::swap(arr, _other.arr);
+		std::swap(arr_capacity, _other.arr_capacity);
+		std::swap(arr_size, _other.arr_size);
+	}
+	void move_assign(dynamic_array& _other, std::true_type) noexcept {	// storage of _other taken with its allocator
+		destroy();
+		alloc = std::move(_other.alloc);
+		arr = nullptr;
+		arr_capacity = arr_size = 0;
+		swap_storage(_other);
+	}
+	void move_assign(dynamic_array& _other, std::false_type) {	// storage taken only if the allocators are equal
+		if (alloc == _other.alloc) {
+			clear();
+			swap_storage(_other);
+			return;
+		}
+		dynamic_array tmp(alloc);
+		tmp.arr = tmp.allocate(_other.arr_size);
+		tmp.arr_capacity = _other.arr_size;
+		tmp.construct_copy(std::make_move_iterator(_other.arr), _other.arr_size, tmp.arr, std::false_type());
+		tmp.arr_size = _other.arr_size;
+		swap_storage(tmp);
 	}
 };
 
@@ -1,6 +1,11 @@
 #ifndef DYNAMIC_MATRIX_H
 #define DYNAMIC_MATRIX_H
+#include "cow_vector.h"
+#include "matrix_kernels.h"
+#include "matrix_layout.h"
 #include "sfinae_operators.h"
+#include "small_vector.h"
+#include "threading_utilities.h"
 #include <algorithm>
 #include <iterator>
 #include <ostream>
@@ -8,12 +13,31 @@
 #include <vector>
 
 namespace crsc {
+	/**
+	 * \brief Detail namespace for implementation of `dynamic_matrix`.
+	 */
+	namespace dynamic_matrix_impl {
+		// storage of the elements of a dynamic_matrix, held inline for a small_buffer_allocator and shared
+		// until written for a cow_allocator
+		template<typename Ty, class Allocator>
+		struct storage {
+			typedef std::vector<Ty, Allocator> type;
+		};
+		template<typename Ty, std::size_t N, class Allocator>
+		struct storage<Ty, small_buffer_allocator<Ty, N, Allocator>> {
+			typedef small_vector<Ty, N, small_buffer_allocator<Ty, N, Allocator>> type;
+		};
+		template<typename Ty, class Allocator>
+		struct storage<Ty, cow_allocator<Ty, Allocator>> {
+			typedef cow_vector<Ty, cow_allocator<Ty, Allocator>> type;
+		};
+	}
 	/**
 	 * \class dynamic_matrix
 	 *
-	 * \brief A container encapsulating a `std::vector` using a row-major configuration to store a matrix-style object. The
-	 *        number of elements in every row are equal and the number of elements in every column are equal, such that no
-	 *        holes in the structure occur.
+	 * \brief A container encapsulating a `std::vector` using a configurable layout (row-major by default) to store a
+	 *        matrix-style object. The number of elements in every row are equal and the number of elements in every column
+	 *        are equal, such that no holes in the structure occur.
 	 *
 	 * The elements of the `dynamic_matrix` are stored contiguously such that they can be accessed through iterators as well
 	 * as offsets on regular pointers to elements. Storage of a `dynamic_matrix` is handled automatically allowing expansion
@@ -26,8 +50,9 @@ namespace crsc {
 	 * will be known beforehand (i.e. before using `push` or `insert` operations).
 	 *
 	 * Iteration support is via a `std::bidirectional_iterator` from the `std::vector` data structure, therefore both random
-	 * access iteration and forward iteration is supported. The order of iteration uses an "in-order traversal" such that elements
-	 * of the `dynamic_matrix` are iterated through by rows from left to right, top to bottom.
+	 * access iteration and forward iteration is supported. Iteration follows the storage order of the `Layout` - for the default
+	 * `crsc::row_major` layout elements are iterated through by rows from left to right, top to bottom, for `crsc::column_major`
+	 * by columns from top to bottom, left to right, and for `crsc::tiled` tile by tile.
 	 *
 	 * The complexity of common operations on `dynamic_matrix` objects are:
 	 *
@@ -37,7 +62,15 @@ namespace crsc {
 	 *
 	 * \tparam Ty The type of the elements.
 	 * \tparam Allocator An allocator that is used to acquire memory to store the elements. The type must meet the requirements
-	 *                of `Allocator` (see C++ Standard). Behaviour is undefined if `Allocator::value_type != Ty`.
+	 *                of `Allocator` (see C++ Standard). Behaviour is undefined if `Allocator::value_type != Ty`. For
+	 *                `crsc::small_buffer_allocator<Ty, N>` the elements are stored in a `crsc::small_vector`, such that
+	 *                matrices of up to `N` elements (e.g. `N = 16` for 4x4 matrices) are held inside the object and never
+	 *                allocate; `small_dynamic_matrix<Ty, N>` names such a matrix. For `crsc::cow_allocator<Ty>` the
+	 *                elements are stored in a `crsc::cow_vector`, such that copies share one buffer until either is
+	 *                accessed through a non-const member function; `cow_dynamic_matrix<Ty>` names such a matrix.
+	 * \tparam Layout Storage layout policy mapping row-column indices to storage offsets, one of `crsc::row_major`,
+	 *                `crsc::column_major` or `crsc::tiled` (see matrix_layout.h). Insertion and removal are cheapest along
+	 *                the contiguous dimension of the layout, i.e. rows for `row_major` and columns for `column_major`.
 	 * \remark As this is a dynamic data structure the dimensions of the `dynamic_matrix` do NOT need to be known at
 	 *         compile-time, these dimensions can be manipulated at run-time. This structure occupies slightly more
 	 *         memory than a fixed-size matrix for this reason - if memory is a concern and fixed dimensions are known
@@ -48,7 +81,8 @@ namespace crsc {
 	 * \date July, 2016
 	 */
 	template<typename Ty,
-		class Allocator = std::allocator<Ty>
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
 	> class dynamic_matrix {
 	public:
 		// PUBLIC API TYPE DEFINITIONS
@@ -60,10 +94,12 @@ namespace crsc {
 		typedef std::size_t size_type;
 		typedef std::ptrdiff_t difference_type;
 		typedef Allocator allocator_type;
-		typedef typename std::vector<Ty, Allocator>::const_iterator const_iterator;
-		typedef typename std::vector<Ty, Allocator>::iterator iterator;
-		typedef typename std::vector<Ty, Allocator>::const_reverse_iterator const_reverse_iterator;
-		typedef typename std::vector<Ty, Allocator>::reverse_iterator reverse_iterator;
+		typedef Layout layout_type;
+		typedef typename dynamic_matrix_impl::storage<Ty, Allocator>::type storage_type;
+		typedef typename storage_type::const_iterator const_iterator;
+		typedef typename storage_type::iterator iterator;
+		typedef typename storage_type::const_reverse_iterator const_reverse_iterator;
+		typedef typename storage_type::reverse_iterator reverse_iterator;
 	private:
 		/**
 		 * \class proxy_row_vector
@@ -72,17 +108,18 @@ namespace crsc {
 		 */
 		class proxy_row_vector {
 		public:
-			proxy_row_vector(std::vector<value_type, allocator_type>& _vec, size_type _row_index, size_type _cols)
-				: vec(_vec), row_index(_row_index), columns(_cols) {}
+			proxy_row_vector(storage_type& _vec, size_type _row_index, size_type _rows, size_type _cols)
+				: vec(_vec), row_index(_row_index), rows(_rows), columns(_cols) {}
 			const_reference operator[](size_type _col_index) const {
-				return vec[row_index*columns + _col_index];
+				return vec[Layout::offset(row_index, _col_index, rows, columns)];
 			}
 			reference operator[](size_type _col_index) {
-				return vec[row_index*columns + _col_index];
+				return vec[Layout::offset(row_index, _col_index, rows, columns)];
 			}
 		private:
-			std::vector<value_type, allocator_type>& vec;
+			storage_type& vec;
 			size_type row_index;
+			size_type rows;
 			size_type columns;
 		};
 	public:
@@ -145,7 +182,7 @@ namespace crsc {
 			: mtx(_rows*_cols, value_type(), alloc), rows_(_rows), cols_(_cols) {
 			for (size_type i = 0; i < _rows; ++i) {
 				for (size_type j = 0; j < _cols; ++j)
-					mtx[i*_cols + j] = _arr_2d[i][j];
+					mtx[Layout::offset(i, j, _rows, _cols)] = _arr_2d[i][j];
 			}
 		}
 		/**
@@ -155,7 +192,7 @@ namespace crsc {
 		 *
 		 * \param _other Another `dynamic_matrix` container to be used as source to
 		 *               initialise elements of the container with.
-		 * \complexity Linear in `_other.rows()*_other.columns()`.
+		 * \complexity Linear in `_other.rows()*_other.columns()`, or constant for a `cow_allocator`.
 		 */
 		dynamic_matrix(const dynamic_matrix& _other)
 			: mtx(_other.mtx), rows_(_other.rows_), cols_(_other.cols_) {}
@@ -202,7 +239,10 @@ namespace crsc {
 		 */
 		dynamic_matrix(std::initializer_list<std::initializer_list<value_type>> _init_list, const Allocator& alloc = Allocator())
 			: mtx(alloc), rows_(_init_list.size()), cols_(_init_list.begin()->size()) {
-			for (auto& el : _init_list) std::move(el.begin(), el.end(), std::back_inserter(mtx));
+			mtx.reserve(rows_*cols_);
+			Layout::for_each_index(rows_, cols_, [this, &_init_list](size_type i, size_type j) {
+				mtx.push_back((_init_list.begin() + i)->begin()[j]);
+			});
 		}
 		/**
 		 * \brief Destructs the container. The destructors of the elements are called and the used storage is deallocated.
@@ -249,10 +289,11 @@ namespace crsc {
 		 */
 		dynamic_matrix& operator=(std::initializer_list<std::initializer_list<value_type>> ilist) {
 			resize(ilist.size(), ilist.begin()->size());	// resize to ilist dimensions
-			auto it = mtx.begin();
-			for (auto& el : ilist) {	// move each inner list contents to rows of mtx
-				std::move(el.begin(), el.end(), it);
-				std::advance(it, cols_);
+			size_type i = 0U;
+			for (auto& el : ilist) {	// copy each inner list contents to rows of mtx
+				for (size_type j = 0; j < cols_; ++j)
+					mtx[Layout::offset(i, j, rows_, cols_)] = el.begin()[j];
+				++i;
 			}
 			return *this;
 		}
@@ -357,7 +398,7 @@ namespace crsc {
 		const_reference at(size_type _row_index, size_type _col_index) const {
 			if (_row_index >= rows_ || _col_index >= cols_)
 				throw std::out_of_range("dynamic_matrix indices out of bounds.");
-			return mtx[_row_index*cols_ + _col_index];
+			return mtx[Layout::offset(_row_index, _col_index, rows_, cols_)];
 		}
 		/**
 		 * \brief Gets reference to element at specified row-column indices.
@@ -374,7 +415,7 @@ namespace crsc {
 		reference at(size_type _row_index, size_type _col_index) {
 			if (_row_index >= rows_ || _col_index >= cols_)
 				throw std::out_of_range("dynamic_matrix indices out of bounds.");
-			return mtx[_row_index*cols_ + _col_index];
+			return mtx[Layout::offset(_row_index, _col_index, rows_, cols_)];
 		}
 		/**
 		 * \brief Gets a proxy object representing the row vector of the matrix at a given `_row_index`
@@ -387,7 +428,7 @@ namespace crsc {
 		 * \exceptionsafety No-throw guarantee if `_row_index < rows()`, otherwise undefined behaviour.
 		 */
 		proxy_row_vector operator[](size_type _row_index) const {
-			return proxy_row_vector(mtx, _row_index, cols_);
+			return proxy_row_vector(mtx, _row_index, rows_, cols_);
 		}
 		/**
 		 * \brief Gets a proxy object representing the row vector of the matrix at a given `_row_index`
@@ -400,7 +441,7 @@ namespace crsc {
 		 * \exceptionsafety No-throw guarantee if `_row_index < rows()`, otherwise undefined behaviour.
 		 */
 		proxy_row_vector operator[](size_type _row_index) {
-			return proxy_row_vector(mtx, _row_index, cols_);
+			return proxy_row_vector(mtx, _row_index, rows_, cols_);
 		}
 		/** 
 		 * \brief Gets `const_reference` to element at specified row-column indices.
@@ -413,7 +454,7 @@ namespace crsc {
 		 *                  otherwise undefined behaviour.
 		 */
 		const_reference operator()(size_type _row_index, size_type _col_index) const {
-			return mtx[_row_index*cols_ + _col_index];
+			return mtx[Layout::offset(_row_index, _col_index, rows_, cols_)];
 		}
 		/**
 		 * \brief Gets `reference` to element at specified row-column indices.
@@ -426,7 +467,7 @@ namespace crsc {
 		 *                  otherwise undefined behaviour.
 		 */
 		reference operator()(size_type _row_index, size_type _col_index) {
-			return mtx[_row_index*cols_ + _col_index];
+			return mtx[Layout::offset(_row_index, _col_index, rows_, cols_)];
 		}
 		/**
 		 * \brief Returns a const_reference to first element in the container.
@@ -608,14 +649,22 @@ namespace crsc {
 		 * \param _row_pos Position one slot after insertion point.
 	 	 * \param _val Value to initialise all elements of the newly inserted row with.
 		 * \return Iterator pointing to the first element inserted.
-		 * \throw Throws `std::invalid_argument` exception if `_row_pos > rows()`.
-		 * \complexity Linear in `columns()` plus linear in distance between `_row_pos` and `end` of the container.
+		 * \throw Throws `std::out_of_range` exception if `_row_pos > rows()`.
+		 * \complexity Linear in `columns()` plus linear in distance between `_row_pos` and `end` of the container
+		 *             for `row_major` layouts, otherwise linear in `rows()*columns()`.
 		 * \exceptionsafety Strong guarantee - if an exception is thrown there are no changes in the container.
 		 */
 		template<class Uty = Ty,
 			class = std::enable_if_t<std::is_copy_assignable<Uty>::value>
 		> iterator insert_row(size_type _row_pos, const value_type& _val) {
-			return insert_row(_row_pos, std::move(std::vector<value_type>(cols_, _val)));
+			if (_row_pos > rows_)
+				throw std::out_of_range("_row_pos must be <= current value of rows().");
+			// _val may be an element of this container, which is moved (or reallocated) before the new
+			// elements are constructed
+			const value_type val(_val);
+			return insert_rows_impl(_row_pos, 1U, [&val](size_type, size_type) -> const value_type& {
+				return val;
+			});
 		}
 		/**
 		 * \brief Inserts a row vector to the position one slot before `_row_pos`.
@@ -630,8 +679,8 @@ namespace crsc {
 		 * \return Iterator pointing to the first element inserted.
 		 * \throw Throws `std::out_of_range` exception, `std::invalid_argument` exception 
 		 *        if `_row_pos > rows() || _row_vec.size() != columns()`, respectively.
-		 * \complexity Linear in `columns()` plus linear in distance between
-		 *             `_row_pos` and `end` of the container.
+		 * \complexity Linear in `columns()` plus linear in distance between `_row_pos` and `end` of the
+		 *             container for `row_major` layouts, otherwise linear in `rows()*columns()`.
 		 * \exceptionsafety Strong guarantee - if an exception is thrown there are no changes in the container.
 	 	 */
 		template<class Uty = Ty,
@@ -641,8 +690,9 @@ namespace crsc {
 				throw std::out_of_range("_row_pos must be <= current value of rows().");
 			if (_row_vec.size() != cols_)
 				throw std::invalid_argument("_row_vec.size() must = current value of columns().");
-			++rows_;
-			return mtx.insert(mtx.cbegin() + _row_pos*cols_, _row_vec.cbegin(), _row_vec.cend());
+			return insert_rows_impl(_row_pos, 1U, [&_row_vec](size_type, size_type j) -> const value_type& {
+				return _row_vec[j];
+			});
 		}
 		/**
 		 * \brief Inserts a row vector to the position one slot before `_row_pos` using move-semantics.
@@ -660,10 +710,8 @@ namespace crsc {
 		 * \return Iterator pointing to the first element inserted.
 		 * \throw Throws `std::out_of_range` exception, `std::invalid_argument` exception 
 		 *        if `_row_pos > rows() || _row_vec.size() > columns()`, respectively.
-		 * \complexity If `_row_vec.size() == columns()` then linear in `columns` plus linear in distance between
-		 *             `_row_pos` and `end` of the container, else if `_row_vec.size() < columns()` then linear in
-		 *             `columns()` plus linear in distance between `_row_pos` and `end` of the container plus linear
-		 *             in `columns() - _row_vec.size()`.
+		 * \complexity Linear in `columns()` plus linear in distance between `_row_pos` and `end` of the
+		 *             container for `row_major` layouts, otherwise linear in `rows()*columns()`.
 		 * \exceptionsafety Strong guarantee - if an exception is thrown there are no changes in the container.
 		 */
 		template<class Uty = Ty,
@@ -673,12 +721,11 @@ namespace crsc {
 				throw std::out_of_range("_row_pos must be <= current value of rows().");
 			if (_row_vec.size() > cols_)
 				throw std::invalid_argument("_row_vec.size() must be <= current value of columns().");
-			++rows_;
-			// move-insert _row_vec contents to specified row position
 			if (_row_vec.size() < cols_)
 				_row_vec.resize(cols_);
-			return mtx.insert(mtx.cbegin() + _row_pos*cols_, 
-				std::make_move_iterator(_row_vec.begin()), std::make_move_iterator(_row_vec.end()));
+			return insert_rows_impl(_row_pos, 1U, [&_row_vec](size_type, size_type j) -> value_type&& {
+				return std::move(_row_vec[j]);
+			});
 		}
 		/**
 		 * \brief Inserts a column vector to the position one slot before `_col_pos` where each
@@ -687,16 +734,15 @@ namespace crsc {
 		 * \param _col_pos Position one slot after insertion point.
 		 * \param _val Value to initialise all elements of the newly inserted column with.
 		 * \return Iterator pointing to the first element inserted.
-		 * \throw Throws `std::invalid_argument` exception if `_col_pos > columns()`.
-		 * \complexity Linear in `rows()` multiplied by linear in distance between `_col_pos` and 
-		 *             `end` of the container.
+		 * \throw Throws `std::out_of_range` exception if `_col_pos > columns()`.
+		 * \complexity Linear in `rows()*columns()`.
 		 * \exceptionsafety Strong guarantee - if an exception is thrown there are no changes
 		 *                  in the container.
 		 */
 		template<class Uty = Ty,
 			class = std::enable_if_t<std::is_copy_assignable<Uty>::value>
 		> iterator insert_column(size_type _col_pos, const value_type& _val) {
-			return insert_column(_col_pos, std::move(std::vector<value_type>(rows_, _val)));
+			return insert_columns(_col_pos, 1U, _val);
 		}
 		/**
 		 * \brief Inserts a column vector to the position one slot before `_col_pos`.
@@ -715,8 +761,7 @@ namespace crsc {
 		 * \return Iterator pointing to the first element inserted.
 		 * \throw Throws `std::out_of_range` exception, `std::invalid_argument` exception 
 		 *        if `_col_pos > columns() || _col_vec.size() != rows()`, respectively.
-		 * \complexity Linear in `rows()` multiplied by linear in distance
-		 *             between `_cols_pos` and `end` of the container.
+		 * \complexity Linear in `rows()*columns()`.
 		 * \exceptionsafety Strong guarantee - if an exception is thrown there are no changes
 		 *                  in the container.
 		 */
@@ -727,18 +772,9 @@ namespace crsc {
 				throw std::out_of_range("_col_pos must be <= current value of columns().");
 			if (_col_vec.size() != rows_)
 				throw std::invalid_argument("_col_vec.size() must = current value of rows().");
-			iterator rtn; // val to return
-			// no. of elements in _col_vec matches row size, insert each value of
-			// _col_vec sequentially into new column of matrix
-			for (size_type i = 0; i < _col_vec.size(); ++i) {
-				// insert i'th el. of _col_vec at position offset from
-				// beginning by row, col position plus loop index to take
-				// account for extra values inserted on previous iteration
-				if (!i) rtn = mtx.insert(mtx.cbegin() + i*(cols_ + 1) + _col_pos, _col_vec[i]);
-				else mtx.insert(mtx.cbegin() + i*(cols_ + 1) + _col_pos, _col_vec[i]);
-			}
-			++cols_;
-			return rtn;
+			return insert_columns_impl(_col_pos, 1U, [&_col_vec](size_type i, size_type) -> const value_type& {
+				return _col_vec[i];
+			});
 		}
 		/**
 		 * \brief Inserts a column vector to the position one slot before `_col_pos` using move-semantics.
@@ -756,10 +792,7 @@ namespace crsc {
 		 * \return Iterator pointing the the first element inserted.
 		 * \throw Throws `std::out_of_range` exception, `std::invalid_argument` exception
 		 *        if `_col_pos > columns() || _col_vec.size() > rows()`, respectively.
-		 * \complexity If `_col_vec.size() == rows()` then linear in `rows()` multiplied by linear in distance
-		 *             between `_cols_pos` and `end` of the container, else if `_col_vec.size() < rows()` then
-		 *             linear in `rows()` multiplied by linear in distance between `_col_pos` and `end` of the 
-		 *             container plus linear in `rows() - _col_vec.size()`.
+		 * \complexity Linear in `rows()*columns()`.
 		 * \exceptionsafety Strong guarantee - if an exception is thrown there are no changes
 		 *                  in the container.
 		 */
@@ -770,16 +803,95 @@ namespace crsc {
 				throw std::out_of_range("_col_pos must be <= current value of columns().");
 			if (_col_vec.size() > rows_)
 				throw std::invalid_argument("_col_vec.size() must be <= current value of rows().");
-			iterator rtn; // val to return
 			if (_col_vec.size() < rows_)
 				_col_vec.resize(rows_);
-			// move-insert _col_vec contents to specified column position
-			for (size_type i = 0; i < _col_vec.size(); ++i) {
-				if (!i) rtn = mtx.insert(mtx.cbegin() + i*(cols_ + 1) + _col_pos, std::move(_col_vec[i]));
-				else mtx.insert(mtx.cbegin() + i*(cols_ + 1) + _col_pos, std::move(_col_vec[i]));
-			}
-			++cols_;
-			return rtn;
+			return insert_columns_impl(_col_pos, 1U, [&_col_vec](size_type i, size_type) -> value_type&& {
+				return std::move(_col_vec[i]);
+			});
+		}
+		/**
+		 * \brief Inserts `_count` column vectors to the position one slot before `_col_pos` where each
+		 *        element in the inserted columns will have the specified value `_val`.
+		 *
+		 * All columns are inserted in a single pass over the container, such that inserting many columns
+		 * at once is significantly cheaper than repeated calls to `insert_column`.
+		 *
+		 * \param _col_pos Position one slot after insertion point.
+		 * \param _count Number of columns to insert.
+		 * \param _val Value to initialise all elements of the newly inserted columns with.
+		 * \return Iterator pointing to the first element inserted, or `end()` if `rows() == 0`.
+		 * \throw Throws `std::out_of_range` exception if `_col_pos > columns()`.
+		 * \complexity Linear in `rows()*(columns() + _count)`.
+		 * \exceptionsafety Strong guarantee - if an exception is thrown there are no changes
+		 *                  in the container.
+		 */
+		template<class Uty = Ty,
+			class = std::enable_if_t<std::is_copy_assignable<Uty>::value>
+		> iterator insert_columns(size_type _col_pos, size_type _count, const value_type& _val) {
+			if (_col_pos > cols_)
+				throw std::out_of_range("_col_pos must be <= current value of columns().");
+			// _val may be an element of this container, which is moved before the new elements are constructed
+			const value_type val(_val);
+			return insert_columns_impl(_col_pos, _count, [&val](size_type, size_type) -> const value_type& {
+				return val;
+			});
+		}
+		/**
+		 * \brief Inserts the columns of `_block` to the position one slot before `_col_pos`, such
+		 *        that column `j` of `_block` becomes column `_col_pos + j` of this container.
+		 *
+		 * All columns are inserted in a single pass over the container, such that inserting many columns
+		 * at once is significantly cheaper than repeated calls to `insert_column`.
+		 *
+		 * \param _col_pos Position one slot after insertion point.
+		 * \param _block Instance of `dynamic_matrix` whose columns are to be inserted.
+		 * \return Iterator pointing to the first element inserted, or `end()` if `rows() == 0`.
+		 * \throw Throws `std::out_of_range` exception, `std::invalid_argument` exception
+		 *        if `_col_pos > columns() || _block.rows() != rows()`, respectively.
+		 * \complexity Linear in `rows()*(columns() + _block.columns())`.
+		 * \exceptionsafety Strong guarantee - if an exception is thrown there are no changes
+		 *                  in the container.
+		 */
+		template<class Uty = Ty,
+			class = std::enable_if_t<std::is_copy_assignable<Uty>::value>
+		> iterator insert_columns(size_type _col_pos, const dynamic_matrix& _block) {
+			if (_col_pos > cols_)
+				throw std::out_of_range("_col_pos must be <= current value of columns().");
+			if (_block.rows_ != rows_)
+				throw std::invalid_argument("_block.rows() must = current value of rows().");
+			// elements of *this are moved during the scatter, so self-insertion must work from a copy
+			if (&_block == this) return insert_columns(_col_pos, dynamic_matrix(_block));
+			return insert_columns_impl(_col_pos, _block.cols_, [&_block](size_type i, size_type j) -> const value_type& {
+				return _block(i, j);
+			});
+		}
+		/**
+		 * \brief Inserts the columns of `_block` to the position one slot before `_col_pos` using
+		 *        move-semantics, such that column `j` of `_block` becomes column `_col_pos + j` of this
+		 *        container.
+		 *
+		 * All columns are inserted in a single pass over the container, such that inserting many columns
+		 * at once is significantly cheaper than repeated calls to `insert_column`.
+		 *
+		 * \param _col_pos Position one slot after insertion point.
+		 * \param _block rvalue reference to instance of `dynamic_matrix` whose columns are to be move-inserted.
+		 * \return Iterator pointing to the first element inserted, or `end()` if `rows() == 0`.
+		 * \throw Throws `std::out_of_range` exception, `std::invalid_argument` exception
+		 *        if `_col_pos > columns() || _block.rows() != rows()`, respectively.
+		 * \complexity Linear in `rows()*(columns() + _block.columns())`.
+		 * \exceptionsafety Strong guarantee - if an exception is thrown there are no changes
+		 *                  in the container.
+		 */
+		template<class Uty = Ty,
+			class = std::enable_if_t<std::is_move_assignable<Uty>::value>
+		> iterator insert_columns(size_type _col_pos, dynamic_matrix&& _block) {
+			if (_col_pos > cols_)
+				throw std::out_of_range("_col_pos must be <= current value of columns().");
+			if (_block.rows_ != rows_)
+				throw std::invalid_argument("_block.rows() must = current value of rows().");
+			return insert_columns_impl(_col_pos, _block.cols_, [&_block](size_type i, size_type j) -> value_type&& {
+				return std::move(_block(i, j));
+			});
 		}
 		/**
 		 * \brief Erases a row vector at `_row_pos`.
@@ -789,7 +901,8 @@ namespace crsc {
 		 *         to the first element of the next row or `end()` if last row was erased.
 		 * \throw Throws `std::out_of_range` exception if `!(_row_pos < rows())`.
 		 * \complexity Linear in `columns()` plus linear in distance between last element of
-		 *             the row and `end` of the container.
+		 *             the row and `end` of the container for `row_major` layouts, otherwise linear
+		 *             in `rows()*columns()`.
 		 * \exceptionsafety Strong guarantee - if an exception is thrown there are no changes
 		 *                  in the container.
 		 */
@@ -798,8 +911,7 @@ namespace crsc {
 		> iterator erase_row(size_type _row_pos) {
 			if (!(_row_pos < rows_))
 				throw std::out_of_range("_row_pos must be < current value of rows().");
-			--rows_;
-			return mtx.erase(mtx.cbegin() + _row_pos*cols_, mtx.cbegin() + cols_*(_row_pos + 1));
+			return erase_rows_impl(_row_pos, 1U);
 		}
 		/**
 		 * \brief Erases a column vector at `_col_pos`.
@@ -808,24 +920,39 @@ namespace crsc {
 		 * \return Iterator following the last removed element, i.e. the iterator pointing
 		 *         to the next element along from the last row of the erased column.
 		 * \throw Throws `std::out_of_range` exception if `!(_col_pos < columns())`.
-		 * \complexity Linear in `rows()` multiplied by linearly decreasing factor given
-		 *             by distance between each element in column and `end` of container.
-		 * \exceptionsafety Strong guarantee - if an exception is thrown there are no changes
-		 *                  in the container.
+		 * \complexity Linear in `rows()*columns()`.
+		 * \exceptionsafety If the move-assignment operator of `value_type` does not throw then
+		 *                  no-throw guarantee, otherwise basic guarantee.
 		 */
 		template<class Uty = Ty,
 			class = std::enable_if_t<std::is_move_assignable<Uty>::value>
 		> iterator erase_column(size_type _col_pos) {
 			if (!(_col_pos < cols_))
 				throw std::out_of_range("_col_pos must be < current value of columns().");
-			iterator rtn;
-			// erase el. of mtx at position offset from beginning by
-			// row, col position minus loop index to take account for
-			// values erased on previous iteration
-			for (size_type i = 0; i < rows_; ++i)
-				rtn = mtx.erase(mtx.cbegin() + i*(cols_ - 1) + _col_pos);
-			--cols_;
-			return rtn;
+			return erase_columns(_col_pos, 1U);
+		}
+		/**
+		 * \brief Erases the `_count` column vectors starting at `_col_pos`.
+		 *
+		 * The remaining elements are compacted in a single forward pass over the container without
+		 * reallocation, such that erasing many columns at once is significantly cheaper than repeated
+		 * calls to `erase_column`.
+		 *
+		 * \param _col_pos Position of first column to remove.
+		 * \param _count Number of columns to remove.
+		 * \return Iterator following the last removed element, i.e. the iterator pointing to the next
+		 *         element along from the last row of the erased columns.
+		 * \throw Throws `std::out_of_range` exception if `_col_pos + _count > columns()`.
+		 * \complexity Linear in `rows()*columns()`.
+		 * \exceptionsafety If the move-assignment operator of `value_type` does not throw then
+		 *                  no-throw guarantee, otherwise basic guarantee.
+		 */
+		template<class Uty = Ty,
+			class = std::enable_if_t<std::is_move_assignable<Uty>::value>
+		> iterator erase_columns(size_type _col_pos, size_type _count) {
+			if (_col_pos > cols_ || _count > cols_ - _col_pos)
+				throw std::out_of_range("_col_pos + _count must be <= current value of columns().");
+			return erase_columns_impl(_col_pos, _count);
 		}
 		/**
 		 * \brief Assigns the given value `_val` to all elements in the container.
@@ -854,11 +981,7 @@ namespace crsc {
 		 */
 		template<class Uty = Ty,
 			class = std::enable_if_t<std::is_copy_assignable<Uty>::value>
-		> void push_row(const value_type& _val) {
-			for (size_type i = 0; i < cols_; ++i)
-				mtx.push_back(_val);
-			++rows_;
-		}
+		> void push_row(const value_type& _val) { insert_row(rows_, _val); }
 		/**
 		 * \brief Pushes an extra row-vector to the back of the container.
 		 *
@@ -879,15 +1002,7 @@ namespace crsc {
 		 */
 		template<class Uty = Ty,
 			class = std::enable_if_t<std::is_copy_assignable<Uty>::value>
-		> void push_row(const std::vector<value_type>& _row_vec) {
-			if (_row_vec.size() != cols_)
-				throw std::invalid_argument("_row_vec.size() must = current value of columns().");
-			// push_back each element of _row_vec to form new row
-			for (const auto& el : _row_vec) {
-				mtx.push_back(el);
-			}
-			++rows_;
-		}
+		> void push_row(const std::vector<value_type>& _row_vec) { insert_row(rows_, _row_vec); }
 		/**
 		 * \brief Pushes an extra row-vector to the back of the container using move-semantics.
 		 *
@@ -910,14 +1025,61 @@ namespace crsc {
 		template<class Uty = Ty,
 			class = std::enable_if_t<std::is_move_assignable<Uty>::value>
 		> void push_row(std::vector<value_type>&& _row_vec = std::vector<value_type>()) {
-			if (_row_vec.size() > cols_)
-				throw std::invalid_argument("_row_vec.size() must be <= current value of columns().");
-			if (_row_vec.size() < cols_)
-				_row_vec.resize(cols_);
-			// push_back each element of _row_vec to form new row
-			for (auto& el : _row_vec)
-				mtx.push_back(std::move(el));
-			++rows_;
+			insert_row(rows_, std::move(_row_vec));
+		}
+		/**
+		 * \brief Appends `_count` rows to the back of the container, read from the contiguous array `_data` of
+		 *        `_count*columns()` elements in row-major order.
+		 *
+		 * No intermediate row-vectors are created. For `row_major` layouts the elements are copied straight into
+		 * the storage, which grows geometrically such that appending in many small batches is amortized linear
+		 * overall. For other layouts the storage is rebuilt once per call, so prefer few large batches.
+		 *
+		 * \param _data Pointer to the first element of the rows to append.
+		 * \param _count Number of rows to append.
+		 * \complexity Amortized linear in `_count*columns()` for `row_major` layouts, otherwise linear in
+		 *             `(rows() + _count)*columns()`.
+		 * \exceptionsafety Strong guarantee - if an exception is thrown there are no changes in the container.
+		 */
+		void append_rows(const value_type* _data, size_type _count) {
+			append_rows_impl(_data, _count, Layout());
+		}
+		/**
+		 * \brief Appends the rows in the range `[_first, _last)` to the back of the container, where each row is
+		 *        any range supporting `std::begin` and `std::end` (e.g. `std::vector`, `std::array` or a C-style
+		 *        array) of `columns()` elements.
+		 *
+		 * For `row_major` layouts the elements of each row are copied straight into the storage, which grows
+		 * geometrically - when `RowIt` is a forward iterator capacity for all of the rows is reserved up front.
+		 * For other layouts the rows are gathered then the storage is rebuilt once per call.
+		 *
+		 * \param _first Iterator to the first row to append.
+		 * \param _last Iterator one past the last row to append.
+		 * \throw Throws `std::invalid_argument` exception if any row does not have `columns()` elements.
+		 * \complexity Amortized linear in the number of elements appended for `row_major` layouts, otherwise
+		 *             linear in `rows()*columns()` plus the number of elements appended.
+		 * \exceptionsafety Strong guarantee - if an exception is thrown there are no changes in the container.
+		 */
+		template<class RowIt>
+		void append_rows(RowIt _first, RowIt _last) {
+			append_rows_impl(_first, _last, Layout());
+		}
+		/**
+		 * \brief Pushes an extra row-vector to the back of the container where each element of the row is
+		 *        constructed in-place from `_args...`.
+		 *
+		 * \remark Unlike `push_row` no temporary row-vector is created, and for `row_major` layouts with
+		 *         sufficient capacity no temporary element either - otherwise one element is constructed from
+		 *         `_args...` before the storage is reallocated and copied into the new row, as `_args...` may
+		 *         refer to elements of the container. `emplace_row()` appends a row of value-initialised elements.
+		 * \param _args Arguments to construct each element of the new row from.
+		 * \complexity Amortized linear in `columns()` for `row_major` layouts, otherwise linear in
+		 *             `rows()*columns()`.
+		 * \exceptionsafety Strong guarantee - if an exception is thrown there are no changes in the container.
+		 */
+		template<class... Args>
+		void emplace_row(Args&&... _args) {
+			emplace_row_impl(Layout(), _args...);
 		}
 		/**
 		 * \brief Pushes an extra column-vector to the back of the container where each element
@@ -984,11 +1146,7 @@ namespace crsc {
 		 * \exceptionsafety If container is `empty()` then no-throw guarantee, otherwise
 		 *                  undefined behaviour.
 		 */
-		void pop_row() {
-			for (size_type i = 0; i < cols_; ++i)
-				mtx.pop_back();
-			--rows_;
-		}
+		void pop_row() { erase_rows_impl(rows_ - 1, 1U); }
 		/**
 		 * \brief Pops the last column from the back of the container.
 		 *
@@ -1010,7 +1168,8 @@ namespace crsc {
 		 * first `_rows` rows of the container remain. If `_rows == rows()` this method does nothing.
 		 *
 		 * \param _rows New number of rows in the container.
-		 * \complexity Linear in `|_rows - rows()|` multiplied by linear in `columns()`.
+		 * \complexity Linear in `|_rows - rows()|` multiplied by linear in `columns()` for `row_major` layouts,
+		 *             otherwise linear in `max(_rows, rows())*columns()`.
 		 * \exceptionsafety If `_rows > rows()` then no-throw guarantee, else if `_rows < rows()` and
 		 *                  the container is `empty()` then undefined behaviour otherwise no-throw
 		 *                  guarantee.
@@ -1021,14 +1180,10 @@ namespace crsc {
 		> void rows_resize(size_type _rows) {
 			size_type tmp_rows = rows_;
 			if (_rows == rows_) return;
-			if (_rows > rows_) {	// expand number of rows in matrix
-				for (size_type i = 0; i < (_rows - tmp_rows); ++i)
-					insert_row(rows_, std::move(std::vector<value_type>(cols_)));
-			}
-			else {	// contract number of rows in matrix
-				for (size_type i = 0; i < (tmp_rows - _rows); ++i)
-					pop_row();
-			}
+			if (_rows > rows_)	// expand number of rows in matrix
+				insert_rows_impl(rows_, _rows - tmp_rows, [](size_type, size_type) { return value_type(); });
+			else	// contract number of rows in matrix
+				erase_rows_impl(_rows, tmp_rows - _rows);
 		}
 		/**
 		 * \brief Resizes the container to contain `_rows` row vectors, where any extra values
@@ -1041,7 +1196,8 @@ namespace crsc {
 		 *
 		 * \param _rows New number of rows in the container.
 		 * \param _val Value to initialise all elements of new row vectors with (if any).
-		 * \complexity Linear in `|_rows - rows()|` multiplied by linear in `columns()`.
+		 * \complexity Linear in `|_rows - rows()|` multiplied by linear in `columns()` for `row_major` layouts,
+		 *             otherwise linear in `max(_rows, rows())*columns()`.
 		 * \exceptionsafety If `_rows > rows()` then no-throw guarantee, else if `_rows < rows()` and
 		 *                  the container is `empty()` then undefined behaviour otherwise no-throw
 		 *                  guarantee.
@@ -1051,14 +1207,12 @@ namespace crsc {
 		> void rows_resize(size_type _rows, const value_type& _val) {
 			size_type tmp_rows = rows_;
 			if (_rows == rows_) return;
-			if (_rows > rows_) {	// expand number of rows in matrix
-				for (size_type i = 0; i < (_rows - tmp_rows); ++i) 
-					insert_row(rows_, _val);
-			}
-			else {	// contract number of rows in matrix
-				for (size_type i = 0; i < (tmp_rows - _rows); ++i)
-					pop_row();
+			if (_rows > rows_) {	// expand number of rows in matrix, copying _val as for insert_row
+				const value_type val(_val);
+				insert_rows_impl(rows_, _rows - tmp_rows, [&val](size_type, size_type) -> const value_type& { return val; });
 			}
+			else	// contract number of rows in matrix
+				erase_rows_impl(_rows, tmp_rows - _rows);
 		}
 		/**
 		 * \brief Resizes the container to contain `_cols` column vectors, where any extra values added
@@ -1071,9 +1225,7 @@ namespace crsc {
 		 * does nothing.
 		 *
 		 * \param _cols New number of columns in the container.
-		 * \complexity If `_cols > columns()` then linear in `|_cols - columns()|` multiplied by amortized
-		 *             linear in `rows()`, else if `_cols < columns()` then linear in `|columns() - _cols|`
-		 *             multiplied by complexity of `pop_column()`.
+		 * \complexity Linear in `rows()*max(_cols, columns())`.
 		 * \exceptionsafety If `_cols > columns()` then no-throw guarantee, else if `_cols < columns()`
 		 *                  and the container is `empty()` then undefined behaviour otherwise no-throw
 		 *                  guarantee.
@@ -1084,14 +1236,10 @@ namespace crsc {
 		> void columns_resize(size_type _cols) {
 			size_type tmp_cols = cols_;
 			if (_cols == cols_) return;
-			if (_cols > cols_) {	// expand number of columns in matrix
-				for (size_type i = 0; i < (_cols - tmp_cols); ++i)
-					insert_column(cols_, std::move(std::vector<value_type>(rows_)));
-			}
-			else {	// contract number of columns in matrix
-				for (size_type i = 0; i < (tmp_cols - _cols); ++i)
-					pop_column();
-			}
+			if (_cols > cols_)	// expand number of columns in matrix
+				insert_columns_impl(cols_, _cols - tmp_cols, [](size_type, size_type) { return value_type(); });
+			else	// contract number of columns in matrix
+				erase_columns(_cols, tmp_cols - _cols);
 		}
 		/**
 		 * \brief Resizes the container to contain `_cols` column vectors, with any extra values
@@ -1104,9 +1252,7 @@ namespace crsc {
 		 *
 		 * \param _cols New number of columns in the container.
 		 * \param _val Value to initialise all elements of new column vectors with (if any).
-		 * \complexity If `_cols > columns()` then linear in `|_cols - columns()|` multiplied by amortized
-		 *             linear in `rows()`, else if `_cols < columns()` then linear in `|columns() - _cols|` 
-		 *             multiplied by complexity of `pop_column()`.
+		 * \complexity Linear in `rows()*max(_cols, columns())`.
 		 * \exceptionsafety If `_cols > columns()` then no-throw guarantee, else if `_cols < columns()`
 		 *                  and the container is `empty()` then undefined behaviour otherwise no-throw
 		 *                  guarantee.
@@ -1116,14 +1262,10 @@ namespace crsc {
 		> void columns_resize(size_type _cols, const value_type& _val) {
 			size_type tmp_cols = cols_;
 			if (_cols == cols_) return;
-			if (_cols > cols_) {	// expand number of columns in matrix
-				for (size_type i = 0; i < (_cols - tmp_cols); ++i)
-					insert_column(cols_, _val);
-			}
-			else {	// contract number of columns in matrix
-				for (size_type i = 0; i < (tmp_cols - _cols); ++i)
-					pop_column();
-			}
+			if (_cols > cols_)	// expand number of columns in matrix
+				insert_columns(cols_, _cols - tmp_cols, _val);
+			else	// contract number of columns in matrix
+				erase_columns(_cols, tmp_cols - _cols);
 		}
 		/**
 		 * \brief Resizes the container to contain `_rows` row vectors and `_cols` column vectors where
@@ -1188,6 +1330,25 @@ namespace crsc {
 			erase_column(_col_index);
 			return *this;
 		}
+		/**
+		 * \brief Transposes the container in place, such that element `(i,j)` becomes element `(j,i)` and the
+		 *        numbers of rows and columns are exchanged.
+		 *
+		 * For `row_major` and `column_major` layouts no storage is allocated for the elements: square matrices
+		 * exchange blocks recursively via `crsc::kernels::transpose_square` and rectangular matrices permute
+		 * storage by cycle-following via `crsc::kernels::transpose_inplace`, the latter using one bit of
+		 * working storage per element. `tiled` layouts rebuild the storage tile by tile.
+		 *
+		 * \return `*this`.
+		 * \complexity Linear in `rows()*columns()`.
+		 * \exceptionsafety Strong guarantee if swapping `value_type` objects does not throw, as the only possible
+		 *                  failure is then allocation before any element is modified, and for `tiled` layouts,
+		 *                  otherwise basic guarantee.
+		 */
+		dynamic_matrix& transpose() {
+			transpose_impl(Layout());
+			return *this;
+		}
 		// OVERLOADED OPERATORS
 		/**
 		 * \brief Checks for equality of this container and `_other`.
@@ -1219,10 +1380,364 @@ namespace crsc {
 			return !(*this == _other);
 		}
 	private:
-		std::vector<value_type, allocator_type> mtx;
+		storage_type mtx;
 		size_type rows_;
 		size_type cols_;
 		void swap(dynamic_matrix& lhs, dynamic_matrix& rhs) { lhs.swap(rhs); }
+		// STRUCTURAL MODIFICATION HELPERS
+		//
+		// Storage consists of "lines" of `_minor` contiguous elements - the rows of a `row_major` matrix or
+		// the columns of a `column_major` matrix. Inserting or erasing whole lines ("major" operations) only
+		// shifts the tail of the storage, whereas inserting or erasing a range at the same position of every
+		// line ("minor" operations) requires a pass over all of the storage. Layouts which are not strided
+		// are rebuilt element by element via `relayout`.
+		static constexpr size_type no_index = static_cast<size_type>(-1);
+		template<class It>
+		static void scatter_segment(storage_type& _dest, It _first, It _last, std::true_type) {
+			_dest.insert(_dest.end(), std::make_move_iterator(_first), std::make_move_iterator(_last));
+		}
+		template<class It>
+		static void scatter_segment(storage_type& _dest, It _first, It _last, std::false_type) {
+			_dest.insert(_dest.end(), _first, _last);
+		}
+		/**
+		 * \brief Inserts `_count` lines before line `_pos`, where `_gen(l, m)` gives element `m` of the
+		 *        `l`-th new line. Appending grows the storage in-place and geometrically, otherwise the new
+		 *        lines are built before being moved into position, such that the strong guarantee holds.
+		 */
+		template<class Generator>
+		iterator insert_major(size_type _pos, size_type _count, size_type _minor, Generator&& _gen) {
+			const size_type old_size = mtx.size();
+			if (_pos*_minor == old_size) {
+				grow(old_size + _count*_minor);
+				try {
+					for (size_type l = 0; l < _count; ++l) {
+						for (size_type m = 0; m < _minor; ++m) mtx.push_back(_gen(l, m));
+					}
+				}
+				catch (...) {
+					mtx.erase(mtx.begin() + old_size, mtx.end());
+					throw;
+				}
+				return mtx.begin() + old_size;
+			}
+			storage_type block(mtx.get_allocator());
+			block.reserve(_count*_minor);
+			for (size_type l = 0; l < _count; ++l) {
+				for (size_type m = 0; m < _minor; ++m) block.push_back(_gen(l, m));
+			}
+			return mtx.insert(mtx.begin() + _pos*_minor, std::make_move_iterator(block.begin()), std::make_move_iterator(block.end()));
+		}
+		/**
+		 * \brief Inserts `_count` elements before position `_pos` of each of the `_major` lines in a single
+		 *        pass, building the new storage line by line from the existing elements and the values
+		 *        `_gen(l, k)` giving the `k`-th new element of line `l`.
+		 *
+		 * Existing elements are moved if their move-constructor cannot throw, otherwise copied. Should
+		 * `_gen` throw after elements have been moved, they are moved back before rethrowing such that
+		 * the strong guarantee holds.
+		 */
+		template<class Generator>
+		iterator insert_minor(size_type _pos, size_type _count, size_type _major, size_type _minor, Generator&& _gen) {
+			const size_type new_minor = _minor + _count;
+			if (!_major) return mtx.end();
+			storage_type tmp(mtx.get_allocator());
+			tmp.reserve(_major*new_minor);
+			try {
+				for (size_type l = 0; l < _major; ++l) {
+					const auto line = mtx.begin() + l*_minor;
+					scatter_segment(tmp, line, line + _pos, std::is_nothrow_move_constructible<value_type>());
+					for (size_type k = 0; k < _count; ++k) tmp.push_back(_gen(l, k));
+					scatter_segment(tmp, line + _pos, line + _minor, std::is_nothrow_move_constructible<value_type>());
+				}
+			}
+			catch (...) {
+				if (std::is_nothrow_move_constructible<value_type>::value) {
+					for (size_type k = 0; k < tmp.size(); ++k) {
+						const size_type l = k / new_minor, m = k % new_minor;
+						if (m < _pos) mtx[l*_minor + m] = std::move(tmp[k]);
+						else if (m >= _pos + _count) mtx[l*_minor + m - _count] = std::move(tmp[k]);
+					}
+				}
+				throw;
+			}
+			mtx.swap(tmp);
+			return mtx.begin() + _pos;
+		}
+		/**
+		 * \brief Ensures capacity for at least `_size` elements, at least doubling the current capacity when
+		 *        growing such that a sequence of appends reallocates only a logarithmic number of times.
+		 */
+		void grow(size_type _size) {
+			const size_type cap = mtx.capacity();
+			if (_size > cap) mtx.reserve(std::max(_size, cap < mtx.max_size() / 2U ? 2U*cap : mtx.max_size()));
+		}
+		/**
+		 * \brief Appends the row at `_row` to `_dest`, throwing if it does not have `cols_` elements.
+		 */
+		template<class Row>
+		void append_row_to(storage_type& _dest, const Row& _row) const {
+			using std::begin;
+			using std::end;
+			if (static_cast<size_type>(std::distance(begin(_row), end(_row))) != cols_)
+				throw std::invalid_argument("each row appended must have size = current value of columns().");
+			_dest.insert(_dest.end(), begin(_row), end(_row));
+		}
+		template<class RowIt>
+		void reserve_rows(RowIt, RowIt, std::input_iterator_tag) {}
+		template<class RowIt>
+		void reserve_rows(RowIt _first, RowIt _last, std::forward_iterator_tag) {
+			grow(mtx.size() + static_cast<size_type>(std::distance(_first, _last))*cols_);
+		}
+		void append_rows_impl(const value_type* _data, size_type _count, row_major) {
+			const size_type old_size = mtx.size();
+			grow(old_size + _count*cols_);
+			try { mtx.insert(mtx.end(), _data, _data + _count*cols_); }
+			catch (...) {
+				mtx.erase(mtx.begin() + old_size, mtx.end());
+				throw;
+			}
+			rows_ += _count;
+		}
+		template<class AnyLayout>
+		void append_rows_impl(const value_type* _data, size_type _count, AnyLayout) {
+			const size_type cols = cols_;
+			insert_rows_impl(rows_, _count, [_data, cols](size_type r, size_type j) -> const value_type& {
+				return _data[r*cols + j];
+			});
+		}
+		template<class RowIt>
+		void append_rows_impl(RowIt _first, RowIt _last, row_major) {
+			const size_type old_size = mtx.size();
+			reserve_rows(_first, _last, typename std::iterator_traits<RowIt>::iterator_category());
+			size_type count = 0U;
+			try {
+				for (; _first != _last; ++_first, ++count) append_row_to(mtx, *_first);
+			}
+			catch (...) {
+				mtx.erase(mtx.begin() + old_size, mtx.end());
+				throw;
+			}
+			rows_ += count;
+		}
+		template<class RowIt, class AnyLayout>
+		void append_rows_impl(RowIt _first, RowIt _last, AnyLayout) {
+			// rows are gathered in row-major order then moved into place by a single rebuild
+			storage_type rows(mtx.get_allocator());
+			size_type count = 0U;
+			for (; _first != _last; ++_first, ++count) append_row_to(rows, *_first);
+			if (!count) return;
+			const size_type cols = cols_;
+			insert_rows_impl(rows_, count, [&rows, cols](size_type r, size_type j) -> value_type&& {
+				return std::move(rows[r*cols + j]);
+			});
+		}
+		template<class... Args>
+		void emplace_row_impl(row_major, Args&... _args) {
+			const size_type old_size = mtx.size();
+			if (old_size + cols_ > mtx.capacity()) {
+				// _args may refer to elements of this container, which growing the storage invalidates, so the
+				// value of the new elements is constructed before reallocating
+				const value_type val(_args...);
+				insert_major(rows_, 1U, cols_, [&val](size_type, size_type) -> const value_type& { return val; });
+				++rows_;
+				return;
+			}
+			try {
+				for (size_type j = 0; j < cols_; ++j) mtx.emplace_back(_args...);
+			}
+			catch (...) {
+				mtx.erase(mtx.begin() + old_size, mtx.end());
+				throw;
+			}
+			++rows_;
+		}
+		template<class AnyLayout, class... Args>
+		void emplace_row_impl(AnyLayout, Args&... _args) {
+			// constructed before the existing elements are moved, as _args may refer to one of them
+			const value_type val(_args...);
+			insert_rows_impl(rows_, 1U, [&val](size_type, size_type) -> const value_type& { return val; });
+		}
+		iterator erase_major(size_type _pos, size_type _count, size_type _minor) {
+			return mtx.erase(mtx.begin() + _pos*_minor, mtx.begin() + (_pos + _count)*_minor);
+		}
+		/**
+		 * \brief Erases `_count` elements from position `_pos` of each of the `_major` lines, compacting the
+		 *        remaining elements in a single forward pass without reallocation.
+		 */
+		iterator erase_minor(size_type _pos, size_type _count, size_type _major, size_type _minor) {
+			const size_type new_minor = _minor - _count;
+			if (!_major) return mtx.end();
+			if (_count) {
+				const auto first = mtx.begin();
+				auto dest = first + _pos;
+				// the survivors between two erased blocks - the tail of line l and the head
+				// of line l+1 - are contiguous, so each is shifted down with a single move
+				for (size_type l = 0; l < _major; ++l) {
+					const auto line = first + l*_minor;
+					dest = std::move(line + _pos + _count, line + _minor, dest);
+					if (l + 1 < _major) dest = std::move(line + _minor, line + _minor + _pos, dest);
+				}
+				mtx.erase(dest, mtx.end());
+			}
+			return mtx.begin() + (_major - 1)*new_minor + _pos;
+		}
+		/**
+		 * \brief Rebuilds the storage for a `_rows` by `_cols` matrix in `Layout` order, where element `(i,j)`
+		 *        is taken from the existing element `(_row_map(i), _col_map(j))` if neither index is `no_index`,
+		 *        otherwise from `_gen(i, j)`. Provides the strong guarantee in the same manner as `insert_minor`.
+		 */
+		template<class RowMap, class ColMap, class Generator>
+		void relayout(size_type _rows, size_type _cols, RowMap&& _row_map, ColMap&& _col_map, Generator&& _gen) {
+			storage_type tmp(mtx.get_allocator());
+			tmp.reserve(_rows*_cols);
+			try {
+				Layout::for_each_index(_rows, _cols, [&](size_type i, size_type j) {
+					const size_type oi = _row_map(i), oj = _col_map(j);
+					if (oi == no_index || oj == no_index) tmp.push_back(_gen(i, j));
+					else tmp.push_back(std::move_if_noexcept(mtx[Layout::offset(oi, oj, rows_, cols_)]));
+				});
+			}
+			catch (...) {
+				if (std::is_nothrow_move_constructible<value_type>::value) {
+					size_type k = 0U;
+					const size_type moved = tmp.size();
+					Layout::for_each_index(_rows, _cols, [&](size_type i, size_type j) {
+						const size_type oi = _row_map(i), oj = _col_map(j);
+						if (k < moved && oi != no_index && oj != no_index)
+							mtx[Layout::offset(oi, oj, rows_, cols_)] = std::move(tmp[k]);
+						++k;
+					});
+				}
+				throw;
+			}
+			mtx.swap(tmp);
+			rows_ = _rows;
+			cols_ = _cols;
+		}
+		// maps an index of the resized dimension to its index before inserting _count at _pos
+		static size_type map_inserted(size_type _idx, size_type _pos, size_type _count) noexcept {
+			return _idx < _pos ? _idx : (_idx < _pos + _count ? no_index : _idx - _count);
+		}
+		// maps an index of the resized dimension to its index before erasing _count at _pos
+		static size_type map_erased(size_type _idx, size_type _pos, size_type _count) noexcept {
+			return _idx < _pos ? _idx : _idx + _count;
+		}
+		static size_type map_identity(size_type _idx) noexcept { return _idx; }
+		// each of the following inserts or erases whole rows or columns, with `_gen(r, j)` giving element
+		// `j` of the `r`-th new row, or `_gen(i, c)` giving element `i` of the `c`-th new column
+		template<class Generator>
+		iterator insert_rows_impl(size_type _pos, size_type _count, Generator&& _gen, row_major) {
+			iterator it = insert_major(_pos, _count, cols_, _gen);
+			rows_ += _count;
+			return it;
+		}
+		template<class Generator>
+		iterator insert_rows_impl(size_type _pos, size_type _count, Generator&& _gen, column_major) {
+			iterator it = insert_minor(_pos, _count, cols_, rows_, [&_gen](size_type l, size_type k) -> decltype(auto) {
+				return _gen(k, l);
+			});
+			rows_ += _count;
+			return it;
+		}
+		template<class Generator, class AnyLayout>
+		iterator insert_rows_impl(size_type _pos, size_type _count, Generator&& _gen, AnyLayout) {
+			relayout(rows_ + _count, cols_,
+				[_pos, _count](size_type i) { return map_inserted(i, _pos, _count); }, map_identity,
+				[_pos, &_gen](size_type i, size_type j) -> decltype(auto) { return _gen(i - _pos, j); });
+			return (_pos < rows_ && cols_) ? mtx.begin() + Layout::offset(_pos, 0U, rows_, cols_) : mtx.end();
+		}
+		template<class Generator>
+		iterator insert_rows_impl(size_type _pos, size_type _count, Generator&& _gen) {
+			return insert_rows_impl(_pos, _count, std::forward<Generator>(_gen), Layout());
+		}
+		template<class Generator>
+		iterator insert_columns_impl(size_type _pos, size_type _count, Generator&& _gen, row_major) {
+			iterator it = insert_minor(_pos, _count, rows_, cols_, _gen);
+			cols_ += _count;
+			return it;
+		}
+		template<class Generator>
+		iterator insert_columns_impl(size_type _pos, size_type _count, Generator&& _gen, column_major) {
+			iterator it = insert_major(_pos, _count, rows_, [&_gen](size_type l, size_type m) -> decltype(auto) {
+				return _gen(m, l);
+			});
+			cols_ += _count;
+			return it;
+		}
+		template<class Generator, class AnyLayout>
+		iterator insert_columns_impl(size_type _pos, size_type _count, Generator&& _gen, AnyLayout) {
+			relayout(rows_, cols_ + _count,
+				map_identity, [_pos, _count](size_type j) { return map_inserted(j, _pos, _count); },
+				[_pos, &_gen](size_type i, size_type j) -> decltype(auto) { return _gen(i, j - _pos); });
+			return (rows_ && _pos < cols_) ? mtx.begin() + Layout::offset(0U, _pos, rows_, cols_) : mtx.end();
+		}
+		template<class Generator>
+		iterator insert_columns_impl(size_type _pos, size_type _count, Generator&& _gen) {
+			return insert_columns_impl(_pos, _count, std::forward<Generator>(_gen), Layout());
+		}
+		iterator erase_rows_impl(size_type _pos, size_type _count, row_major) {
+			iterator it = erase_major(_pos, _count, cols_);
+			rows_ -= _count;
+			return it;
+		}
+		iterator erase_rows_impl(size_type _pos, size_type _count, column_major) {
+			iterator it = erase_minor(_pos, _count, cols_, rows_);
+			rows_ -= _count;
+			return it;
+		}
+		template<class AnyLayout>
+		iterator erase_rows_impl(size_type _pos, size_type _count, AnyLayout) {
+			// no element of the result is new, so the generator is never invoked
+			relayout(rows_ - _count, cols_,
+				[_pos, _count](size_type i) { return map_erased(i, _pos, _count); }, map_identity,
+				[this](size_type, size_type) -> const value_type& { return mtx.front(); });
+			return (_pos < rows_ && cols_) ? mtx.begin() + Layout::offset(_pos, 0U, rows_, cols_) : mtx.end();
+		}
+		iterator erase_rows_impl(size_type _pos, size_type _count) {
+			return erase_rows_impl(_pos, _count, Layout());
+		}
+		iterator erase_columns_impl(size_type _pos, size_type _count, row_major) {
+			iterator it = erase_minor(_pos, _count, rows_, cols_);
+			cols_ -= _count;
+			return it;
+		}
+		iterator erase_columns_impl(size_type _pos, size_type _count, column_major) {
+			iterator it = erase_major(_pos, _count, rows_);
+			cols_ -= _count;
+			return it;
+		}
+		template<class AnyLayout>
+		iterator erase_columns_impl(size_type _pos, size_type _count, AnyLayout) {
+			// no element of the result is new, so the generator is never invoked
+			relayout(rows_, cols_ - _count,
+				map_identity, [_pos, _count](size_type j) { return map_erased(j, _pos, _count); },
+				[this](size_type, size_type) -> const value_type& { return mtx.front(); });
+			return (rows_ && _pos < cols_) ? mtx.begin() + Layout::offset(rows_ - 1U, _pos, rows_, cols_) : mtx.end();
+		}
+		iterator erase_columns_impl(size_type _pos, size_type _count) {
+			return erase_columns_impl(_pos, _count, Layout());
+		}
+		// the rows of a row_major matrix and the columns of a column_major matrix are both transposed by
+		// transposing the storage as a row-major array of lines
+		void transpose_impl(row_major) {
+			kernels::transpose_inplace(rows_, cols_, mtx.data());
+			std::swap(rows_, cols_);
+		}
+		void transpose_impl(column_major) {
+			kernels::transpose_inplace(cols_, rows_, mtx.data());
+			std::swap(rows_, cols_);
+		}
+		template<class AnyLayout>
+		void transpose_impl(AnyLayout) {
+			storage_type tmp(mtx.get_allocator());
+			tmp.reserve(mtx.size());
+			Layout::for_each_index(cols_, rows_, [this, &tmp](size_type i, size_type j) {
+				tmp.push_back(std::move_if_noexcept(mtx[Layout::offset(j, i, rows_, cols_)]));
+			});
+			mtx.swap(tmp);
+			std::swap(rows_, cols_);
+		}
 	};
 	/**
 	 * \brief Exchanges the contents of two `dynamic_matrix` containers, `lhs` and `rhs`.
@@ -1230,10 +1745,32 @@ namespace crsc {
 	 * \param rhs Second instance of `dynamic_matrix`.
 	 */
 	template<typename Ty,
-		class Allocator = std::allocator<Ty>
-	> void swap(dynamic_matrix<Ty, Allocator>& lhs, dynamic_matrix<Ty, Allocator>& rhs) {
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> void swap(dynamic_matrix<Ty, Allocator, Layout>& lhs, dynamic_matrix<Ty, Allocator, Layout>& rhs) {
 		lhs.swap(rhs);
 	}
+	/**
+	 * \brief A `dynamic_matrix` holding up to `N` elements inside the object, allocating through `Allocator` only
+	 *        when resized beyond `N` elements.
+	 */
+	template<typename Ty,
+		std::size_t N,
+		class Layout = row_major,
+		class Allocator = std::allocator<Ty>
+	> using small_dynamic_matrix = dynamic_matrix<Ty, small_buffer_allocator<Ty, N, Allocator>, Layout>;
+	/**
+	 * \brief A `dynamic_matrix` whose copies share their elements, through an atomic reference count, until either
+	 *        is accessed through a non-const member function, at which point that copy duplicates the elements.
+	 *
+	 * Passing such a matrix by value through functions which only read it (through a const reference or a const
+	 * copy) never copies the elements. Note that non-const access, e.g. `operator()` on a non-const matrix, copies
+	 * a shared buffer even when only reading.
+	 */
+	template<typename Ty,
+		class Layout = row_major,
+		class Allocator = std::allocator<Ty>
+	> using cow_dynamic_matrix = dynamic_matrix<Ty, cow_allocator<Ty, Allocator>, Layout>;
 	/**
 	 * \brief Stream insertion operator. Inserts formatted `dynamic_matrix` contents to a `std::ostream`.
 	 *
@@ -1245,13 +1782,13 @@ namespace crsc {
 	 */
 	template<typename Ty,
 		class Allocator = std::allocator<Ty>,
+		class Layout = row_major,
 		class = std::enable_if_t<has_insertion_operator<Ty>::value>
-	> std::ostream& operator<<(std::ostream& os, const dynamic_matrix<Ty, Allocator>& dm) {
-		typename dynamic_matrix<Ty, Allocator>::size_type count = 0U;
-		for (const auto& el : dm) {
-			os << el << ' ';
-			++count;
-			if (!(count % dm.columns())) os << '\n';
+	> std::ostream& operator<<(std::ostream& os, const dynamic_matrix<Ty, Allocator, Layout>& dm) {
+		for (std::size_t i = 0; i < dm.rows(); ++i) {
+			for (std::size_t j = 0; j < dm.columns(); ++j)
+				os << dm(i, j) << ' ';
+			os << '\n';
 		}
 		return os;
 	}
@@ -1264,6 +1801,7 @@ namespace crsc {
 	 * \tparam Ty Type of stored elements.
 	 * \tparam Allocator An allocator that is used to acquire memory to store the elements. The type must meet the requirements
 	 *                of `Allocator` (see C++ Standard). Behaviour is undefined if `Allocator::value_type != Ty`.
+	 * \tparam Layout Storage layout policy of the resulting container.
 	 * \param arr_2d Two-dimensional C-style array used as source to initialise elements of the container with, deleted after use.
 	 * \param rows Number of rows.
 	 * \param cols Number of columns.
@@ -1274,9 +1812,10 @@ namespace crsc {
 	 *                  additionally undefined behaviour if either of `_rows`, `_cols` is not equal to rows, columns of `_arr_2d`.
 	 */
 	template<typename Ty,
-		class Allocator = std::allocator<Ty>
-	> dynamic_matrix< Ty, Allocator> to_dynamic_matrix(Ty** arr_2d, std::size_t rows, std::size_t cols, const Allocator& alloc = Allocator()) {
-		dynamic_matrix<Ty, Allocator> dynmtx(arr_2d, rows, cols, alloc);
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout> to_dynamic_matrix(Ty** arr_2d, std::size_t rows, std::size_t cols, const Allocator& alloc = Allocator()) {
+		dynamic_matrix<Ty, Allocator, Layout> dynmtx(arr_2d, rows, cols, alloc);
 		for (std::size_t i = 0; i < rows; ++i) delete[] arr_2d[i];
 		delete[] arr_2d;
 		return dynmtx;
@@ -1291,6 +1830,7 @@ namespace crsc {
 	 * \tparam Ty Type of stored elements.
 	 * \tparam Allocator An allocator that is used to acquire memory to store the elements. The type must meet the requirements
 	 *                of `Allocator` (see C++ Concepts). Behaviour is undefined if `Allocator::value_type != Ty`.
+	 * \tparam Layout Storage layout policy of the resulting container.
 	 * \param arr_2d Two-dimensional C-style array used as source to initialise elements of the container with.
 	 * \param rows Number of rows.
 	 * \param cols Number of columns.
@@ -1301,19 +1841,22 @@ namespace crsc {
 	 *                  additionally undefined behaviour if either of `_rows`, `_cols` is not equal to rows, columns of `_arr_2d`.
 	 */
 	template<typename Ty,
-		class Allocator = std::allocator<Ty>
-	> dynamic_matrix<Ty, Allocator> make_dynamic_matrix(Ty** arr_2d, std::size_t rows, std::size_t cols, const Allocator& alloc = Allocator()) {
-		return dynamic_matrix<Ty, Allocator>(arr_2d, rows, cols, alloc);
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout> make_dynamic_matrix(Ty** arr_2d, std::size_t rows, std::size_t cols, const Allocator& alloc = Allocator()) {
+		return dynamic_matrix<Ty, Allocator, Layout>(arr_2d, rows, cols, alloc);
 	}
 	/**
 	 * \brief Returns the specified row of a `crsc::dynamic_matrix` instance as a `std::vector`.
+	 * \see crsc::row_view (matrix_view.h) for access to the row without copying.
 	 * \param dm `crsc::dynamic_matrix` instance.
 	 * \param row row index.
 	 * \return `std::vector` containing all elements from `row` row index.
 	 */
 	template<typename Ty,
-		class Allocator = std::allocator<Ty>
-	> std::vector<Ty, Allocator> dynamic_matrix_row(const dynamic_matrix<Ty, Allocator>& dm, std::size_t row) {
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<Ty, Allocator> dynamic_matrix_row(const dynamic_matrix<Ty, Allocator, Layout>& dm, std::size_t row) {
 		std::vector<Ty, Allocator> row_vec;
 		row_vec.reserve(dm.columns());
 		for (auto i = 0U; i < dm.columns(); ++i)
@@ -1322,13 +1865,15 @@ namespace crsc {
 	}
 	/**
 	 * \brief Returns the specified column of a `crsc::dynamic_matrix` instance as a `std::vector`.
+	 * \see crsc::column_view (matrix_view.h) for access to the column without copying.
 	 * \param dm `crsc::dynamic_matrix` instance.
 	 * \param col column index.
 	 * \return `std::vector` containing all elements from `col` column index. 
 	 */
 	template<typename Ty,
-		class Allocator = std::allocator<Ty>
-	> std::vector<Ty, Allocator> dynamic_matrix_column(const dynamic_matrix<Ty, Allocator>& dm, std::size_t col) {
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<Ty, Allocator> dynamic_matrix_column(const dynamic_matrix<Ty, Allocator, Layout>& dm, std::size_t col) {
 		std::vector<Ty, Allocator> col_vec;
 		col_vec.reserve(dm.rows());
 		for (auto i = 0U; i < dm.rows(); ++i)
@@ -1344,16 +1889,16 @@ namespace crsc {
 	 * \throw Throws `std::invalid_argument` exception if `lhs.rows() != rhs.rows() ||
 	 *        lhs.columns() != rhs.columns()`.
 	 * \complexity Linear in `rows()*columns()` (assignments) plus linear in
-	 *             `rows()*columns()` (additions).
+	 *             `rows()*columns()` (additions), vectorized via `crsc::kernels::add`.
 	 */
 	template<typename Ty,
-		class Allocator = std::allocator<Ty>
-	> dynamic_matrix<Ty, Allocator> matrix_sum(const dynamic_matrix<Ty, Allocator>& lhs, const dynamic_matrix<Ty, Allocator>& rhs) {
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout> matrix_sum(const dynamic_matrix<Ty, Allocator, Layout>& lhs, const dynamic_matrix<Ty, Allocator, Layout>& rhs) {
 		if (lhs.rows() != rhs.rows() || lhs.columns() != rhs.columns())
 			throw std::invalid_argument("dynamic_matrix dimensions must agree for component-wise addition.");
-		dynamic_matrix<Ty, Allocator> sum(lhs.rows(), lhs.columns());
-		for (auto itlhs = lhs.begin(), itrhs = rhs.begin(), itsum = sum.begin(); itsum < sum.end(); ++itlhs, ++itrhs, ++itsum)
-			*itsum = *itlhs + *itrhs;
+		dynamic_matrix<Ty, Allocator, Layout> sum(lhs.rows(), lhs.columns());
+		kernels::add(lhs.data(), rhs.data(), sum.data(), sum.size());
 		return sum;
 	}
 	/**
@@ -1365,42 +1910,185 @@ namespace crsc {
 	 * \throw Throws `std::invalid_argument` exception if `lhs.rows() != rhs.rows() ||
 	 *        lhs.columns() != rhs.columns()`.
 	 * \complexity Linear in `rows()*columns()` (assignments) plus linear in
-	 *             `rows()*columns()` (subtractions).
+	 *             `rows()*columns()` (subtractions), vectorized via `crsc::kernels::subtract`.
 	 */
 	template<typename Ty, 
-		class Allocator = std::allocator<Ty>
-	> dynamic_matrix<Ty, Allocator> matrix_difference(const dynamic_matrix<Ty, Allocator>& lhs, const dynamic_matrix<Ty, Allocator>& rhs) {
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout> matrix_difference(const dynamic_matrix<Ty, Allocator, Layout>& lhs, const dynamic_matrix<Ty, Allocator, Layout>& rhs) {
 		if (lhs.rows() != rhs.rows() || lhs.columns() != rhs.columns())
 			throw std::invalid_argument("dynamic_matrix dimensions must agree for component-wise subtraction.");
-		dynamic_matrix<Ty, Allocator> difference(lhs.rows(), lhs.columns());
-		for (auto itlhs = lhs.begin(), itrhs = rhs.begin(), itdiff = difference.begin(); itdiff < difference.end(); ++itlhs, ++itrhs, ++itdiff)
-			*itdiff = *itlhs - *itrhs;
+		dynamic_matrix<Ty, Allocator, Layout> difference(lhs.rows(), lhs.columns());
+		kernels::subtract(lhs.data(), rhs.data(), difference.data(), difference.size());
 		return difference;
 	}
+	/**
+	 * \brief Returns a `dynamic_matrix` whose elements equal the component-wise (Hadamard) product of `lhs` and `rhs`.
+	 *
+	 * \param lhs First instance of `dynamic_matrix`.
+	 * \param rhs Second instance of `dynamic_matrix`.
+	 * \return Container consisting of Hadamard product of `lhs` and `rhs`.
+	 * \throw Throws `std::invalid_argument` exception if `lhs.rows() != rhs.rows() ||
+	 *        lhs.columns() != rhs.columns()`.
+	 * \complexity Linear in `rows()*columns()` (assignments) plus linear in
+	 *             `rows()*columns()` (multiplications).
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout> matrix_hadamard_product(const dynamic_matrix<Ty, Allocator, Layout>& lhs, const dynamic_matrix<Ty, Allocator, Layout>& rhs) {
+		if (lhs.rows() != rhs.rows() || lhs.columns() != rhs.columns())
+			throw std::invalid_argument("dynamic_matrix dimensions must agree for component-wise multiplication.");
+		dynamic_matrix<Ty, Allocator, Layout> product(lhs.rows(), lhs.columns());
+		kernels::hadamard(lhs.data(), rhs.data(), product.data(), product.size());
+		return product;
+	}
+	/**
+	 * \brief Returns a `dynamic_matrix` whose elements equal those of `dm` multiplied by `scale`.
+	 *
+	 * \param dm Instance of `dynamic_matrix`.
+	 * \param scale Scalar to multiply each element by.
+	 * \return Container consisting of `dm` scaled by `scale`.
+	 * \complexity Linear in `rows()*columns()` (assignments) plus linear in
+	 *             `rows()*columns()` (multiplications).
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout> matrix_scalar_product(const dynamic_matrix<Ty, Allocator, Layout>& dm, const Ty& scale) {
+		dynamic_matrix<Ty, Allocator, Layout> product(dm.rows(), dm.columns());
+		kernels::scale(dm.data(), scale, product.data(), product.size());
+		return product;
+	}
+	/**
+	 * \brief Computes `y += alpha*x` in-place on `y`.
+	 *
+	 * \param alpha Scalar multiplier of `x`.
+	 * \param x Instance of `dynamic_matrix` to scale and accumulate.
+	 * \param y Instance of `dynamic_matrix` to accumulate into.
+	 * \return Reference to `y`.
+	 * \throw Throws `std::invalid_argument` exception if `x.rows() != y.rows() ||
+	 *        x.columns() != y.columns()`.
+	 * \complexity Linear in `rows()*columns()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout>& matrix_axpy(const Ty& alpha, const dynamic_matrix<Ty, Allocator, Layout>& x, dynamic_matrix<Ty, Allocator, Layout>& y) {
+		if (x.rows() != y.rows() || x.columns() != y.columns())
+			throw std::invalid_argument("dynamic_matrix dimensions must agree for matrix_axpy.");
+		kernels::axpy(alpha, x.data(), y.data(), y.size());
+		return y;
+	}
+	/**
+	 * \brief Detail namespace for implementation of the layout-dependent free algorithms.
+	 */
+	namespace dynamic_matrix_impl {
+		// accumulates rows [first, last) of the m by n product c of the m by k matrix a with the k by n
+		// matrix b, where all three are stored in the strided layout Layout
+		template<class Layout, typename Ty>
+		void gemm_rows(std::size_t first, std::size_t last, std::size_t m, std::size_t n, std::size_t k,
+			const Ty* a, const Ty* b, Ty* c, std::true_type) {
+			const std::size_t rsa = Layout::row_stride(m, k), rsc = Layout::row_stride(m, n);
+			kernels::gemm(last - first, n, k,
+				a + first*rsa, rsa, Layout::column_stride(m, k),
+				b, Layout::row_stride(k, n), Layout::column_stride(k, n),
+				c + first*rsc, rsc, Layout::column_stride(m, n));
+		}
+		// as above for tiled layouts, where first is a multiple of the tile size - each tile is a contiguous
+		// row-major block, so the product is accumulated tile by tile directly from storage
+		template<class Layout, typename Ty>
+		void gemm_rows(std::size_t first, std::size_t last, std::size_t m, std::size_t n, std::size_t k,
+			const Ty* a, const Ty* b, Ty* c, std::false_type) {
+			const std::size_t tile = Layout::tile_size;
+			for (std::size_t ti = first; ti < last; ti += tile) {
+				const std::size_t height = std::min(tile, m - ti);
+				for (std::size_t tj = 0; tj < n; tj += tile) {
+					const std::size_t width = std::min(tile, n - tj);
+					for (std::size_t tk = 0; tk < k; tk += tile) {
+						const std::size_t depth = std::min(tile, k - tk);
+						kernels::gemm(height, width, depth,
+							a + Layout::offset(ti, tk, m, k), depth, 1,
+							b + Layout::offset(tk, tj, k, n), width, 1,
+							c + Layout::offset(ti, tj, m, n), width, 1);
+					}
+				}
+			}
+		}
+		// granularity in rows at which gemm_rows may split the product
+		template<class Layout, typename Ty>
+		std::size_t gemm_row_alignment(std::true_type) { return kernels::gemm_blocking<Ty>::mr; }
+		template<class Layout, typename Ty>
+		std::size_t gemm_row_alignment(std::false_type) { return Layout::tile_size; }
+		// computes rows [first, last) of y += a*x for the m by n matrix a, by a single strided kernel call
+		template<class Layout, typename Ty>
+		void gemv_rows(std::size_t first, std::size_t last, std::size_t m, std::size_t n,
+			const Ty* a, const Ty* x, Ty* y, std::true_type) {
+			const std::size_t rsa = Layout::row_stride(m, n);
+			kernels::gemv(last - first, n, a + first*rsa, rsa, Layout::column_stride(m, n), x, y + first);
+		}
+		// as above for tiled layouts, where first is a multiple of the tile size
+		template<class Layout, typename Ty>
+		void gemv_rows(std::size_t first, std::size_t last, std::size_t m, std::size_t n,
+			const Ty* a, const Ty* x, Ty* y, std::false_type) {
+			const std::size_t tile = Layout::tile_size;
+			for (std::size_t ti = first; ti < last; ti += tile) {
+				const std::size_t height = std::min(tile, m - ti);
+				for (std::size_t tj = 0; tj < n; tj += tile) {
+					const std::size_t width = std::min(tile, n - tj);
+					kernels::gemv(height, width, a + Layout::offset(ti, tj, m, n), width, 1, x + tj, y + ti);
+				}
+			}
+		}
+	}
 	/**
 	 * \brief Returns a `dynamic_matrix` which gives the matrix product of `lhs` with `rhs`.
 	 *
 	 * \param lhs First instance of `dynamic_matrix`.
 	 * \param rhs Second instance of `dynamic_matrix`.
 	 * \return Container consisting of product of `lhs` and `rhs`.
+	 * The product is computed by `crsc::kernels::gemm` which, for arithmetic `Ty`, packs cache-sized blocks of
+	 * both operands into contiguous buffers and accumulates register-sized tiles of the result, such that the
+	 * storage of neither operand is walked against its layout. For `tiled` layouts the product is accumulated
+	 * tile by tile.
+	 *
 	 * \throw Throws `std::invalid_argument` exception if `lhs.columns() != rhs.rows()`.
 	 * \complexity Linear in `lhs.rows()*rhs.columns()*lhs.columns()`.
 	 */
 	template<typename Ty,
-		class Allocator = std::allocator<Ty>
-	> dynamic_matrix<Ty, Allocator> matrix_product(const dynamic_matrix<Ty, Allocator>& lhs, const dynamic_matrix<Ty, Allocator>& rhs) {
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout> matrix_product(const dynamic_matrix<Ty, Allocator, Layout>& lhs, const dynamic_matrix<Ty, Allocator, Layout>& rhs) {
 		if (lhs.columns() != rhs.rows())
 			throw std::invalid_argument("dynamic_matrix dimensions must agree for matrix_product.");
-		dynamic_matrix<Ty, Allocator> product(lhs.rows(), rhs.columns());
-		typedef typename dynamic_matrix<Ty, Allocator>::size_type size_type;
-		for (size_type i = 0; i < product.rows(); ++i) {
-			for (size_type j = 0; j < product.columns(); ++j) {
-				for (size_type k = 0; k < lhs.columns(); ++k)
-					product(i,j) += lhs(i,k) * rhs(k,j);
-			}
-		}
+		dynamic_matrix<Ty, Allocator, Layout> product(lhs.rows(), rhs.columns());
+		dynamic_matrix_impl::gemm_rows<Layout>(0U, lhs.rows(), lhs.rows(), rhs.columns(), lhs.columns(),
+			lhs.data(), rhs.data(), product.data(), is_strided_layout<Layout>());
 		return product;
 	}
+	/**
+	 * \brief Returns the product `dm*x` of a `dynamic_matrix` with a vector.
+	 *
+	 * The product is computed by `crsc::kernels::gemv`, as dot products of the rows of `dm` with `x` for
+	 * `row_major` layouts and as a sum of the scaled columns of `dm` for `column_major` layouts, such that the
+	 * storage of `dm` is read in order, and tile by tile for `tiled` layouts.
+	 *
+	 * \param dm Instance of `dynamic_matrix`.
+	 * \param x Vector of `dm.columns()` elements.
+	 * \return Vector of `dm.rows()` elements.
+	 * \throw Throws `std::invalid_argument` exception if `x.size() != dm.columns()`.
+	 * \complexity Linear in `dm.rows()*dm.columns()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<Ty, Allocator> matrix_vector_product(const dynamic_matrix<Ty, Allocator, Layout>& dm, const std::vector<Ty, Allocator>& x) {
+		if (x.size() != dm.columns())
+			throw std::invalid_argument("dynamic_matrix columns must equal vector size for matrix_vector_product.");
+		std::vector<Ty, Allocator> y(dm.rows(), Ty(), x.get_allocator());
+		dynamic_matrix_impl::gemv_rows<Layout>(0U, dm.rows(), dm.rows(), dm.columns(), dm.data(), x.data(), y.data(), is_strided_layout<Layout>());
+		return y;
+	}
 	/**
 	 * \brief Computes the trace of a `dynamic_matrix` container instance `dm`.
 	 *
@@ -1410,14 +2098,311 @@ namespace crsc {
 	 * \complexity Linear in `dm.rows()`.
 	 */
 	template<typename Ty,
-		class Allocator = std::allocator<Ty>
-	> Ty matrix_trace(const dynamic_matrix<Ty, Allocator>& dm) {
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> Ty matrix_trace(const dynamic_matrix<Ty, Allocator, Layout>& dm) {
+		if (dm.rows() != dm.columns()) throw std::invalid_argument("cannot compute trace of non-square dynamic_matrix.");
+		Ty trace = Ty();
+		for (std::size_t i = 0; i < dm.rows(); ++i)
+			trace += dm(i, i);
+		return trace;
+	}
+	namespace dynamic_matrix_impl {
+		// writes the transpose of the m by n matrix src to dst, both stored in Layout
+		template<typename Ty>
+		void transpose(std::size_t m, std::size_t n, const Ty* src, Ty* dst, row_major) {
+			kernels::transpose(m, n, src, n, dst, m);
+		}
+		template<typename Ty>
+		void transpose(std::size_t m, std::size_t n, const Ty* src, Ty* dst, column_major) {
+			kernels::transpose(n, m, src, m, dst, n);
+		}
+		// each tile of a tiled layout is a contiguous row-major block, whose transpose is the tile at the
+		// mirrored position of the result
+		template<typename Ty, class Layout>
+		void transpose(std::size_t m, std::size_t n, const Ty* src, Ty* dst, Layout) {
+			const std::size_t tile = Layout::tile_size;
+			for (std::size_t ti = 0; ti < m; ti += tile) {
+				const std::size_t height = std::min(tile, m - ti);
+				for (std::size_t tj = 0; tj < n; tj += tile) {
+					const std::size_t width = std::min(tile, n - tj);
+					kernels::transpose(height, width, src + Layout::offset(ti, tj, m, n), width,
+						dst + Layout::offset(tj, ti, n, m), height);
+				}
+			}
+		}
+	}
+	/**
+	 * \brief Returns a `dynamic_matrix` which gives the transpose of `dm`.
+	 *
+	 * The transpose is computed by `crsc::kernels::transpose`, which recursively splits the matrix into blocks
+	 * small enough for both the source and destination to remain in cache and, for `float` and `double`,
+	 * transposes these blocks as SIMD register tiles.
+	 *
+	 * \param dm Instance of `dynamic_matrix`.
+	 * \return Container of `dm.columns()` rows and `dm.rows()` columns consisting of the transpose of `dm`.
+	 * \complexity Linear in `dm.rows()*dm.columns()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout> matrix_transpose(const dynamic_matrix<Ty, Allocator, Layout>& dm) {
+		dynamic_matrix<Ty, Allocator, Layout> transposed(dm.columns(), dm.rows());
+		dynamic_matrix_impl::transpose(dm.rows(), dm.columns(), dm.data(), transposed.data(), Layout());
+		return transposed;
+	}
+	/**
+	 * \brief Default problem sizes below which the `thread_pool` overloads of the free algorithms take the serial
+	 *        path, as the cost of distributing the work would outweigh the gain.
+	 */
+	namespace parallel_cutoffs {
+		// multiply-adds, i.e. lhs.rows()*rhs.columns()*lhs.columns()
+		constexpr std::size_t product = 128U * 128U * 128U;
+		// elements of the result
+		constexpr std::size_t elementwise = 1U << 16;
+		// diagonal elements
+		constexpr std::size_t trace = 1U << 20;
+		// elements of the matrix, i.e. rows()*columns()
+		constexpr std::size_t matrix_vector = 1U << 18;
+	}
+	/**
+	 * \brief Detail namespace for implementation of the parallel free algorithms.
+	 */
+	namespace dynamic_matrix_parallel_impl {
+		// one chunk per thread, rounded up to a multiple of align, so that per-chunk setup is paid once per thread
+		inline std::size_t chunk_size(std::size_t count, std::size_t threads, std::size_t align) {
+			const std::size_t chunk = (count + threads - 1) / threads;
+			return (chunk + align - 1) / align * align;
+		}
+		template<kernels::elementwise_op Op, typename Ty>
+		void elementwise(thread_pool& pool, const Ty* a, const Ty* b, Ty* out, const Ty& s, std::size_t n, std::size_t cutoff) {
+			if (n < cutoff || pool.size() < 2U) {
+				kernels::elementwise<Op>(a, b, out, s, n);
+				return;
+			}
+			pool.parallel_for(0U, n, chunk_size(n, pool.size() + 1U, 64U), [=, &s](std::size_t first, std::size_t last) {
+				kernels::elementwise<Op>(a + first, (Op == kernels::elementwise_op::scale) ? b : b + first, out + first, s, last - first);
+			});
+		}
+	}
+	/**
+	 * \brief Returns a `dynamic_matrix` whose elements equal the component-wise addition of `lhs` and `rhs`, with
+	 *        the work partitioned into contiguous blocks across the threads of `pool`.
+	 *
+	 * \param pool Thread pool on which to execute.
+	 * \param lhs First instance of `dynamic_matrix`.
+	 * \param rhs Second instance of `dynamic_matrix`.
+	 * \param cutoff Number of elements below which the serial `matrix_sum` is used.
+	 * \return Container consisting of sum of `lhs` and `rhs`.
+	 * \throw Throws `std::invalid_argument` exception if `lhs.rows() != rhs.rows() ||
+	 *        lhs.columns() != rhs.columns()`.
+	 * \complexity Linear in `rows()*columns()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout> matrix_sum(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& lhs, const dynamic_matrix<Ty, Allocator, Layout>& rhs,
+		std::size_t cutoff = parallel_cutoffs::elementwise) {
+		if (lhs.rows() != rhs.rows() || lhs.columns() != rhs.columns())
+			throw std::invalid_argument("dynamic_matrix dimensions must agree for component-wise addition.");
+		dynamic_matrix<Ty, Allocator, Layout> sum(lhs.rows(), lhs.columns());
+		dynamic_matrix_parallel_impl::elementwise<kernels::elementwise_op::add>(pool, lhs.data(), rhs.data(), sum.data(), Ty(), sum.size(), cutoff);
+		return sum;
+	}
+	/**
+	 * \brief Returns a `dynamic_matrix` whose elements equal the component-wise subtraction of `rhs` from `lhs`, with
+	 *        the work partitioned into contiguous blocks across the threads of `pool`.
+	 *
+	 * \param pool Thread pool on which to execute.
+	 * \param lhs First instance of `dynamic_matrix`.
+	 * \param rhs Second instance of `dynamic_matrix`.
+	 * \param cutoff Number of elements below which the serial `matrix_difference` is used.
+	 * \return Container consisting of difference of `lhs` and `rhs`.
+	 * \throw Throws `std::invalid_argument` exception if `lhs.rows() != rhs.rows() ||
+	 *        lhs.columns() != rhs.columns()`.
+	 * \complexity Linear in `rows()*columns()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout> matrix_difference(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& lhs, const dynamic_matrix<Ty, Allocator, Layout>& rhs,
+		std::size_t cutoff = parallel_cutoffs::elementwise) {
+		if (lhs.rows() != rhs.rows() || lhs.columns() != rhs.columns())
+			throw std::invalid_argument("dynamic_matrix dimensions must agree for component-wise subtraction.");
+		dynamic_matrix<Ty, Allocator, Layout> difference(lhs.rows(), lhs.columns());
+		dynamic_matrix_parallel_impl::elementwise<kernels::elementwise_op::subtract>(pool, lhs.data(), rhs.data(), difference.data(), Ty(), difference.size(), cutoff);
+		return difference;
+	}
+	/**
+	 * \brief Returns a `dynamic_matrix` whose elements equal the component-wise (Hadamard) product of `lhs` and `rhs`,
+	 *        with the work partitioned into contiguous blocks across the threads of `pool`.
+	 *
+	 * \param pool Thread pool on which to execute.
+	 * \param lhs First instance of `dynamic_matrix`.
+	 * \param rhs Second instance of `dynamic_matrix`.
+	 * \param cutoff Number of elements below which the serial `matrix_hadamard_product` is used.
+	 * \return Container consisting of Hadamard product of `lhs` and `rhs`.
+	 * \throw Throws `std::invalid_argument` exception if `lhs.rows() != rhs.rows() ||
+	 *        lhs.columns() != rhs.columns()`.
+	 * \complexity Linear in `rows()*columns()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout> matrix_hadamard_product(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& lhs, const dynamic_matrix<Ty, Allocator, Layout>& rhs,
+		std::size_t cutoff = parallel_cutoffs::elementwise) {
+		if (lhs.rows() != rhs.rows() || lhs.columns() != rhs.columns())
+			throw std::invalid_argument("dynamic_matrix dimensions must agree for component-wise multiplication.");
+		dynamic_matrix<Ty, Allocator, Layout> product(lhs.rows(), lhs.columns());
+		dynamic_matrix_parallel_impl::elementwise<kernels::elementwise_op::multiply>(pool, lhs.data(), rhs.data(), product.data(), Ty(), product.size(), cutoff);
+		return product;
+	}
+	/**
+	 * \brief Returns a `dynamic_matrix` whose elements equal those of `dm` multiplied by `scale`, with the work
+	 *        partitioned into contiguous blocks across the threads of `pool`.
+	 *
+	 * \param pool Thread pool on which to execute.
+	 * \param dm Instance of `dynamic_matrix`.
+	 * \param scale Scalar to multiply each element by.
+	 * \param cutoff Number of elements below which the serial `matrix_scalar_product` is used.
+	 * \return Container consisting of `dm` scaled by `scale`.
+	 * \complexity Linear in `rows()*columns()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout> matrix_scalar_product(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& dm, const Ty& scale,
+		std::size_t cutoff = parallel_cutoffs::elementwise) {
+		dynamic_matrix<Ty, Allocator, Layout> product(dm.rows(), dm.columns());
+		dynamic_matrix_parallel_impl::elementwise<kernels::elementwise_op::scale>(pool, dm.data(), static_cast<const Ty*>(nullptr), product.data(), scale, product.size(), cutoff);
+		return product;
+	}
+	/**
+	 * \brief Computes `y += alpha*x` in-place on `y`, with the work partitioned into contiguous blocks across the
+	 *        threads of `pool`.
+	 *
+	 * \param pool Thread pool on which to execute.
+	 * \param alpha Scalar multiplier of `x`.
+	 * \param x Instance of `dynamic_matrix` to scale and accumulate.
+	 * \param y Instance of `dynamic_matrix` to accumulate into.
+	 * \param cutoff Number of elements below which the serial `matrix_axpy` is used.
+	 * \return Reference to `y`.
+	 * \throw Throws `std::invalid_argument` exception if `x.rows() != y.rows() ||
+	 *        x.columns() != y.columns()`.
+	 * \complexity Linear in `rows()*columns()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout>& matrix_axpy(thread_pool& pool, const Ty& alpha, const dynamic_matrix<Ty, Allocator, Layout>& x, dynamic_matrix<Ty, Allocator, Layout>& y,
+		std::size_t cutoff = parallel_cutoffs::elementwise) {
+		if (x.rows() != y.rows() || x.columns() != y.columns())
+			throw std::invalid_argument("dynamic_matrix dimensions must agree for matrix_axpy.");
+		dynamic_matrix_parallel_impl::elementwise<kernels::elementwise_op::axpy>(pool, x.data(), static_cast<const Ty*>(y.data()), y.data(), alpha, y.size(), cutoff);
+		return y;
+	}
+	/**
+	 * \brief Returns a `dynamic_matrix` which gives the matrix product of `lhs` with `rhs`, with blocks of rows of
+	 *        the result computed concurrently across the threads of `pool`.
+	 *
+	 * Each block of rows of the product is computed by an independent call to `crsc::kernels::gemm` on the matching
+	 * rows of `lhs`, such that threads never write to the same part of the result.
+	 *
+	 * \param pool Thread pool on which to execute.
+	 * \param lhs First instance of `dynamic_matrix`.
+	 * \param rhs Second instance of `dynamic_matrix`.
+	 * \param cutoff Number of multiply-adds (`lhs.rows()*rhs.columns()*lhs.columns()`) below which the serial
+	 *        `matrix_product` is used.
+	 * \return Container consisting of product of `lhs` and `rhs`.
+	 * \throw Throws `std::invalid_argument` exception if `lhs.columns() != rhs.rows()`.
+	 * \complexity Linear in `lhs.rows()*rhs.columns()*lhs.columns()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout> matrix_product(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& lhs, const dynamic_matrix<Ty, Allocator, Layout>& rhs,
+		std::size_t cutoff = parallel_cutoffs::product) {
+		if (lhs.columns() != rhs.rows())
+			throw std::invalid_argument("dynamic_matrix dimensions must agree for matrix_product.");
+		const std::size_t m = lhs.rows(), n = rhs.columns(), k = lhs.columns();
+		const std::size_t align = dynamic_matrix_impl::gemm_row_alignment<Layout, Ty>(is_strided_layout<Layout>());
+		if (m*n*k < cutoff || pool.size() < 2U || m < 2U * align)
+			return matrix_product(lhs, rhs);
+		dynamic_matrix<Ty, Allocator, Layout> product(m, n);
+		const Ty* a = lhs.data();
+		const Ty* b = rhs.data();
+		Ty* c = product.data();
+		pool.parallel_for(0U, m, dynamic_matrix_parallel_impl::chunk_size(m, pool.size() + 1U, align),
+			[=](std::size_t first, std::size_t last) {
+			dynamic_matrix_impl::gemm_rows<Layout>(first, last, m, n, k, a, b, c, is_strided_layout<Layout>());
+		});
+		return product;
+	}
+	/**
+	 * \brief Returns the product `dm*x` of a `dynamic_matrix` with a vector, with blocks of rows of the result
+	 *        computed concurrently across the threads of `pool`.
+	 *
+	 * Each thread computes a contiguous block of the elements of the result from the matching rows of `dm`, so
+	 * threads never write to the same part of the result.
+	 *
+	 * \param pool Thread pool on which to execute.
+	 * \param dm Instance of `dynamic_matrix`.
+	 * \param x Vector of `dm.columns()` elements.
+	 * \param cutoff Number of elements of `dm` below which the serial `matrix_vector_product` is used.
+	 * \return Vector of `dm.rows()` elements.
+	 * \throw Throws `std::invalid_argument` exception if `x.size() != dm.columns()`.
+	 * \complexity Linear in `dm.rows()*dm.columns()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<Ty, Allocator> matrix_vector_product(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& dm, const std::vector<Ty, Allocator>& x,
+		std::size_t cutoff = parallel_cutoffs::matrix_vector) {
+		if (x.size() != dm.columns())
+			throw std::invalid_argument("dynamic_matrix columns must equal vector size for matrix_vector_product.");
+		const std::size_t m = dm.rows(), n = dm.columns();
+		const std::size_t align = dynamic_matrix_impl::gemm_row_alignment<Layout, Ty>(is_strided_layout<Layout>());
+		if (m*n < cutoff || pool.size() < 2U || m < 2U * align)
+			return matrix_vector_product(dm, x);
+		std::vector<Ty, Allocator> y(m, Ty(), x.get_allocator());
+		const Ty* a = dm.data();
+		const Ty* px = x.data();
+		Ty* py = y.data();
+		pool.parallel_for(0U, m, dynamic_matrix_parallel_impl::chunk_size(m, pool.size() + 1U, align),
+			[=](std::size_t first, std::size_t last) {
+			dynamic_matrix_impl::gemv_rows<Layout>(first, last, m, n, a, px, py, is_strided_layout<Layout>());
+		});
+		return y;
+	}
+	/**
+	 * \brief Computes the trace of a `dynamic_matrix` container instance `dm`, with partial sums of the diagonal
+	 *        computed concurrently across the threads of `pool`.
+	 *
+	 * \param pool Thread pool on which to execute.
+	 * \param dm `dynamic_matrix` for which to compute the trace.
+	 * \param cutoff Number of rows below which the serial `matrix_trace` is used.
+	 * \return Matrix trace of `dm`.
+	 * \throw Throws `std::invalid_argument` exception if `dm.rows() != dm.columns()`.
+	 * \complexity Linear in `dm.rows()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> Ty matrix_trace(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& dm, std::size_t cutoff = parallel_cutoffs::trace) {
 		if (dm.rows() != dm.columns()) throw std::invalid_argument("cannot compute trace of non-square dynamic_matrix.");
+		const std::size_t n = dm.rows();
+		if (n < cutoff || pool.size() < 2U) return matrix_trace(dm);
+		const std::size_t chunk = dynamic_matrix_parallel_impl::chunk_size(n, pool.size() + 1U, 1U);
+		std::vector<Ty> partials((n + chunk - 1) / chunk, Ty());
+		pool.parallel_for(0U, n, chunk, [&dm, chunk, &partials](std::size_t first, std::size_t last) {
+			Ty partial = Ty();
+			for (std::size_t i = first; i < last; ++i) partial += dm(i, i);
+			partials[first / chunk] = partial;
+		});
 		Ty trace = Ty();
-		for (auto it = dm.begin(); it < dm.end(); std::advance(it, dm.columns() + 1))
-			trace += *it;
+		for (const auto& partial : partials) trace += partial;
 		return trace;
 	}
 }
 
-#endif // !DYNAMIC_MATRIX_H
\ No newline at end of file
+#endif // !DYNAMIC_MATRIX_H
@@ -1,21 +1,28 @@
 #ifndef FIXED_MATRIX_H
 #define FIXED_MATRIX_H
+#include "matrix_kernels.h"
 #include "sfinae_operators.h"
+#include "simd_utilities.h"
 #include <algorithm>
 #include <array>
 #include <iterator>
 #include <ostream>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace crsc {
 	template<typename Ty,
 		std::size_t Rows,
 		std::size_t Cols
 	> class fixed_matrix;
+	template<typename Ty,
+		std::size_t N
+	> class fixed_lu_decomposition;
 	template<typename Ty,
 		std::size_t Rows,
 		std::size_t Cols
-	> void swap(const fixed_matrix<Ty, Rows, Cols>& lhs, const fixed_matrix<Ty, Rows, Cols>& rhs) {
+	> void swap(fixed_matrix<Ty, Rows, Cols>& lhs, fixed_matrix<Ty, Rows, Cols>& rhs) {
 		lhs.swap(rhs);
 	}
 	/**
@@ -66,20 +73,19 @@ namespace crsc {
 		/**
 		 * \class proxy_row_array
 		 *
-		 * \brief Proxy class used for enabling operator[][] overload on fixed_matrix objects.
+		 * \brief Proxy class used for enabling operator[][] overload on fixed_matrix objects, `Array` being
+		 *        the (possibly const-qualified) storage of the matrix.
 		 */
+		template<class Array>
 		class proxy_row_array {
 		public:
-			proxy_row_array(std::array<value_type, _Rows*_Cols>& _row_array, size_type _row_index, size_type _cols)
+			constexpr proxy_row_array(Array& _row_array, size_type _row_index, size_type _cols)
 				: row_array(_row_array), row_index(_row_index), cols(_cols) {}
-			constexpr const_reference operator[](size_type _col_index) const {
-				return row_array[row_index*cols + _col_index];
-			}
-			reference operator[](size_type _col_index) {
+			constexpr auto& operator[](size_type _col_index) const {
 				return row_array[row_index*cols + _col_index];
 			}
 		private:
-			std::array<value_type, _Rows*_Cols>& row_array;
+			Array& row_array;
 			size_type row_index;
 			size_type cols;
 		};
@@ -89,14 +95,20 @@ namespace crsc {
 		 * \brief Default constructor, initialises container with template-specified rows 
 		 *        and columns each taking the default-constructed value of `Ty`.
 		 */
-		fixed_matrix() : mtx() {}
+		constexpr fixed_matrix() : mtx() {}
 		/**
 		 * \brief Fill constructor, initialises container with template-specified rows
 		 *        and columns each taking the value `_val`.
 		 *
 		 * \param _val Value to fill matrix with.
 		 */
-		explicit fixed_matrix(const value_type& _val) : mtx() { fill(_val); }
+		constexpr explicit fixed_matrix(const value_type& _val) : mtx(filled(_val, std::make_index_sequence<_Rows*_Cols>())) {}
+		/**
+		 * \brief Constructs the container from the elements of `_arr` in row-major order.
+		 *
+		 * \param _arr Array of `_Rows*_Cols` elements.
+		 */
+		constexpr explicit fixed_matrix(const std::array<value_type, _Rows*_Cols>& _arr) : mtx(_arr) {}
 		/**
 		 * \brief Converting constructor, intialises container from 2D C-style array.
 		 *
@@ -114,39 +126,30 @@ namespace crsc {
 		 * \brief Copy constructor, constructs the container with the copy of the 
 		 *        contents of `_other`.
 		 *
+		 * The copy and move operations are defaulted, such that `fixed_matrix<Ty, _Rows, _Cols>` is trivially
+		 * copyable whenever `Ty` is - it may then be copied by `std::memcpy`, relocated by `std::vector` as a
+		 * block of bytes and read or written in bulk by `load_fixed_matrices` and `save_fixed_matrices`.
+		 *
 		 * \param _other Another `fixed_matrix` container to be used as initialisation source.
 		 */
-		fixed_matrix(const fixed_matrix& _other) : mtx(_other.mtx) {}
+		constexpr fixed_matrix(const fixed_matrix& _other) = default;
 		/**
 		 * \brief Move constructor, constructs the container with the contents of
 		 *        `_other` using move-semantics.
 		 *
 		 * \param _other rvalue reference to a `fixed_matrix` container to move to this.
 		 */
-		fixed_matrix(fixed_matrix&& _other) : mtx(std::move(_other.mtx)) {}
+		constexpr fixed_matrix(fixed_matrix&& _other) = default;
 		/**
 		 * \brief Constructs the container with the contents of the nested initializer list `_init_list`.
 		 *
-		 * \warning Undefined behaviour if sizes of each `std::initializer_list` within `_init_list` are not equivalent.
 		 * \param _init_list Initializer list of initializer lists representing a matrix.
 		 * \complexity Linear in size of `_Rows*_Cols`.
-		 * \throw Throws `std::invalid_argument` exception if `_init_list.size() != _Rows` or if
-		 *        `_init_list.begin()->size() != _Cols`.
+		 * \throw Throws `std::invalid_argument` exception if `_init_list.size() != _Rows` or if the
+		 *        `size()` of any of the rows of `_init_list` is not `_Cols`.
 		 */
-		fixed_matrix(std::initializer_list<std::initializer_list<value_type>> _init_list) {
-			if (_init_list.size() != _Rows || _init_list.begin()->size() != _Cols)
-				throw std::invalid_argument("_init_list dimensions not consistent with fixed_matrix dimensions.");
-			auto it = mtx.begin();
-			for (const auto& el : _init_list) {
-				std::copy(el.begin(), el.end(), it);
-				std::advance(it, _Cols);
-			}
-		}
-		/**
-		 * \brief Destructs the container. The destructors of the elements are called and used
-		 *        storage is deallocated.
-		 */
-		~fixed_matrix() {}
+		constexpr fixed_matrix(std::initializer_list<std::initializer_list<value_type>> _init_list)
+			: mtx(nested(checked(_init_list), std::make_index_sequence<_Rows*_Cols>())) {}
 		/**
 		 * \brief Copy-assignment operator. Replaces the contents of the container with
 		 *        a copy of the contents of `_other`.
@@ -154,11 +157,7 @@ namespace crsc {
 		 * \param _other Another `fixed_matrix` container to be used as data source.
 		 * \return `*this`.
 		 */
-		fixed_matrix& operator=(const fixed_matrix& _other) {
-			if (this != &_other)
-				fixed_matrix(_other).swap(*this);
-			return *this;
-		}
+		fixed_matrix& operator=(const fixed_matrix& _other) = default;
 		/**
 		 * \brief Move-assignment operator. Replaces the contents of the container with
 		 *        the contents of `_other` using move-semantics.
@@ -166,11 +165,7 @@ namespace crsc {
 		 * \param _other rvalue reference to a `fixed_matrix` container to move to this.
 		 * \return `*this`.
 		 */
-		fixed_matrix& operator=(fixed_matrix&& _other) {
-			if (this != &_other)
-				swap(*this, _other);
-			return *this;
-		}
+		fixed_matrix& operator=(fixed_matrix&& _other) = default;
 		// CAPACITY
 		/**
 		 * \brief Checks if the container has no elements.
@@ -258,8 +253,8 @@ namespace crsc {
 		 * \complexity Constant.
 		 * \exceptionsafety No-throw guarantee if `_row_index < rows()`, otherwise undefined behaviour.
 		 */
-		constexpr proxy_row_array operator[](size_type _row_index) const {
-			return proxy_row_array(mtx, _row_index, _Cols);
+		constexpr proxy_row_array<const std::array<value_type, _Rows*_Cols>> operator[](size_type _row_index) const {
+			return proxy_row_array<const std::array<value_type, _Rows*_Cols>>(mtx, _row_index, _Cols);
 		}
 		/**
 		 * \brief Gets a proxy object representing the row vector of the matrix at a given `_row_index`
@@ -271,8 +266,8 @@ namespace crsc {
 		 * \complexity Constant.
 		 * \exceptionsafety No-throw guarantee if `_row_index < rows()`, otherwise undefined behaviour.
 		 */
-		proxy_row_array operator[](size_type _row_index) {
-			return proxy_row_array(mtx, _row_index, _Cols);
+		proxy_row_array<std::array<value_type, _Rows*_Cols>> operator[](size_type _row_index) {
+			return proxy_row_array<std::array<value_type, _Rows*_Cols>>(mtx, _row_index, _Cols);
 		}
 		/**
 		 * \brief Gets `const_reference` to element at specified row-column indices.
@@ -499,21 +494,8 @@ namespace crsc {
 		 *             copy constructor (subject to RVO).
 		 * \exceptionsafety No-throw guarantee, `noexcept` specification.
 		 */
-		fixed_matrix<value_type, _Rows - 1, _Cols - 1> submatrix(size_type _row_index, size_type _col_index) const noexcept {
-			fixed_matrix<value_type, _Rows - 1, _Cols - 1> sub;
-			size_type row_erased = 0;
-			size_type col_erased = 0;
-			for (size_type i = 0; i < _Rows - 1; ++i) {
-				col_erased = 0;
-				for (size_type j = 0; j < _Cols - 1; ++j) {
-					if (i == _row_index)
-						row_erased = 1;
-					if (j == _col_index)
-						col_erased = 1;
-					sub.at(i, j) = at(i + row_erased, j + col_erased);
-				}
-			}
-			return sub;
+		constexpr fixed_matrix<value_type, _Rows - 1, _Cols - 1> submatrix(size_type _row_index, size_type _col_index) const noexcept {
+			return fixed_matrix<value_type, _Rows - 1, _Cols - 1>(without(_row_index, _col_index, std::make_index_sequence<(_Rows - 1)*(_Cols - 1)>()));
 		}
 		// OPERATORS
 		/**
@@ -525,9 +507,10 @@ namespace crsc {
 		 *             otherwise linear in `rows()*columns()`.
 		 * \exceptionsafety No-throw guarantee, `noexcept` specification.
 		 */
-		bool operator==(const fixed_matrix& _other) const noexcept {
-			if (this != &_other)
-				return std::equal(mtx.begin(), mtx.end(), _other.mtx.begin());
+		constexpr bool operator==(const fixed_matrix& _other) const noexcept {
+			for (size_type i = 0; i < _Rows*_Cols; ++i) {
+				if (!(mtx[i] == _other.mtx[i])) return false;
+			}
 			return true;
 		}
 		/**
@@ -539,12 +522,46 @@ namespace crsc {
 	 	 *             otherwise linear in `rows()*columns()`.
 		 * \exceptionsafety No-throw guarantee, `noexcept` specification.
 		 */
-		bool operator!=(const fixed_matrix& _other) const noexcept {
+		constexpr bool operator!=(const fixed_matrix& _other) const noexcept {
 			return !(*this == _other);
 		}
 	private:
 		std::array<value_type, _Rows*_Cols> mtx;
+		// the elements are computed by index sequence expansion so that construction is a constant expression
+		template<std::size_t... I>
+		static constexpr std::array<value_type, _Rows*_Cols> filled(const value_type& _val, std::index_sequence<I...>) {
+			return {{ ((void)I, _val)... }};
+		}
+		static constexpr const std::initializer_list<std::initializer_list<value_type>>& checked(
+			const std::initializer_list<std::initializer_list<value_type>>& _init_list) {
+			if (_init_list.size() != _Rows)
+				throw std::invalid_argument("_init_list dimensions not consistent with fixed_matrix dimensions.");
+			for (const auto& row : _init_list) {
+				if (row.size() != _Cols)
+					throw std::invalid_argument("_init_list dimensions not consistent with fixed_matrix dimensions.");
+			}
+			return _init_list;
+		}
+		template<std::size_t... I>
+		static constexpr std::array<value_type, _Rows*_Cols> nested(const std::initializer_list<std::initializer_list<value_type>>& _init_list,
+			std::index_sequence<I...>) {
+			return {{ _init_list.begin()[I / _Cols].begin()[I % _Cols]... }};
+		}
+		template<std::size_t... I>
+		constexpr std::array<value_type, sizeof...(I)> without(size_type _row_index, size_type _col_index, std::index_sequence<I...>) const noexcept {
+			return {{ mtx[(I / (_Cols - 1) + (I / (_Cols - 1) >= _row_index))*_Cols + I % (_Cols - 1) + (I % (_Cols - 1) >= _col_index)]... }};
+		}
 	};
+	// fixed_matrix of arithmetic elements must remain trivially copyable and standard-layout, the bulk binary
+	// I/O of matrix_io.h and the structure-of-arrays conversions of fixed_matrix_batch depend upon it
+	static_assert(std::is_trivially_copyable<fixed_matrix<float, 4, 4>>::value
+		&& std::is_trivially_copyable<fixed_matrix<double, 3, 2>>::value
+		&& std::is_trivially_copyable<fixed_matrix<int, 1, 1>>::value, "fixed_matrix must be trivially copyable.");
+	static_assert(std::is_standard_layout<fixed_matrix<float, 4, 4>>::value
+		&& std::is_standard_layout<fixed_matrix<double, 3, 2>>::value
+		&& std::is_standard_layout<fixed_matrix<int, 1, 1>>::value, "fixed_matrix must be standard-layout.");
+	static_assert(sizeof(fixed_matrix<float, 4, 4>) == 16U*sizeof(float) && sizeof(fixed_matrix<double, 3, 2>) == 6U*sizeof(double),
+		"fixed_matrix must hold its elements with no padding.");
 	template<typename Ty,
 		std::size_t _Rows,
 		std::size_t _Cols,
@@ -559,6 +576,475 @@ namespace crsc {
 		}
 		return os;
 	}
+	/**
+	 * \brief Detail namespace for implementation of the `fixed_matrix` algorithms.
+	 *
+	 * The dimensions of a `fixed_matrix` are template constants, so the algorithms on small matrices are expanded
+	 * over index sequences into straight-line code. For `float` and `double` the elements of sums and differences,
+	 * the rows of products and the rows of square transposes one register wide are computed with the vector
+	 * wrappers of the instruction sets the build targets (`CRSC_SIMD_BASELINE_SSE2`, `CRSC_SIMD_BASELINE_AVX2`)
+	 * rather than those detected at run-time, as a dispatch would cost more than a 4x4 product itself.
+	 *
+	 * The algorithms are also `constexpr`. Elements of a `std::array` cannot be assigned within a C++14 constant
+	 * expression, so during constant evaluation (`CRSC_IS_CONSTANT_EVALUATED`) each result is instead built by
+	 * expanding the index sequence of its elements into the `std::array` constructor of `fixed_matrix`.
+	 */
+	namespace fixed_matrix_impl {
+		// largest number of elements, or multiply-adds for a product, unrolled - larger matrices use crsc::kernels
+		constexpr std::size_t unroll_limit = 256U;
+		template<class F, std::size_t... I>
+		void unroll(F&& _f, std::index_sequence<I...>) {
+			const int expand[] = { 0, (_f(std::integral_constant<std::size_t, I>()), 0)... };
+			(void)expand;
+		}
+		// invokes _f(std::integral_constant<std::size_t, I>()) for each I in [0, N) in order
+		template<std::size_t N, class F>
+		void unroll(F&& _f) { unroll(_f, std::make_index_sequence<N>()); }
+		struct plus {
+			template<typename Ty>
+			constexpr Ty operator()(const Ty& _a, const Ty& _b) const { return _a + _b; }
+			template<class V>
+			static typename V::reg apply(typename V::reg _a, typename V::reg _b) { return V::add(_a, _b); }
+			template<typename Ty>
+			static void kernel(const Ty* _a, const Ty* _b, Ty* _out, std::size_t _n) { kernels::add(_a, _b, _out, _n); }
+		};
+		struct minus {
+			template<typename Ty>
+			constexpr Ty operator()(const Ty& _a, const Ty& _b) const { return _a - _b; }
+			template<class V>
+			static typename V::reg apply(typename V::reg _a, typename V::reg _b) { return V::sub(_a, _b); }
+			template<typename Ty>
+			static void kernel(const Ty* _a, const Ty* _b, Ty* _out, std::size_t _n) { kernels::subtract(_a, _b, _out, _n); }
+		};
+		// vector wrapper for rows of N elements of type Ty - the narrowest enabled wrapper holding all N, otherwise
+		// the widest - or void if there is none
+		template<typename Ty, std::size_t N, class = void>
+		struct vec_for { typedef void type; };
+#if defined(CRSC_SIMD_BASELINE_SSE2)
+		template<typename Ty, std::size_t N>
+		struct vec_for<Ty, N, std::enable_if_t<(std::is_same<Ty, float>::value || std::is_same<Ty, double>::value) && (N > 1U)>> {
+#if defined(CRSC_SIMD_BASELINE_AVX2)
+			typedef std::conditional_t<(N > simd::sse2_vec<Ty>::width), simd::avx2_vec<Ty>, simd::sse2_vec<Ty>> type;
+#else
+			typedef simd::sse2_vec<Ty> type;
+#endif
+		};
+#endif
+		struct loop_tag {};
+		struct scalar_tag {};
+		template<class V> struct simd_tag {};
+		// strategy for an operation of _Ops scalar operations on rows of _Lanes elements
+		template<typename Ty, std::size_t _Ops, std::size_t _Lanes, class V = typename vec_for<Ty, _Lanes>::type>
+		using strategy = std::conditional_t<(_Ops > unroll_limit), loop_tag,
+			std::conditional_t<std::is_void<V>::value, scalar_tag, simd_tag<V>>>;
+		// number of the lanes of register _q used by a row of _n elements split into registers of _w lanes
+		constexpr std::size_t lanes(std::size_t _n, std::size_t _w, std::size_t _q) { return _n - _q*_w < _w ? _n - _q*_w : _w; }
+		template<class V, std::size_t L>
+		typename V::reg load_lanes(const typename V::value_type* _p, std::true_type) { return V::load(_p); }
+		template<class V, std::size_t L>
+		typename V::reg load_lanes(const typename V::value_type* _p, std::false_type) {
+			typename V::value_type tmp[V::width] = {};
+			std::copy(_p, _p + L, tmp);
+			return V::load(tmp);
+		}
+		// loads L elements from _p into the low lanes of a register, reading past _p + L only if _Full
+		template<class V, std::size_t L, bool _Full>
+		typename V::reg load_lanes(const typename V::value_type* _p) {
+			return load_lanes<V, L>(_p, std::integral_constant<bool, L == V::width || _Full>());
+		}
+		template<class V, std::size_t L>
+		void store_lanes(typename V::value_type* _p, typename V::reg _v, std::true_type) { V::store(_p, _v); }
+		template<class V, std::size_t L>
+		void store_lanes(typename V::value_type* _p, typename V::reg _v, std::false_type) {
+			typename V::value_type tmp[V::width];
+			V::store(tmp, _v);
+			std::copy(tmp, tmp + L, _p);
+		}
+		// stores the low L lanes of _v to _p, writing past _p + L only if _Full
+		template<class V, std::size_t L, bool _Full>
+		void store_lanes(typename V::value_type* _p, typename V::reg _v) {
+			store_lanes<V, L>(_p, _v, std::integral_constant<bool, L == V::width || _Full>());
+		}
+		// _out[k] = _a[k] op _b[k] for k in [0, N)
+		template<class Op, std::size_t N, typename Ty>
+		void elementwise(const Ty* _a, const Ty* _b, Ty* _out, loop_tag) { Op::kernel(_a, _b, _out, N); }
+		template<class Op, std::size_t N, typename Ty>
+		void elementwise(const Ty* _a, const Ty* _b, Ty* _out, scalar_tag) {
+			unroll<N>([&](auto k) { _out[k] = Op()(_a[k], _b[k]); });
+		}
+		template<class Op, std::size_t N, typename Ty, class V>
+		void elementwise(const Ty* _a, const Ty* _b, Ty* _out, simd_tag<V>) {
+			unroll<N / V::width>([&](auto q) {
+				V::store(_out + q*V::width, Op::template apply<V>(V::load(_a + q*V::width), V::load(_b + q*V::width)));
+			});
+			unroll<N % V::width>([&](auto k) {
+				_out[N / V::width*V::width + k] = Op()(_a[N / V::width*V::width + k], _b[N / V::width*V::width + k]);
+			});
+		}
+		// _c = _a*_b for _a of M x K and _b of K x N, each element of _c accumulated in increasing order of k
+		template<std::size_t M, std::size_t K, std::size_t N, typename Ty>
+		void product(const Ty* _a, const Ty* _b, Ty* _c, loop_tag) {
+			kernels::gemm(M, N, K, _a, K, 1, _b, N, 1, _c, N, 1);
+		}
+		template<std::size_t M, std::size_t K, std::size_t N, typename Ty>
+		void product(const Ty* _a, const Ty* _b, Ty* _c, scalar_tag) {
+			unroll<M*N>([&](auto ij) {
+				const std::size_t i = ij / N, j = ij % N;
+				Ty dot = _a[i*K] * _b[j];
+				unroll<K - 1>([&](auto p) { dot += _a[i*K + p + 1] * _b[(p + 1)*N + j]; });
+				_c[ij] = dot;
+			});
+		}
+		// each row of _c is the sum over k of the broadcast _a(i,k) times row k of _b, with the K rows of _b held
+		// in registers throughout. Rows narrower than a register are loaded and stored whole wherever that stays
+		// within the matrix - the surplus lanes are ignored, or overwritten when the following row is stored.
+		template<std::size_t M, std::size_t K, std::size_t N, typename Ty, class V>
+		void product(const Ty* _a, const Ty* _b, Ty* _c, simd_tag<V>) {
+			constexpr std::size_t regs = (N + V::width - 1U) / V::width;
+			typename V::reg rows[K][regs];
+			unroll<K*regs>([&](auto kq) {
+				constexpr std::size_t k = decltype(kq)::value / regs, q = decltype(kq)::value % regs;
+				constexpr std::size_t offset = k*N + q*V::width;
+				rows[k][q] = load_lanes<V, lanes(N, V::width, q), (offset + V::width <= K*N)>(_b + offset);
+			});
+			unroll<M*regs>([&](auto iq) {
+				constexpr std::size_t i = decltype(iq)::value / regs, q = decltype(iq)::value % regs;
+				constexpr std::size_t offset = i*N + q*V::width;
+				typename V::reg acc = V::mul(V::set1(_a[i*K]), rows[0][q]);
+				unroll<K - 1>([&](auto p) { acc = V::add(acc, V::mul(V::set1(_a[i*K + p + 1]), rows[p + 1][q])); });
+				store_lanes<V, lanes(N, V::width, q), (offset + V::width <= M*N)>(_c + offset, acc);
+			});
+		}
+		template<class V> struct width_of : std::integral_constant<std::size_t, V::width> {};
+		template<> struct width_of<void> : std::integral_constant<std::size_t, 0U> {};
+		// strategy for a transpose, square matrices whose rows fill one register are transposed in registers
+		template<typename Ty, std::size_t R, std::size_t C, class V = typename vec_for<Ty, C>::type>
+		using transpose_strategy = std::conditional_t<(R*C > unroll_limit), loop_tag,
+			std::conditional_t<R == C && width_of<V>::value == C, simd_tag<V>, scalar_tag>>;
+		template<std::size_t R, std::size_t C, typename Ty>
+		void transpose(const Ty* _src, Ty* _dst, loop_tag) { kernels::transpose(R, C, _src, C, _dst, R); }
+		template<std::size_t R, std::size_t C, typename Ty>
+		void transpose(const Ty* _src, Ty* _dst, scalar_tag) {
+			unroll<R*C>([&](auto k) { _dst[k % C * R + k / C] = _src[k]; });
+		}
+		template<std::size_t R, std::size_t C, typename Ty, class V>
+		void transpose(const Ty* _src, Ty* _dst, simd_tag<V>) {
+			typename V::reg rows[R];
+			unroll<R>([&](auto i) { rows[i] = V::load(_src + i*C); });
+			V::transpose(rows);
+			unroll<R>([&](auto i) { V::store(_dst + i*R, rows[i]); });
+		}
+		template<std::size_t N, typename Ty>
+		Ty trace(const Ty* _a, loop_tag) {
+			Ty tr = Ty();
+			for (std::size_t i = 0; i < N; ++i) tr += _a[i*(N + 1)];
+			return tr;
+		}
+		template<std::size_t N, typename Ty>
+		Ty trace(const Ty* _a, scalar_tag) {
+			Ty tr = _a[0];
+			unroll<N - 1>([&](auto i) { tr += _a[(i + 1)*(N + 1)]; });
+			return tr;
+		}
+		// constant expression forms of the algorithms, each element of the result given by an expansion over the
+		// index sequence of the result's elements
+		template<typename Ty, std::size_t N, std::size_t... I>
+		constexpr fixed_matrix<Ty, N, N> constant_identity(std::index_sequence<I...>) {
+			return fixed_matrix<Ty, N, N>(std::array<Ty, N*N>{{ static_cast<Ty>(I / N == I % N ? 1 : 0)... }});
+		}
+		template<class Op, typename Ty, std::size_t R, std::size_t C, std::size_t... I>
+		constexpr fixed_matrix<Ty, R, C> constant_elementwise(const fixed_matrix<Ty, R, C>& _a, const fixed_matrix<Ty, R, C>& _b,
+			std::index_sequence<I...>) {
+			return fixed_matrix<Ty, R, C>(std::array<Ty, R*C>{{ Op()(_a(I / C, I % C), _b(I / C, I % C))... }});
+		}
+		template<typename Ty, std::size_t M, std::size_t K, std::size_t N>
+		constexpr Ty constant_dot(const fixed_matrix<Ty, M, K>& _a, const fixed_matrix<Ty, K, N>& _b, std::size_t _i, std::size_t _j) {
+			Ty dot = _a(_i, 0) * _b(0, _j);
+			for (std::size_t p = 1; p < K; ++p) dot += _a(_i, p) * _b(p, _j);
+			return dot;
+		}
+		template<typename Ty, std::size_t M, std::size_t K, std::size_t N, std::size_t... I>
+		constexpr fixed_matrix<Ty, M, N> constant_product(const fixed_matrix<Ty, M, K>& _a, const fixed_matrix<Ty, K, N>& _b,
+			std::index_sequence<I...>) {
+			return fixed_matrix<Ty, M, N>(std::array<Ty, M*N>{{ (K ? constant_dot(_a, _b, I / N, I % N) : Ty())... }});
+		}
+		template<typename Ty, std::size_t R, std::size_t C, std::size_t... I>
+		constexpr fixed_matrix<Ty, C, R> constant_transpose(const fixed_matrix<Ty, R, C>& _a, std::index_sequence<I...>) {
+			return fixed_matrix<Ty, C, R>(std::array<Ty, R*C>{{ _a(I % R, I / R)... }});
+		}
+		template<typename Ty, std::size_t R, std::size_t C, std::size_t... I>
+		constexpr std::array<Ty, R> constant_gemv(const fixed_matrix<Ty, R, C>& _a, const std::array<Ty, C>& _x, std::index_sequence<I...>) {
+			return {{ (C ? constant_dot(_a, fixed_matrix<Ty, C, 1>(_x), I, 0U) : Ty())... }};
+		}
+		template<typename Ty, std::size_t N>
+		constexpr Ty constant_trace(const fixed_matrix<Ty, N, N>& _a) {
+			Ty tr = Ty();
+			for (std::size_t i = 0; i < N; ++i) tr += _a(i, i);
+			return tr;
+		}
+		// run-time forms of the algorithms, using the unrolled and vector kernels above
+		template<class Op, typename Ty, std::size_t R, std::size_t C>
+		fixed_matrix<Ty, R, C> runtime_elementwise(const fixed_matrix<Ty, R, C>& _a, const fixed_matrix<Ty, R, C>& _b) {
+			fixed_matrix<Ty, R, C> out;
+			elementwise<Op, R*C>(_a.data(), _b.data(), out.data(), strategy<Ty, R*C, R*C>());
+			return out;
+		}
+		template<typename Ty, std::size_t M, std::size_t K, std::size_t N>
+		fixed_matrix<Ty, M, N> runtime_product(const fixed_matrix<Ty, M, K>& _a, const fixed_matrix<Ty, K, N>& _b) {
+			fixed_matrix<Ty, M, N> out;
+			product<M, K, N>(_a.data(), _b.data(), out.data(), std::conditional_t<K == 0U, loop_tag, strategy<Ty, M*N*K, N>>());
+			return out;
+		}
+		template<typename Ty, std::size_t R, std::size_t C>
+		fixed_matrix<Ty, C, R> runtime_transpose(const fixed_matrix<Ty, R, C>& _a) {
+			fixed_matrix<Ty, C, R> out;
+			transpose<R, C>(_a.data(), out.data(), transpose_strategy<Ty, R, C>());
+			return out;
+		}
+		template<typename Ty, std::size_t R, std::size_t C>
+		std::array<Ty, R> runtime_gemv(const fixed_matrix<Ty, R, C>& _a, const std::array<Ty, C>& _x) {
+			std::array<Ty, R> y{};
+			kernels::gemv(R, C, _a.data(), C, 1, _x.data(), y.data());
+			return y;
+		}
+		template<typename Ty, std::size_t N>
+		Ty runtime_trace(const fixed_matrix<Ty, N, N>& _a) {
+			return trace<N>(_a.data(), std::conditional_t<(N == 0U || N > unroll_limit), loop_tag, scalar_tag>());
+		}
+		template<typename Ty, std::size_t N, std::size_t... I>
+		constexpr std::array<Ty, N> to_array(const Ty (&_arr)[N], std::index_sequence<I...>) {
+			return {{ _arr[I]... }};
+		}
+		// closed-form determinants and inverses by cofactors up to 4x4, the 4x4 case via the 2x2 minors of its
+		// upper and lower pairs of rows, these being straight-line code aside from the test for singularity -
+		// larger matrices are factorized by fixed_lu_decomposition
+		template<typename Ty, std::size_t N>
+		constexpr Ty determinant(const fixed_matrix<Ty, N, N>& _a) { return fixed_lu_decomposition<Ty, N>(_a).determinant(); }
+		template<typename Ty>
+		constexpr Ty determinant(const fixed_matrix<Ty, 1, 1>& _a) { return _a(0, 0); }
+		template<typename Ty>
+		constexpr Ty determinant(const fixed_matrix<Ty, 2, 2>& _a) { return _a(0, 0)*_a(1, 1) - _a(0, 1)*_a(1, 0); }
+		template<typename Ty>
+		constexpr Ty determinant(const fixed_matrix<Ty, 3, 3>& _a) {
+			return _a(0, 0)*(_a(1, 1)*_a(2, 2) - _a(1, 2)*_a(2, 1))
+				- _a(0, 1)*(_a(1, 0)*_a(2, 2) - _a(1, 2)*_a(2, 0))
+				+ _a(0, 2)*(_a(1, 0)*_a(2, 1) - _a(1, 1)*_a(2, 0));
+		}
+		template<typename Ty>
+		struct minors_4x4 {
+			Ty s0, s1, s2, s3, s4, s5;
+			Ty c0, c1, c2, c3, c4, c5;
+			constexpr explicit minors_4x4(const fixed_matrix<Ty, 4, 4>& _a)
+				: s0(_a(0, 0)*_a(1, 1) - _a(1, 0)*_a(0, 1)), s1(_a(0, 0)*_a(1, 2) - _a(1, 0)*_a(0, 2)),
+				s2(_a(0, 0)*_a(1, 3) - _a(1, 0)*_a(0, 3)), s3(_a(0, 1)*_a(1, 2) - _a(1, 1)*_a(0, 2)),
+				s4(_a(0, 1)*_a(1, 3) - _a(1, 1)*_a(0, 3)), s5(_a(0, 2)*_a(1, 3) - _a(1, 2)*_a(0, 3)),
+				c0(_a(2, 0)*_a(3, 1) - _a(3, 0)*_a(2, 1)), c1(_a(2, 0)*_a(3, 2) - _a(3, 0)*_a(2, 2)),
+				c2(_a(2, 0)*_a(3, 3) - _a(3, 0)*_a(2, 3)), c3(_a(2, 1)*_a(3, 2) - _a(3, 1)*_a(2, 2)),
+				c4(_a(2, 1)*_a(3, 3) - _a(3, 1)*_a(2, 3)), c5(_a(2, 2)*_a(3, 3) - _a(3, 2)*_a(2, 3)) {}
+			constexpr Ty determinant() const { return s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0; }
+		};
+		template<typename Ty>
+		constexpr Ty determinant(const fixed_matrix<Ty, 4, 4>& _a) { return minors_4x4<Ty>(_a).determinant(); }
+		template<typename Ty>
+		constexpr Ty checked_reciprocal(const Ty& _det) {
+			if (_det == Ty()) throw std::domain_error("matrix_inverse of a singular fixed_matrix.");
+			return static_cast<Ty>(1) / _det;
+		}
+		template<typename Ty, std::size_t N>
+		constexpr fixed_matrix<Ty, N, N> inverse(const fixed_matrix<Ty, N, N>& _a) { return fixed_lu_decomposition<Ty, N>(_a).inverse(); }
+		template<typename Ty>
+		constexpr fixed_matrix<Ty, 1, 1> inverse(const fixed_matrix<Ty, 1, 1>& _a) {
+			return fixed_matrix<Ty, 1, 1>(checked_reciprocal(_a(0, 0)));
+		}
+		template<typename Ty>
+		constexpr fixed_matrix<Ty, 2, 2> inverse(const fixed_matrix<Ty, 2, 2>& _a) {
+			const Ty r = checked_reciprocal(determinant(_a));
+			return fixed_matrix<Ty, 2, 2>(std::array<Ty, 4>{{ _a(1, 1)*r, -_a(0, 1)*r, -_a(1, 0)*r, _a(0, 0)*r }});
+		}
+		template<typename Ty>
+		constexpr fixed_matrix<Ty, 3, 3> inverse(const fixed_matrix<Ty, 3, 3>& _a) {
+			const Ty r = checked_reciprocal(determinant(_a));
+			return fixed_matrix<Ty, 3, 3>(std::array<Ty, 9>{{
+				(_a(1, 1)*_a(2, 2) - _a(1, 2)*_a(2, 1))*r, (_a(0, 2)*_a(2, 1) - _a(0, 1)*_a(2, 2))*r, (_a(0, 1)*_a(1, 2) - _a(0, 2)*_a(1, 1))*r,
+				(_a(1, 2)*_a(2, 0) - _a(1, 0)*_a(2, 2))*r, (_a(0, 0)*_a(2, 2) - _a(0, 2)*_a(2, 0))*r, (_a(0, 2)*_a(1, 0) - _a(0, 0)*_a(1, 2))*r,
+				(_a(1, 0)*_a(2, 1) - _a(1, 1)*_a(2, 0))*r, (_a(0, 1)*_a(2, 0) - _a(0, 0)*_a(2, 1))*r, (_a(0, 0)*_a(1, 1) - _a(0, 1)*_a(1, 0))*r
+			}});
+		}
+		template<typename Ty>
+		constexpr fixed_matrix<Ty, 4, 4> inverse(const fixed_matrix<Ty, 4, 4>& _a) {
+			const minors_4x4<Ty> m(_a);
+			const Ty r = checked_reciprocal(m.determinant());
+			return fixed_matrix<Ty, 4, 4>(std::array<Ty, 16>{{
+				(_a(1, 1)*m.c5 - _a(1, 2)*m.c4 + _a(1, 3)*m.c3)*r, (-_a(0, 1)*m.c5 + _a(0, 2)*m.c4 - _a(0, 3)*m.c3)*r,
+				(_a(3, 1)*m.s5 - _a(3, 2)*m.s4 + _a(3, 3)*m.s3)*r, (-_a(2, 1)*m.s5 + _a(2, 2)*m.s4 - _a(2, 3)*m.s3)*r,
+				(-_a(1, 0)*m.c5 + _a(1, 2)*m.c2 - _a(1, 3)*m.c1)*r, (_a(0, 0)*m.c5 - _a(0, 2)*m.c2 + _a(0, 3)*m.c1)*r,
+				(-_a(3, 0)*m.s5 + _a(3, 2)*m.s2 - _a(3, 3)*m.s1)*r, (_a(2, 0)*m.s5 - _a(2, 2)*m.s2 + _a(2, 3)*m.s1)*r,
+				(_a(1, 0)*m.c4 - _a(1, 1)*m.c2 + _a(1, 3)*m.c0)*r, (-_a(0, 0)*m.c4 + _a(0, 1)*m.c2 - _a(0, 3)*m.c0)*r,
+				(_a(3, 0)*m.s4 - _a(3, 1)*m.s2 + _a(3, 3)*m.s0)*r, (-_a(2, 0)*m.s4 + _a(2, 1)*m.s2 - _a(2, 3)*m.s0)*r,
+				(-_a(1, 0)*m.c3 + _a(1, 1)*m.c1 - _a(1, 2)*m.c0)*r, (_a(0, 0)*m.c3 - _a(0, 1)*m.c1 + _a(0, 2)*m.c0)*r,
+				(-_a(3, 0)*m.s3 + _a(3, 1)*m.s1 - _a(3, 2)*m.s0)*r, (_a(2, 0)*m.s3 - _a(2, 1)*m.s1 + _a(2, 2)*m.s0)*r
+			}});
+		}
+	}
+	/**
+	 * \class fixed_lu_decomposition
+	 *
+	 * \brief Factorization `P*A = L*U` of a square `fixed_matrix` `A` with partial (row) pivoting, where `L` is unit
+	 *        lower triangular, `U` is upper triangular and `P` is a permutation.
+	 *
+	 * The fixed-size counterpart of `crsc::lu_decomposition`: the factors are held inline, so neither the
+	 * factorization nor any solve allocates, and the loops have compile-time trip counts for the compiler to
+	 * unroll and vectorize. The factors are C-style arrays rather than `std::array`s as only the former may be
+	 * modified within a C++14 constant expression, so a `fixed_lu_decomposition` may itself be `constexpr`.
+	 *
+	 * \tparam Ty Type of the elements, must be a floating point type.
+	 * \tparam N Order of the factorized matrix.
+	 */
+	template<typename Ty,
+		std::size_t N
+	> class fixed_lu_decomposition {
+		static_assert(std::is_floating_point<Ty>::value, "fixed_lu_decomposition requires a floating point element type.");
+		static_assert(N > 0U, "fixed_lu_decomposition requires a non-empty matrix.");
+	public:
+		typedef Ty value_type;
+		typedef std::size_t size_type;
+		typedef fixed_matrix<Ty, N, N> matrix_type;
+		/**
+		 * \brief Factorizes the square matrix `a`.
+		 *
+		 * \param a Matrix to factorize.
+		 * \complexity Cubic in `N`.
+		 */
+		constexpr explicit fixed_lu_decomposition(const matrix_type& a) : lu_{}, pivots_{}, sign_(1), singular_(false) {
+			for (size_type k = 0; k < N*N; ++k) lu_[k] = a(k / N, k % N);
+			for (size_type k = 0; k < N; ++k) {
+				size_type p = k;
+				for (size_type i = k + 1; i < N; ++i) {
+					if (magnitude(lu_[i*N + k]) > magnitude(lu_[p*N + k])) p = i;
+				}
+				pivots_[k] = p;
+				if (p != k) {
+					for (size_type j = 0; j < N; ++j) {
+						const Ty tmp = lu_[k*N + j];
+						lu_[k*N + j] = lu_[p*N + j];
+						lu_[p*N + j] = tmp;
+					}
+					sign_ = -sign_;
+				}
+				if (lu_[k*N + k] == Ty(0)) {
+					singular_ = true;
+					continue;
+				}
+				const Ty inv_pivot = Ty(1) / lu_[k*N + k];
+				for (size_type i = k + 1; i < N; ++i) {
+					lu_[i*N + k] *= inv_pivot;
+					for (size_type j = k + 1; j < N; ++j) lu_[i*N + j] -= lu_[i*N + k] * lu_[k*N + j];
+				}
+			}
+		}
+		/**
+		 * \brief Returns the order of the factorized matrix.
+		 */
+		constexpr size_type size() const noexcept { return N; }
+		/**
+		 * \brief Returns `true` if a pivot of the factorization is exactly zero, i.e. if the factorized matrix is
+		 *        singular, in which case `solve` and `inverse` throw.
+		 */
+		constexpr bool is_singular() const noexcept { return singular_; }
+		/**
+		 * \brief Returns the factors `L` and `U` packed into a single matrix, `U` occupying the upper triangle and
+		 *        the diagonal and `L` (without its unit diagonal) the strict lower triangle.
+		 */
+		constexpr matrix_type packed_factors() const noexcept {
+			return matrix_type(fixed_matrix_impl::to_array(lu_, std::make_index_sequence<N*N>()));
+		}
+		/**
+		 * \brief Returns the row interchanges of the factorization, row `i` having been swapped with row
+		 *        `pivots()[i]` at step `i`.
+		 */
+		constexpr std::array<size_type, N> pivots() const noexcept {
+			return fixed_matrix_impl::to_array(pivots_, std::make_index_sequence<N>());
+		}
+		/**
+		 * \brief Computes the determinant of the factorized matrix.
+		 *
+		 * \complexity Linear in `N`.
+		 */
+		constexpr value_type determinant() const noexcept {
+			value_type det = static_cast<value_type>(sign_);
+			for (size_type i = 0; i < N; ++i) det *= lu_[i*N + i];
+			return det;
+		}
+		/**
+		 * \brief Solves `A*x = b` for the single right-hand side `b`.
+		 *
+		 * \throw Throws `std::domain_error` exception if the factorized matrix is singular.
+		 * \complexity Quadratic in `N`.
+		 */
+		constexpr std::array<value_type, N> solve(const std::array<value_type, N>& b) const {
+			Ty x[N] = {};
+			for (size_type i = 0; i < N; ++i) x[i] = b[i];
+			solve_in_place(x, 1U);
+			return fixed_matrix_impl::to_array(x, std::make_index_sequence<N>());
+		}
+		/**
+		 * \brief Solves `A*X = B` for `X`.
+		 *
+		 * \param b Right-hand sides, one per column.
+		 * \return Solution `X` with the dimensions of `b`.
+		 * \throw Throws `std::domain_error` exception if the factorized matrix is singular.
+		 * \complexity Quadratic in `N` multiplied by linear in `M`.
+		 */
+		template<std::size_t M>
+		constexpr fixed_matrix<value_type, N, M> solve(const fixed_matrix<value_type, N, M>& b) const {
+			Ty x[N*M] = {};
+			for (size_type k = 0; k < N*M; ++k) x[k] = b(k / M, k % M);
+			solve_in_place(x, M);
+			return fixed_matrix<value_type, N, M>(fixed_matrix_impl::to_array(x, std::make_index_sequence<N*M>()));
+		}
+		/**
+		 * \brief Computes the inverse of the factorized matrix by solving for each column of the identity.
+		 *
+		 * \throw Throws `std::domain_error` exception if the factorized matrix is singular.
+		 * \complexity Cubic in `N`.
+		 */
+		constexpr matrix_type inverse() const {
+			Ty x[N*N] = {};
+			for (size_type i = 0; i < N; ++i) x[i*N + i] = Ty(1);
+			solve_in_place(x, N);
+			return matrix_type(fixed_matrix_impl::to_array(x, std::make_index_sequence<N*N>()));
+		}
+	private:
+		Ty lu_[N*N];
+		size_type pivots_[N];
+		int sign_;
+		bool singular_;
+		static constexpr Ty magnitude(const Ty& _val) noexcept { return _val < Ty(0) ? -_val : _val; }
+		// solves in place for the nrhs columns of the row-major N x nrhs array x
+		constexpr void solve_in_place(Ty* x, size_type nrhs) const {
+			if (singular_) throw std::domain_error("fixed_lu_decomposition of a singular matrix cannot be solved.");
+			for (size_type k = 0; k < N; ++k) {
+				if (pivots_[k] == k) continue;
+				for (size_type c = 0; c < nrhs; ++c) {
+					const Ty tmp = x[k*nrhs + c];
+					x[k*nrhs + c] = x[pivots_[k]*nrhs + c];
+					x[pivots_[k]*nrhs + c] = tmp;
+				}
+			}
+			for (size_type i = 1; i < N; ++i) {
+				for (size_type p = 0; p < i; ++p) {
+					for (size_type c = 0; c < nrhs; ++c) x[i*nrhs + c] -= lu_[i*N + p] * x[p*nrhs + c];
+				}
+			}
+			for (size_type i = N; i-- > 0;) {
+				for (size_type p = i + 1; p < N; ++p) {
+					for (size_type c = 0; c < nrhs; ++c) x[i*nrhs + c] -= lu_[i*N + p] * x[p*nrhs + c];
+				}
+				const Ty inv_pivot = Ty(1) / lu_[i*N + i];
+				for (size_type c = 0; c < nrhs; ++c) x[i*nrhs + c] *= inv_pivot;
+			}
+		}
+	};
 	/**
 	 * \brief Makes an identity `fixed_matrix` of template-specified size.
 	 * 
@@ -575,13 +1061,8 @@ namespace crsc {
 		std::size_t _cols,
 		class = std::enable_if_t<_rows == _cols
 			&& std::is_arithmetic<Ty>::value>
-	> fixed_matrix<Ty, _rows, _cols> make_identity_matrix() {
-		fixed_matrix<Ty, _rows, _cols> identity_matrix();
-		for (std::size_t i = 0; i < _rows; ++i) {
-			for (std::size_t j = 0; j < _cols; ++j)
-				if (i == j) identity_matrix[i][j] = static_cast<Ty>(1);
-		}
-		return identity_matrix;
+	> constexpr fixed_matrix<Ty, _rows, _cols> make_identity_matrix() {
+		return fixed_matrix_impl::constant_identity<Ty, _rows>(std::make_index_sequence<_rows*_cols>());
 	}
 	/**
 	 * \brief Makes a `fixed_matrix` object from a 2D C-style array.
@@ -611,44 +1092,156 @@ namespace crsc {
 	> fixed_matrix<Ty, _rows, _cols> make_fixed_matrix(Ty** c_arr_2d) {
 		return fixed_matrix<Ty, _rows, _cols>(c_arr_2d);
 	}
+	/**
+	 * \brief Returns a `fixed_matrix` whose elements equal the component-wise addition of `lhs` and `rhs`.
+	 *
+	 * \param lhs First instance of `fixed_matrix`.
+	 * \param rhs Second instance of `fixed_matrix`.
+	 * \return Container consisting of sum of `lhs` and `rhs`.
+	 * \complexity Linear in `Rows*Cols`, unrolled for small matrices and vectorized for `float` and `double`.
+	 */
+	template<typename Ty,
+		std::size_t Rows,
+		std::size_t Cols
+	> constexpr fixed_matrix<Ty, Rows, Cols> matrix_sum(const fixed_matrix<Ty, Rows, Cols>& lhs, const fixed_matrix<Ty, Rows, Cols>& rhs) {
+		return CRSC_IS_CONSTANT_EVALUATED()
+			? fixed_matrix_impl::constant_elementwise<fixed_matrix_impl::plus>(lhs, rhs, std::make_index_sequence<Rows*Cols>())
+			: fixed_matrix_impl::runtime_elementwise<fixed_matrix_impl::plus>(lhs, rhs);
+	}
+	/**
+	 * \brief Returns a `fixed_matrix` whose elements equal the component-wise subtraction of `rhs` from `lhs`.
+	 *
+	 * \param lhs First instance of `fixed_matrix`.
+	 * \param rhs Second instance of `fixed_matrix`.
+	 * \return Container consisting of difference of `lhs` and `rhs`.
+	 * \complexity Linear in `Rows*Cols`, unrolled for small matrices and vectorized for `float` and `double`.
+	 */
 	template<typename Ty,
 		std::size_t Rows,
 		std::size_t Cols
-	> fixed_matrix<Ty, Rows, Cols> matrix_sum(const fixed_matrix<Ty, Rows, Cols>& lhs, const fixed_matrix<Ty, Rows, Cols>& rhs) {
-		fixed_matrix<Ty, Rows, Cols> sum;
-		for (auto itsum = sum.begin(), itlhs = lhs.begin(), itrhs = rhs.begin(); itsum < sum.end(); ++itsum, ++itlhs, ++itrhs)
-			*itsum = *itlhs + *itrhs;
-		return sum;
+	> constexpr fixed_matrix<Ty, Rows, Cols> matrix_difference(const fixed_matrix<Ty, Rows, Cols>& lhs, const fixed_matrix<Ty, Rows, Cols>& rhs) {
+		return CRSC_IS_CONSTANT_EVALUATED()
+			? fixed_matrix_impl::constant_elementwise<fixed_matrix_impl::minus>(lhs, rhs, std::make_index_sequence<Rows*Cols>())
+			: fixed_matrix_impl::runtime_elementwise<fixed_matrix_impl::minus>(lhs, rhs);
 	}
+	/**
+	 * \brief Returns the product of two `fixed_matrix` containers, the dimensions of which are checked at compile-time.
+	 *
+	 * Products of up to `fixed_matrix_impl::unroll_limit` multiply-adds are expanded into straight-line code, each
+	 * row of the result being accumulated in vector registers for `float` and `double`. Larger products are
+	 * computed by `crsc::kernels::gemm`.
+	 *
+	 * \param lhs First instance of `fixed_matrix`, of `M` rows and `K` columns.
+	 * \param rhs Second instance of `fixed_matrix`, of `K` rows and `N` columns.
+	 * \return Container of `M` rows and `N` columns consisting of product of `lhs` and `rhs`.
+	 * \complexity Linear in `M*N*K`.
+	 */
+	template<typename Ty,
+		std::size_t M,
+		std::size_t K,
+		std::size_t N
+	> constexpr fixed_matrix<Ty, M, N> matrix_product(const fixed_matrix<Ty, M, K>& lhs, const fixed_matrix<Ty, K, N>& rhs) {
+		return CRSC_IS_CONSTANT_EVALUATED()
+			? fixed_matrix_impl::constant_product(lhs, rhs, std::make_index_sequence<M*N>())
+			: fixed_matrix_impl::runtime_product(lhs, rhs);
+	}
+	/**
+	 * \brief Returns a `fixed_matrix` which gives the transpose of `fm`. Small matrices are transposed by unrolled
+	 *        code, in registers for square `float` and `double` matrices whose rows fill a register (e.g. 4x4
+	 *        `float`), larger matrices by `crsc::kernels::transpose`.
+	 *
+	 * \param fm Instance of `fixed_matrix`.
+	 * \return Container of `Cols` rows and `Rows` columns consisting of the transpose of `fm`.
+	 * \complexity Linear in `Rows*Cols`.
+	 */
 	template<typename Ty,
 		std::size_t Rows,
 		std::size_t Cols
-	> fixed_matrix<Ty, Rows, Cols> matrix_difference(const fixed_matrix<Ty, Rows, Cols>& lhs, const fixed_matrix<Ty, Rows, Cols>& rhs) {
-		fixed_matrix<Ty, Rows, Cols> difference;
-		for (auto itdiff = difference.begin(), itlhs = lhs.begin(), itrhs = rhs.begin(); itdiff < difference.end(); ++itdiff, ++itlhs, ++itrhs)
-			*itdiff = *itlhs + *itrhs;
-		return difference;
+	> constexpr fixed_matrix<Ty, Cols, Rows> matrix_transpose(const fixed_matrix<Ty, Rows, Cols>& fm) {
+		return CRSC_IS_CONSTANT_EVALUATED()
+			? fixed_matrix_impl::constant_transpose(fm, std::make_index_sequence<Rows*Cols>())
+			: fixed_matrix_impl::runtime_transpose(fm);
 	}
+	/**
+	 * \brief Returns the product `fm*x` of a `fixed_matrix` with a vector, computed by `crsc::kernels::gemv`.
+	 *
+	 * \param fm Instance of `fixed_matrix`.
+	 * \param x Vector of `Cols` elements.
+	 * \return Vector of `Rows` elements.
+	 * \complexity Linear in `Rows*Cols`.
+	 */
 	template<typename Ty,
-		std::size_t LHSRows, std::size_t LHSCols,
-		std::size_t RHSRows, std::size_t RHSCols
-	> fixed_matrix<Ty, LHSRows, RHSCols> matrix_product(const fixed_matrix<Ty, LHSRows, LHSCols>& lhs, const fixed_matrix<Ty, RHSRows, RHSCols>& rhs) {
-		fixed_matrix<Ty, LHSRows, RHSCols> product;
-		for (std::size_t i = 0; i < LHSRows; ++i) {
-			for (std::size_t j = 0; j < RHSCols; ++j) {
-				for (std::size_t k = 0; k < LHSCols; ++k)
-					product(i, j) += lhs(i, j) * rhs(k, j);
-			}
-		}
-		return product;
+		std::size_t Rows,
+		std::size_t Cols
+	> constexpr std::array<Ty, Rows> matrix_vector_product(const fixed_matrix<Ty, Rows, Cols>& fm, const std::array<Ty, Cols>& x) {
+		return CRSC_IS_CONSTANT_EVALUATED()
+			? fixed_matrix_impl::constant_gemv(fm, x, std::make_index_sequence<Rows>())
+			: fixed_matrix_impl::runtime_gemv(fm, x);
 	}
+	/**
+	 * \brief Computes the trace of a square `fixed_matrix`, unrolled for small matrices.
+	 *
+	 * \param fm `fixed_matrix` for which to compute the trace.
+	 * \return Matrix trace of `fm`.
+	 * \complexity Linear in `RowsCols`.
+	 */
 	template<typename Ty,
 		std::size_t RowsCols
-	> Ty matrix_trace(const fixed_matrix<Ty, RowsCols, RowsCols>& fm) {
-		Ty trace = Ty();
-		for (auto it = fm.begin(); it < fm.end(); std::advance(it, RowsCols + 1))
-			trace += *it;
-		return trace;
+	> constexpr Ty matrix_trace(const fixed_matrix<Ty, RowsCols, RowsCols>& fm) {
+		return CRSC_IS_CONSTANT_EVALUATED() ? fixed_matrix_impl::constant_trace(fm) : fixed_matrix_impl::runtime_trace(fm);
+	}
+	/**
+	 * \brief Computes the determinant of a square `fixed_matrix`, in closed form by cofactors for up to 4 rows and
+	 *        via `fixed_lu_decomposition` otherwise.
+	 *
+	 * \param fm `fixed_matrix` for which to compute the determinant.
+	 * \return Determinant of `fm`.
+	 * \complexity Constant for up to 4 rows, otherwise cubic in `RowsCols`.
+	 */
+	template<typename Ty,
+		std::size_t RowsCols,
+		class = std::enable_if_t<(RowsCols >= 1U)>
+	> constexpr Ty matrix_determinant(const fixed_matrix<Ty, RowsCols, RowsCols>& fm) {
+		return fixed_matrix_impl::determinant(fm);
+	}
+	/**
+	 * \brief Computes the inverse of a square `fixed_matrix`. For up to 4 rows this is computed in closed form as
+	 *        the adjugate of `fm` scaled by the reciprocal of its determinant, otherwise via `fixed_lu_decomposition`.
+	 *
+	 * \param fm `fixed_matrix` to invert.
+	 * \return Inverse of `fm`.
+	 * \throw Throws `std::domain_error` exception if `fm` is singular.
+	 * \complexity Constant for up to 4 rows, otherwise cubic in `RowsCols`.
+	 */
+	template<typename Ty,
+		std::size_t RowsCols,
+		class = std::enable_if_t<(RowsCols >= 1U)>
+	> constexpr fixed_matrix<Ty, RowsCols, RowsCols> matrix_inverse(const fixed_matrix<Ty, RowsCols, RowsCols>& fm) {
+		return fixed_matrix_impl::inverse(fm);
+	}
+	/**
+	 * \brief Solves `a*x = b` for `x` via `fixed_lu_decomposition`. To solve repeatedly with the same `a` construct
+	 *        a `fixed_lu_decomposition` once and call its `solve` method instead.
+	 *
+	 * \throw Throws `std::domain_error` exception if `a` is singular.
+	 * \complexity Cubic in `N`.
+	 */
+	template<typename Ty,
+		std::size_t N
+	> constexpr std::array<Ty, N> matrix_solve(const fixed_matrix<Ty, N, N>& a, const std::array<Ty, N>& b) {
+		return fixed_lu_decomposition<Ty, N>(a).solve(b);
+	}
+	/**
+	 * \brief Solves `a*X = b` for `X` via `fixed_lu_decomposition`, where each column of `b` is a right-hand side.
+	 *
+	 * \throw Throws `std::domain_error` exception if `a` is singular.
+	 * \complexity Cubic in `N` plus quadratic in `N` multiplied by linear in `M`.
+	 */
+	template<typename Ty,
+		std::size_t N,
+		std::size_t M
+	> constexpr fixed_matrix<Ty, N, M> matrix_solve(const fixed_matrix<Ty, N, N>& a, const fixed_matrix<Ty, N, M>& b) {
+		return fixed_lu_decomposition<Ty, N>(a).solve(b);
 	}
 }
 
@@ -1,11 +1,12 @@
 #ifndef MATHEMATICAL_DYNAMIC_MATRIX_H
 #define MATHEMATICAL_DYNAMIC_MATRIX_H
 #include "dynamic_matrix.h"
+#include "matrix_expression.h"
 
 namespace crsc {
 	template<typename Ty,
 		class Allocator = std::allocator<Ty>
-	> class mathematical_dynamic_matrix {
+	> class mathematical_dynamic_matrix : public matrix_expression<mathematical_dynamic_matrix<Ty, Allocator>> {
 		typedef typename crsc::dynamic_matrix<Ty, Allocator> matrix_type;
 	public:
 		// PUBLIC API TYPE DEFINITIONS
@@ -41,6 +42,23 @@ namespace crsc {
 			: mtx(std::move(other.mtx), alloc) {}
 		mathematical_dynamic_matrix(std::initializer_list<std::initializer_list<value_type>> mat_init_list, const Allocator& alloc = Allocator())
 			: mtx(mat_init_list, alloc) {}
+		explicit mathematical_dynamic_matrix(const matrix_type& dm)
+			: mtx(dm) {}
+		explicit mathematical_dynamic_matrix(matrix_type&& dm)
+			: mtx(std::move(dm)) {}
+		/**
+		 * \brief Constructs the container by evaluating the matrix expression `expr` in a single pass, no
+		 *        temporary matrices are created for the intermediate results of `expr`.
+		 *
+		 * \param expr Expression to evaluate, e.g. `A + B - 2.0*C`.
+		 * \param alloc Allocator to use for all memory allocations of this container.
+		 * \complexity Linear in `expr.rows()*expr.columns()`.
+		 */
+		template<class Expr>
+		mathematical_dynamic_matrix(const matrix_expression<Expr>& expr, const Allocator& alloc = Allocator())
+			: mtx(expr.self().rows(), expr.self().columns(), alloc) {
+			assign_expression(expr.self());
+		}
 		~mathematical_dynamic_matrix() {}
 		mathematical_dynamic_matrix& operator=(const mathematical_dynamic_matrix& other) {
 			if (this != &other) mathematical_dynamic_matrix(other).swap(*this); // copy-swap
@@ -54,6 +72,23 @@ namespace crsc {
 			mtx = ilist;
 			return *this;
 		}
+		/**
+		 * \brief Replaces the contents of the container with the result of evaluating the matrix expression
+		 *        `expr` in a single pass. The expression may refer to this container, e.g. `A = A + B`.
+		 *
+		 * \param expr Expression to evaluate.
+		 * \return `*this`.
+		 * \complexity Linear in `expr.rows()*expr.columns()`.
+		 */
+		template<class Expr>
+		mathematical_dynamic_matrix& operator=(const matrix_expression<Expr>& expr) {
+			const Expr& e = expr.self();
+			// if dimensions differ this container cannot be a leaf of expr so evaluating into new storage is safe
+			if (e.rows() != rows() || e.columns() != columns())
+				mathematical_dynamic_matrix(e, get_allocator()).swap(*this);
+			else assign_expression(e);
+			return *this;
+		}
 		allocator_type get_allocator() const { return mtx.get_allocator(); }
 		// CAPACITY
 		bool empty() const noexcept { return mtx.empty(); }
@@ -69,6 +104,7 @@ namespace crsc {
 		reference at(size_type i, size_type j) { return mtx.at(i, j); }
 		// TODO: operator[][] 
 		const_reference operator()(size_type i, size_type j) const { return mtx(i, j); }
+		const_reference linear_element(size_type k) const { return mtx.data()[k]; }
 		reference operator()(size_type i, size_type j) { return mtx(i, j); }
 		const_reference front() const { return mtx.front(); }
 		reference front() { return mtx.front(); }
@@ -123,36 +159,36 @@ namespace crsc {
 		bool operator==(const mathematical_dynamic_matrix& other) const noexcept { return mtx == other.mtx; }
 		bool operator!=(const mathematical_dynamic_matrix& other) const noexcept { return !(*this == other); }
 		mathematical_dynamic_matrix& operator+=(const mathematical_dynamic_matrix& other) {
-			for (size_type i = 0; i < rows(); ++i) {
-				for (size_type j = 0; j < columns(); ++j)
-					mtx(i, j) += other.mtx(i, j);
-			}
+			if (rows() != other.rows() || columns() != other.columns())
+				throw std::invalid_argument("mathematical_dynamic_matrix dimensions must agree for component-wise addition.");
+			kernels::add(data(), other.data(), data(), size());
 			return *this;
 		}
 		mathematical_dynamic_matrix& operator-=(const mathematical_dynamic_matrix& other) {
-			for (size_type i = 0; i < rows(); ++i) {
-				for (size_type j = 0; j < columns(); ++j)
-					mtx(i, j) -= other.mtx(i, j);
-			}
+			if (rows() != other.rows() || columns() != other.columns())
+				throw std::invalid_argument("mathematical_dynamic_matrix dimensions must agree for component-wise subtraction.");
+			kernels::subtract(data(), other.data(), data(), size());
 			return *this;
 		}
-		mathematical_dynamic_matrix operator+(const mathematical_dynamic_matrix& other) {
-			return matrix_sum(mtx, other.mtx);
+		template<class Expr>
+		mathematical_dynamic_matrix& operator+=(const matrix_expression<Expr>& expr) {
+			assign_expression(*this + expr);
+			return *this;
 		}
-		mathematical_dynamic_matrix operator-(const mathematical_dynamic_matrix& other) {
-			return matrix_difference(mtx, other.mtx);
+		template<class Expr>
+		mathematical_dynamic_matrix& operator-=(const matrix_expression<Expr>& expr) {
+			assign_expression(*this - expr);
+			return *this;
 		}
-		mathematical_dynamic_matrix operator*(const mathematical_dynamic_matrix& other) {
-			return matrix_product(mtx, other.mtx);
+		mathematical_dynamic_matrix& axpy(const value_type& alpha, const mathematical_dynamic_matrix& x) {
+			matrix_axpy(alpha, x.mtx, mtx);
+			return *this;
 		}
 		mathematical_dynamic_matrix& operator*=(const value_type& scale) {
-			std::for_each(begin(), end(), [scale](auto& el) { el *= scale; });
+			kernels::scale(data(), scale, data(), size());
 			return *this;
 		}
-		mathematical_dynamic_matrix operator*(const value_type& scale) {
-			mathematical_dynamic_matrix scaled_matrix(*this);
-			return scaled_matrix *= scale;
-		}
+		const matrix_type& matrix() const noexcept { return mtx; }
 		// ITERATORS
 		/**
 		 * \brief Returns a const_iterator the first element of the container.
@@ -261,12 +297,48 @@ namespace crsc {
 		reverse_iterator rend() noexcept { return mtx.rend(); }
 	private:
 		matrix_type mtx;
+		// evaluates an expression of matching dimensions into mtx, sums, differences and Hadamard products of two
+		// containers are forwarded to the vectorized kernels, everything else is evaluated by a fused loop
+		template<class Expr>
+		void assign_expression(const Expr& e) { evaluate_expression(e, data()); }
+		void assign_expression(const matrix_binary_expression<mathematical_dynamic_matrix, mathematical_dynamic_matrix, matrix_expression_impl::plus>& e) {
+			kernels::add(e.left().data(), e.right().data(), data(), size());
+		}
+		void assign_expression(const matrix_binary_expression<mathematical_dynamic_matrix, mathematical_dynamic_matrix, matrix_expression_impl::minus>& e) {
+			kernels::subtract(e.left().data(), e.right().data(), data(), size());
+		}
+		void assign_expression(const matrix_binary_expression<mathematical_dynamic_matrix, mathematical_dynamic_matrix, matrix_expression_impl::multiplies>& e) {
+			kernels::hadamard(e.left().data(), e.right().data(), data(), size());
+		}
 	};
 	template<typename Ty,
 		class Alloc = std::allocator<Ty>
 	> void swap(mathematical_dynamic_matrix<Ty, Alloc>& lhs, mathematical_dynamic_matrix<Ty, Alloc>& rhs) {
 		lhs.swap(rhs);
 	}
+	/**
+	 * \brief Returns the matrix product of `lhs` with `rhs`, computed eagerly via `crsc::matrix_product`.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `lhs.columns() != rhs.rows()`.
+	 * \complexity Linear in `lhs.rows()*rhs.columns()*lhs.columns()`.
+	 */
+	template<typename Ty,
+		class Alloc = std::allocator<Ty>
+	> mathematical_dynamic_matrix<Ty, Alloc> operator*(const mathematical_dynamic_matrix<Ty, Alloc>& lhs, const mathematical_dynamic_matrix<Ty, Alloc>& rhs) {
+		return mathematical_dynamic_matrix<Ty, Alloc>(matrix_product(lhs.matrix(), rhs.matrix()));
+	}
+	/**
+	 * \brief Returns the matrix product of two matrix expressions, each operand which is not already a container is
+	 *        evaluated once before the product is computed.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `lhs.columns() != rhs.rows()`.
+	 * \complexity Linear in `lhs.rows()*rhs.columns()*lhs.columns()`.
+	 */
+	template<class Lhs, class Rhs>
+	mathematical_dynamic_matrix<typename Lhs::value_type> operator*(const matrix_expression<Lhs>& lhs, const matrix_expression<Rhs>& rhs) {
+		typedef mathematical_dynamic_matrix<typename Lhs::value_type> result_type;
+		return result_type(lhs) * result_type(rhs);
+	}
 	template<typename Ty,
 		class Alloc = std::allocator<Ty>,
 		class = std::enable_if_t<has_insertion_operator<Ty>::value>
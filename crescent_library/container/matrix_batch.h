@@ -0,0 +1,610 @@
+#ifndef MATRIX_BATCH_H
+#define MATRIX_BATCH_H
+#include "dynamic_matrix.h"
+#include "fixed_matrix.h"
+#include "matrix_kernels.h"
+#include "threading_utilities.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace crsc {
+	/**
+	 * \class matrix_batch
+	 *
+	 * \brief Batch of `count` matrices of identical dimensions `rows x cols`, stored interleaved such that the same
+	 *        element of every matrix is contiguous.
+	 *
+	 * Element `(i,j)` of matrix `b` is stored at `data()[(i*columns() + j)*count() + b]`, so `plane(i,j)` is a
+	 * contiguous array of `count()` elements. Operations on the batch are vector operations across the batch rather
+	 * than within a matrix, and so use full SIMD widths even for matrices much smaller than a vector register.
+	 *
+	 * \tparam Ty Type of the elements.
+	 * \tparam Allocator Type of the allocator used for the storage.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>
+	> class matrix_batch {
+	public:
+		typedef Ty value_type;
+		typedef Allocator allocator_type;
+		typedef std::size_t size_type;
+		typedef Ty& reference;
+		typedef const Ty& const_reference;
+		typedef Ty* pointer;
+		typedef const Ty* const_pointer;
+		/**
+		 * \brief Constructs an empty batch.
+		 */
+		matrix_batch() : mtx(), rows_(0U), cols_(0U), count_(0U) {}
+		/**
+		 * \brief Constructs a batch of `_count` matrices of dimensions `_rows x _cols`, each element initialised to `_val`.
+		 *
+		 * \param _rows Number of rows of each matrix.
+		 * \param _cols Number of columns of each matrix.
+		 * \param _count Number of matrices.
+		 * \param _val Initial value of the elements.
+		 * \param _alloc Allocator of the storage.
+		 */
+		matrix_batch(size_type _rows, size_type _cols, size_type _count, const value_type& _val = value_type(),
+			const allocator_type& _alloc = allocator_type())
+			: mtx(_rows*_cols*_count, _val, _alloc), rows_(_rows), cols_(_cols), count_(_count) {}
+		/**
+		 * \brief Gets the number of rows of each matrix.
+		 */
+		size_type rows() const noexcept { return rows_; }
+		/**
+		 * \brief Gets the number of columns of each matrix.
+		 */
+		size_type columns() const noexcept { return cols_; }
+		/**
+		 * \brief Gets the number of matrices in the batch.
+		 */
+		size_type count() const noexcept { return count_; }
+		/**
+		 * \brief Gets the total number of elements, `rows()*columns()*count()`.
+		 */
+		size_type size() const noexcept { return mtx.size(); }
+		bool empty() const noexcept { return mtx.empty(); }
+		allocator_type get_allocator() const { return mtx.get_allocator(); }
+		pointer data() noexcept { return mtx.data(); }
+		const_pointer data() const noexcept { return mtx.data(); }
+		/**
+		 * \brief Gets a pointer to the `count()` contiguous elements `(_row, _col)` of every matrix, with no bounds checking.
+		 */
+		pointer plane(size_type _row, size_type _col) noexcept { return mtx.data() + (_row*cols_ + _col)*count_; }
+		const_pointer plane(size_type _row, size_type _col) const noexcept { return mtx.data() + (_row*cols_ + _col)*count_; }
+		/**
+		 * \brief Accesses element `(_row, _col)` of matrix `_index`, with no bounds checking.
+		 */
+		reference operator()(size_type _index, size_type _row, size_type _col) { return mtx[(_row*cols_ + _col)*count_ + _index]; }
+		const_reference operator()(size_type _index, size_type _row, size_type _col) const { return mtx[(_row*cols_ + _col)*count_ + _index]; }
+		/**
+		 * \brief Accesses element `(_row, _col)` of matrix `_index`, with bounds checking.
+		 *
+		 * \throw Throws `std::out_of_range` exception if any of the indices are out of range.
+		 */
+		reference at(size_type _index, size_type _row, size_type _col) {
+			check_range(_index, _row, _col);
+			return (*this)(_index, _row, _col);
+		}
+		const_reference at(size_type _index, size_type _row, size_type _col) const {
+			check_range(_index, _row, _col);
+			return (*this)(_index, _row, _col);
+		}
+		/**
+		 * \brief Assigns the elements of `dm` to matrix `_index` of the batch.
+		 *
+		 * \throw Throws `std::out_of_range` exception if `_index >= count()` and `std::invalid_argument` exception if
+		 *        the dimensions of `dm` differ from those of the batch.
+		 * \complexity Linear in `rows()*columns()`.
+		 */
+		template<class OtherAllocator, class Layout>
+		void assign(size_type _index, const dynamic_matrix<value_type, OtherAllocator, Layout>& dm) {
+			if (_index >= count_) throw std::out_of_range("matrix_batch index out of range.");
+			if (dm.rows() != rows_ || dm.columns() != cols_)
+				throw std::invalid_argument("dynamic_matrix dimensions must equal matrix_batch dimensions.");
+			for (size_type i = 0; i < rows_; ++i)
+				for (size_type j = 0; j < cols_; ++j)
+					(*this)(_index, i, j) = dm(i, j);
+		}
+		/**
+		 * \brief Returns a copy of matrix `_index` of the batch.
+		 *
+		 * \throw Throws `std::out_of_range` exception if `_index >= count()`.
+		 * \complexity Linear in `rows()*columns()`.
+		 */
+		template<class Layout = row_major>
+		dynamic_matrix<value_type, allocator_type, Layout> matrix(size_type _index) const {
+			if (_index >= count_) throw std::out_of_range("matrix_batch index out of range.");
+			dynamic_matrix<value_type, allocator_type, Layout> dm(rows_, cols_);
+			for (size_type i = 0; i < rows_; ++i)
+				for (size_type j = 0; j < cols_; ++j)
+					dm(i, j) = (*this)(_index, i, j);
+			return dm;
+		}
+		/**
+		 * \brief Assigns `_val` to every element of every matrix.
+		 */
+		void fill(const value_type& _val) { std::fill(mtx.begin(), mtx.end(), _val); }
+		void swap(matrix_batch& other) noexcept {
+			mtx.swap(other.mtx);
+			std::swap(rows_, other.rows_);
+			std::swap(cols_, other.cols_);
+			std::swap(count_, other.count_);
+		}
+	private:
+		std::vector<value_type, allocator_type> mtx;
+		size_type rows_;
+		size_type cols_;
+		size_type count_;
+		void check_range(size_type _index, size_type _row, size_type _col) const {
+			if (_index >= count_ || _row >= rows_ || _col >= cols_)
+				throw std::out_of_range("matrix_batch index out of range.");
+		}
+	};
+	template<typename Ty, class Allocator>
+	void swap(matrix_batch<Ty, Allocator>& lhs, matrix_batch<Ty, Allocator>& rhs) noexcept {
+		lhs.swap(rhs);
+	}
+	/**
+	 * \brief Returns the batch of products `lhs[b]*rhs[b]` of corresponding matrices of two batches.
+	 *
+	 * \param lhs First batch, of `m x k` matrices.
+	 * \param rhs Second batch, of `k x n` matrices.
+	 * \return Batch of `lhs.count()` matrices of dimensions `m x n`.
+	 * \throw Throws `std::invalid_argument` exception if `lhs.columns() != rhs.rows()` or the counts differ.
+	 * \complexity Linear in `count*m*n*k`, vectorised across the batch.
+	 */
+	template<typename Ty, class Allocator>
+	matrix_batch<Ty, Allocator> batch_matrix_product(const matrix_batch<Ty, Allocator>& lhs, const matrix_batch<Ty, Allocator>& rhs) {
+		if (lhs.columns() != rhs.rows() || lhs.count() != rhs.count())
+			throw std::invalid_argument("matrix_batch dimensions and counts must agree for batch_matrix_product.");
+		matrix_batch<Ty, Allocator> product(lhs.rows(), rhs.columns(), lhs.count(), Ty(), lhs.get_allocator());
+		kernels::gemm_interleaved(lhs.rows(), rhs.columns(), lhs.columns(), lhs.count(),
+			lhs.data(), rhs.data(), product.data(), lhs.count());
+		return product;
+	}
+	/**
+	 * \brief Returns the batch of products `lhs[b]*rhs[b]` of corresponding matrices of two batches, with the batch
+	 *        divided into contiguous ranges of matrices across `pool` when `count*m*n*k` is at least `cutoff`.
+	 *
+	 * \param pool Thread pool on which to execute.
+	 * \param lhs First batch, of `m x k` matrices.
+	 * \param rhs Second batch, of `k x n` matrices.
+	 * \param cutoff Minimum number of multiply-adds to execute in parallel.
+	 * \return Batch of `lhs.count()` matrices of dimensions `m x n`.
+	 * \throw Throws `std::invalid_argument` exception if `lhs.columns() != rhs.rows()` or the counts differ.
+	 * \complexity Linear in `count*m*n*k`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty, class Allocator>
+	matrix_batch<Ty, Allocator> batch_matrix_product(thread_pool& pool, const matrix_batch<Ty, Allocator>& lhs,
+		const matrix_batch<Ty, Allocator>& rhs, std::size_t cutoff = parallel_cutoffs::product) {
+		if (lhs.columns() != rhs.rows() || lhs.count() != rhs.count())
+			throw std::invalid_argument("matrix_batch dimensions and counts must agree for batch_matrix_product.");
+		const std::size_t m = lhs.rows(), n = rhs.columns(), k = lhs.columns(), count = lhs.count();
+		matrix_batch<Ty, Allocator> product(m, n, count, Ty(), lhs.get_allocator());
+		const Ty* a = lhs.data();
+		const Ty* b = rhs.data();
+		Ty* c = product.data();
+		if (count*m*n*k < cutoff || pool.size() < 2U) {
+			kernels::gemm_interleaved(m, n, k, count, a, b, c, count);
+			return product;
+		}
+		// ranges are whole cache lines of each plane so that no line is written by two threads
+		const std::size_t grain = dynamic_matrix_parallel_impl::chunk_size(count, pool.size() + 1U,
+			std::max<std::size_t>(1U, 64U / sizeof(Ty)));
+		pool.parallel_for(0U, count, grain, [=](std::size_t first, std::size_t last) {
+			kernels::gemm_interleaved(m, n, k, last - first, a + first, b + first, c + first, count);
+		});
+		return product;
+	}
+	/**
+	 * \class fixed_matrix_batch
+	 *
+	 * \brief Batch of `count` matrices of compile-time dimensions `_Rows x _Cols`, the structure-of-arrays form of a
+	 *        sequence of `fixed_matrix<Ty, _Rows, _Cols>` objects.
+	 *
+	 * The storage is interleaved as for `crsc::matrix_batch`: element `(i,j)` of matrix `b` is stored at
+	 * `data()[(i*_Cols + j)*count() + b]`, so `plane(i,j)` is a contiguous array of `count()` elements. The batch
+	 * operations (`batch_matrix_product`, `batch_matrix_transpose`, `batch_matrix_inverse`, `batch_transform`) are
+	 * sequences of vector operations across the planes, such that each SSE2, AVX2 or AVX-512 instruction operates
+	 * on 4, 8 or 16 `float` matrices at once (half as many for `double`), rather than on the elements of a single
+	 * matrix which for 4x4 and smaller fill at most one register.
+	 *
+	 * \tparam Ty Type of the elements.
+	 * \tparam _Rows Number of rows of each matrix.
+	 * \tparam _Cols Number of columns of each matrix.
+	 * \tparam Allocator Type of the allocator used for the storage.
+	 */
+	template<typename Ty,
+		std::size_t _Rows,
+		std::size_t _Cols,
+		class Allocator = std::allocator<Ty>
+	> class fixed_matrix_batch {
+		static_assert(_Rows > 0U && _Cols > 0U, "fixed_matrix_batch dimensions must be non-zero.");
+	public:
+		typedef Ty value_type;
+		typedef Allocator allocator_type;
+		typedef std::size_t size_type;
+		typedef Ty& reference;
+		typedef const Ty& const_reference;
+		typedef Ty* pointer;
+		typedef const Ty* const_pointer;
+		typedef fixed_matrix<Ty, _Rows, _Cols> matrix_type;
+		/**
+		 * \brief Constructs an empty batch.
+		 */
+		fixed_matrix_batch() : mtx(), count_(0U) {}
+		/**
+		 * \brief Constructs a batch of `_count` matrices, each element initialised to `_val`.
+		 *
+		 * \param _count Number of matrices.
+		 * \param _val Initial value of the elements.
+		 * \param _alloc Allocator of the storage.
+		 */
+		explicit fixed_matrix_batch(size_type _count, const value_type& _val = value_type(), const allocator_type& _alloc = allocator_type())
+			: mtx(_Rows*_Cols*_count, _val, _alloc), count_(_count) {}
+		/**
+		 * \brief Constructs a batch from the range `[_first, _last)` of `fixed_matrix<Ty, _Rows, _Cols>` objects, i.e.
+		 *        converts the array-of-structures form of the matrices to the structure-of-arrays form.
+		 *
+		 * If the range is given as pointers into a contiguous array of matrices (e.g. `v.data()`, `v.data() + v.size()`
+		 * of a `std::vector`) the conversion is a single cache-blocked transpose of the `count x (_Rows*_Cols)` array
+		 * of elements (see `kernels::transpose`), otherwise the matrices are read one at a time.
+		 *
+		 * \param _first Forward iterator to the first matrix.
+		 * \param _last Forward iterator one past the last matrix.
+		 * \param _alloc Allocator of the storage.
+		 * \complexity Linear in `std::distance(_first, _last)*_Rows*_Cols`.
+		 */
+		template<class FwdIt,
+			class = std::enable_if_t<std::is_convertible<typename std::iterator_traits<FwdIt>::value_type, matrix_type>::value>
+		> fixed_matrix_batch(FwdIt _first, FwdIt _last, const allocator_type& _alloc = allocator_type())
+			: mtx(_alloc), count_(static_cast<size_type>(std::distance(_first, _last))) {
+			mtx.resize(_Rows*_Cols*count_);
+			scatter(_first, is_contiguous_range<FwdIt>());
+		}
+		/**
+		 * \brief Gets the number of rows of each matrix.
+		 */
+		static constexpr size_type rows() noexcept { return _Rows; }
+		/**
+		 * \brief Gets the number of columns of each matrix.
+		 */
+		static constexpr size_type columns() noexcept { return _Cols; }
+		/**
+		 * \brief Gets the number of matrices in the batch.
+		 */
+		size_type count() const noexcept { return count_; }
+		/**
+		 * \brief Gets the total number of elements, `rows()*columns()*count()`.
+		 */
+		size_type size() const noexcept { return mtx.size(); }
+		bool empty() const noexcept { return mtx.empty(); }
+		allocator_type get_allocator() const { return mtx.get_allocator(); }
+		pointer data() noexcept { return mtx.data(); }
+		const_pointer data() const noexcept { return mtx.data(); }
+		/**
+		 * \brief Gets a pointer to the `count()` contiguous elements `(_row, _col)` of every matrix, with no bounds checking.
+		 */
+		pointer plane(size_type _row, size_type _col) noexcept { return mtx.data() + (_row*_Cols + _col)*count_; }
+		const_pointer plane(size_type _row, size_type _col) const noexcept { return mtx.data() + (_row*_Cols + _col)*count_; }
+		/**
+		 * \brief Accesses element `(_row, _col)` of matrix `_index`, with no bounds checking.
+		 */
+		reference operator()(size_type _index, size_type _row, size_type _col) { return mtx[(_row*_Cols + _col)*count_ + _index]; }
+		const_reference operator()(size_type _index, size_type _row, size_type _col) const { return mtx[(_row*_Cols + _col)*count_ + _index]; }
+		/**
+		 * \brief Accesses element `(_row, _col)` of matrix `_index`, with bounds checking.
+		 *
+		 * \throw Throws `std::out_of_range` exception if any of the indices are out of range.
+		 */
+		reference at(size_type _index, size_type _row, size_type _col) {
+			check_range(_index, _row, _col);
+			return (*this)(_index, _row, _col);
+		}
+		const_reference at(size_type _index, size_type _row, size_type _col) const {
+			check_range(_index, _row, _col);
+			return (*this)(_index, _row, _col);
+		}
+		/**
+		 * \brief Assigns the elements of `fm` to matrix `_index` of the batch.
+		 *
+		 * \throw Throws `std::out_of_range` exception if `_index >= count()`.
+		 * \complexity Linear in `_Rows*_Cols`.
+		 */
+		void assign(size_type _index, const matrix_type& fm) {
+			if (_index >= count_) throw std::out_of_range("fixed_matrix_batch index out of range.");
+			for (size_type k = 0; k < _Rows*_Cols; ++k)
+				mtx[k*count_ + _index] = fm.data()[k];
+		}
+		/**
+		 * \brief Returns a copy of matrix `_index` of the batch.
+		 *
+		 * \throw Throws `std::out_of_range` exception if `_index >= count()`.
+		 * \complexity Linear in `_Rows*_Cols`.
+		 */
+		matrix_type matrix(size_type _index) const {
+			if (_index >= count_) throw std::out_of_range("fixed_matrix_batch index out of range.");
+			matrix_type fm;
+			for (size_type k = 0; k < _Rows*_Cols; ++k)
+				fm.data()[k] = mtx[k*count_ + _index];
+			return fm;
+		}
+		/**
+		 * \brief Writes every matrix of the batch, in order, to the range beginning at `_out`, i.e. converts the
+		 *        structure-of-arrays form of the matrices back to the array-of-structures form.
+		 *
+		 * As for construction from a range, a pointer into a contiguous array of matrices is written by a single
+		 * cache-blocked transpose.
+		 *
+		 * \param _out Output iterator to the first of `count()` matrices.
+		 * \return Iterator one past the last matrix written.
+		 * \complexity Linear in `size()`.
+		 */
+		template<class OutputIt>
+		OutputIt copy_to(OutputIt _out) const { return gather(_out, is_contiguous_range<OutputIt>()); }
+		/**
+		 * \brief Assigns `_val` to every element of every matrix.
+		 */
+		void fill(const value_type& _val) { std::fill(mtx.begin(), mtx.end(), _val); }
+		void swap(fixed_matrix_batch& other) noexcept {
+			mtx.swap(other.mtx);
+			std::swap(count_, other.count_);
+		}
+	private:
+		std::vector<value_type, allocator_type> mtx;
+		size_type count_;
+		// pointers to matrix_type, provided the elements of consecutive matrices of an array are themselves contiguous
+		template<class It>
+		using is_contiguous_range = std::integral_constant<bool, std::is_pointer<It>::value
+			&& std::is_same<std::remove_cv_t<std::remove_pointer_t<It>>, matrix_type>::value
+			&& sizeof(matrix_type) == _Rows*_Cols*sizeof(value_type)>;
+		template<class FwdIt>
+		void scatter(FwdIt _first, std::true_type) {
+			if (count_) kernels::transpose(count_, _Rows*_Cols, _first->data(), _Rows*_Cols, mtx.data(), count_);
+		}
+		template<class FwdIt>
+		void scatter(FwdIt _first, std::false_type) {
+			// each plane is written sequentially as the matrices are read
+			for (size_type b = 0; b < count_; ++b, ++_first) {
+				const matrix_type& fm = *_first;
+				for (size_type k = 0; k < _Rows*_Cols; ++k)
+					mtx[k*count_ + b] = fm.data()[k];
+			}
+		}
+		template<class OutputIt>
+		OutputIt gather(OutputIt _out, std::true_type) const {
+			if (count_) kernels::transpose(_Rows*_Cols, count_, mtx.data(), count_, _out->data(), _Rows*_Cols);
+			return _out + count_;
+		}
+		template<class OutputIt>
+		OutputIt gather(OutputIt _out, std::false_type) const {
+			for (size_type b = 0; b < count_; ++b, ++_out)
+				*_out = matrix(b);
+			return _out;
+		}
+		void check_range(size_type _index, size_type _row, size_type _col) const {
+			if (_index >= count_ || _row >= _Rows || _col >= _Cols)
+				throw std::out_of_range("fixed_matrix_batch index out of range.");
+		}
+	};
+	template<typename Ty, std::size_t Rows, std::size_t Cols, class Allocator>
+	void swap(fixed_matrix_batch<Ty, Rows, Cols, Allocator>& lhs, fixed_matrix_batch<Ty, Rows, Cols, Allocator>& rhs) noexcept {
+		lhs.swap(rhs);
+	}
+	/**
+	 * \brief Detail namespace for implementation of the `fixed_matrix_batch` algorithms.
+	 *
+	 * Each algorithm is expressed as a sequence of `crsc::kernels` elementwise operations on the planes of a block
+	 * of lanes (matrices), with the blocks small enough for the planes of the operands, the result and any
+	 * intermediate planes to remain in L1 cache between the operations.
+	 */
+	namespace fixed_matrix_batch_impl {
+		// lanes per block when `planes` planes are live, as for kernels::gemm_interleaved
+		template<typename Ty>
+		std::size_t lane_block(std::size_t planes) noexcept {
+			return std::max<std::size_t>(16U, std::min<std::size_t>(1024U, 16384U / (planes*sizeof(Ty))) / 16U*16U);
+		}
+		// planes of one operand within a block of lanes, element (i,j) of the block's matrices at at(i,j)
+		template<typename Ty, std::size_t C>
+		struct block_planes {
+			Ty* base;
+			std::size_t stride;
+			Ty* at(std::size_t _i, std::size_t _j) const noexcept { return base + (_i*C + _j)*stride; }
+		};
+		// intermediate planes of the inverses, enough for the twelve 2x2 minors of the 4x4 case and the
+		// determinant, its reciprocal and negated reciprocal, and a plane of ones
+		constexpr std::size_t inverse_scratch = 16U;
+		template<typename Ty>
+		void reciprocal(const Ty* _det, Ty* _r, Ty* _ones, std::size_t _len) {
+			if (std::find(_det, _det + _len, Ty()) != _det + _len)
+				throw std::domain_error("batch_matrix_inverse of a fixed_matrix_batch containing a singular matrix.");
+			std::fill(_ones, _ones + _len, static_cast<Ty>(1));
+			kernels::divide(_ones, _det, _r, _len);
+		}
+		template<typename Ty, std::size_t N>
+		void inverse(block_planes<const Ty, N> _a, block_planes<Ty, N> _out, Ty* _scratch, std::size_t _len) {
+			// larger matrices are factorized one at a time - the pivoting of each differs
+			for (std::size_t l = 0; l < _len; ++l) {
+				fixed_matrix<Ty, N, N> fm;
+				for (std::size_t k = 0; k < N*N; ++k) fm.data()[k] = _a.base[k*_a.stride + l];
+				const fixed_lu_decomposition<Ty, N> lu(fm);
+				if (lu.is_singular())
+					throw std::domain_error("batch_matrix_inverse of a fixed_matrix_batch containing a singular matrix.");
+				fm = lu.inverse();
+				for (std::size_t k = 0; k < N*N; ++k) _out.base[k*_out.stride + l] = fm.data()[k];
+			}
+			(void)_scratch;
+		}
+		template<typename Ty>
+		void inverse(block_planes<const Ty, 1> _a, block_planes<Ty, 1> _out, Ty* _scratch, std::size_t _len) {
+			reciprocal(_a.base, _out.base, _scratch, _len);
+		}
+		template<typename Ty>
+		void inverse(block_planes<const Ty, 2> _a, block_planes<Ty, 2> _out, Ty* _scratch, std::size_t _len) {
+			Ty* det = _scratch;
+			Ty* r = det + _len;
+			Ty* neg_r = r + _len;
+			kernels::hadamard(_a.at(0, 0), _a.at(1, 1), det, _len);
+			kernels::multiply_subtract(_a.at(0, 1), _a.at(1, 0), det, _len);
+			reciprocal(det, r, neg_r + _len, _len);
+			kernels::scale(r, static_cast<Ty>(-1), neg_r, _len);
+			kernels::hadamard(_a.at(1, 1), r, _out.at(0, 0), _len);
+			kernels::hadamard(_a.at(0, 1), neg_r, _out.at(0, 1), _len);
+			kernels::hadamard(_a.at(1, 0), neg_r, _out.at(1, 0), _len);
+			kernels::hadamard(_a.at(0, 0), r, _out.at(1, 1), _len);
+		}
+		template<typename Ty>
+		void inverse(block_planes<const Ty, 3> _a, block_planes<Ty, 3> _out, Ty* _scratch, std::size_t _len) {
+			Ty* det = _scratch;
+			Ty* r = det + _len;
+			// element (i,j) of the adjugate is the cofactor (j,i), the cyclic order of the remaining rows and columns
+			// of each minor carrying the sign of the cofactor
+			for (std::size_t i = 0; i < 3U; ++i) {
+				for (std::size_t j = 0; j < 3U; ++j) {
+					const std::size_t r1 = (j + 1U) % 3U, r2 = (j + 2U) % 3U, c1 = (i + 1U) % 3U, c2 = (i + 2U) % 3U;
+					kernels::hadamard(_a.at(r1, c1), _a.at(r2, c2), _out.at(i, j), _len);
+					kernels::multiply_subtract(_a.at(r1, c2), _a.at(r2, c1), _out.at(i, j), _len);
+				}
+			}
+			kernels::hadamard(_a.at(0, 0), _out.at(0, 0), det, _len);
+			kernels::multiply_add(_a.at(0, 1), _out.at(1, 0), det, _len);
+			kernels::multiply_add(_a.at(0, 2), _out.at(2, 0), det, _len);
+			reciprocal(det, r, r + _len, _len);
+			for (std::size_t k = 0; k < 9U; ++k) kernels::hadamard(_out.base + k*_out.stride, r, _out.base + k*_out.stride, _len);
+		}
+		template<typename Ty>
+		void inverse(block_planes<const Ty, 4> _a, block_planes<Ty, 4> _out, Ty* _scratch, std::size_t _len) {
+			// the 2x2 minors s of the upper and c of the lower pair of rows, as for fixed_matrix_impl::minors_4x4,
+			// over the pairs of columns (0,1), (0,2), (0,3), (1,2), (1,3), (2,3)
+			static constexpr std::size_t p[6] = { 0, 0, 0, 1, 1, 2 };
+			static constexpr std::size_t q[6] = { 1, 2, 3, 2, 3, 3 };
+			Ty* s = _scratch;
+			Ty* c = s + 6U*_len;
+			Ty* det = c + 6U*_len;
+			Ty* r = det + _len;
+			Ty* neg_r = r + _len;
+			for (std::size_t k = 0; k < 6U; ++k) {
+				kernels::hadamard(_a.at(0, p[k]), _a.at(1, q[k]), s + k*_len, _len);
+				kernels::multiply_subtract(_a.at(1, p[k]), _a.at(0, q[k]), s + k*_len, _len);
+				kernels::hadamard(_a.at(2, p[k]), _a.at(3, q[k]), c + k*_len, _len);
+				kernels::multiply_subtract(_a.at(3, p[k]), _a.at(2, q[k]), c + k*_len, _len);
+			}
+			// det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0
+			kernels::hadamard(s, c + 5U*_len, det, _len);
+			for (std::size_t k = 1; k < 6U; ++k) {
+				if (k == 1U || k == 4U) kernels::multiply_subtract(s + k*_len, c + (5U - k)*_len, det, _len);
+				else kernels::multiply_add(s + k*_len, c + (5U - k)*_len, det, _len);
+			}
+			reciprocal(det, r, neg_r + _len, _len);
+			kernels::scale(r, static_cast<Ty>(-1), neg_r, _len);
+			// element (i,j) is +-(x0*m0 - x1*m1 + x2*m2), the x being the elements of row {1,0,3,2}[j] in the columns
+			// other than i and the m the minors of the other pair of rows over the complementary pairs of columns,
+			// negated when i + j is odd
+			static constexpr std::size_t row_of[4] = { 1, 0, 3, 2 };
+			static constexpr std::size_t minors_of[4][3] = { { 5, 4, 3 }, { 5, 2, 1 }, { 4, 2, 0 }, { 3, 1, 0 } };
+			for (std::size_t i = 0; i < 4U; ++i) {
+				const std::size_t cols[3] = { i == 0U ? 1U : 0U, i <= 1U ? 2U : 1U, i <= 2U ? 3U : 2U };
+				for (std::size_t j = 0; j < 4U; ++j) {
+					const Ty* m = j < 2U ? c : s;
+					Ty* out = _out.at(i, j);
+					kernels::hadamard(_a.at(row_of[j], cols[0]), m + minors_of[i][0]*_len, out, _len);
+					kernels::multiply_subtract(_a.at(row_of[j], cols[1]), m + minors_of[i][1]*_len, out, _len);
+					kernels::multiply_add(_a.at(row_of[j], cols[2]), m + minors_of[i][2]*_len, out, _len);
+					kernels::hadamard(out, (i + j) % 2U ? neg_r : r, out, _len);
+				}
+			}
+		}
+	}
+	/**
+	 * \brief Returns the batch of products `lhs[b]*rhs[b]` of corresponding matrices of two batches.
+	 *
+	 * \param lhs First batch, of `M x K` matrices.
+	 * \param rhs Second batch, of `K x N` matrices.
+	 * \return Batch of `lhs.count()` matrices of dimensions `M x N`.
+	 * \throw Throws `std::invalid_argument` exception if the counts of the batches differ.
+	 * \complexity Linear in `count*M*N*K`, vectorised across the batch.
+	 */
+	template<typename Ty, std::size_t M, std::size_t K, std::size_t N, class Allocator>
+	fixed_matrix_batch<Ty, M, N, Allocator> batch_matrix_product(const fixed_matrix_batch<Ty, M, K, Allocator>& lhs,
+		const fixed_matrix_batch<Ty, K, N, Allocator>& rhs) {
+		if (lhs.count() != rhs.count())
+			throw std::invalid_argument("fixed_matrix_batch counts must agree for batch_matrix_product.");
+		fixed_matrix_batch<Ty, M, N, Allocator> product(lhs.count(), Ty(), lhs.get_allocator());
+		kernels::gemm_interleaved(M, N, K, lhs.count(), lhs.data(), rhs.data(), product.data(), lhs.count());
+		return product;
+	}
+	/**
+	 * \brief Returns the batch of transposes of the matrices of `batch`.
+	 *
+	 * \param batch Batch of `R x C` matrices.
+	 * \return Batch of `batch.count()` matrices of dimensions `C x R`.
+	 * \complexity Linear in `batch.size()`, each plane being copied whole.
+	 */
+	template<typename Ty, std::size_t R, std::size_t C, class Allocator>
+	fixed_matrix_batch<Ty, C, R, Allocator> batch_matrix_transpose(const fixed_matrix_batch<Ty, R, C, Allocator>& batch) {
+		fixed_matrix_batch<Ty, C, R, Allocator> transpose(batch.count(), Ty(), batch.get_allocator());
+		for (std::size_t i = 0; i < R; ++i)
+			for (std::size_t j = 0; j < C; ++j)
+				std::copy(batch.plane(i, j), batch.plane(i, j) + batch.count(), transpose.plane(j, i));
+		return transpose;
+	}
+	/**
+	 * \brief Returns the batch of inverses of the matrices of `batch`. Matrices of up to 4x4 are inverted in closed
+	 *        form as for `matrix_inverse`, vectorised across the batch, larger matrices via `fixed_lu_decomposition`.
+	 *
+	 * \param batch Batch of `N x N` matrices.
+	 * \return Batch of `batch.count()` inverses.
+	 * \throw Throws `std::domain_error` exception if any matrix of `batch` is singular.
+	 * \complexity Linear in `batch.count()`, with an `O(N^3)` factor for `N > 4`.
+	 * \exceptionsafety Strong guarantee, `batch` is not modified.
+	 */
+	template<typename Ty, std::size_t N, class Allocator>
+	fixed_matrix_batch<Ty, N, N, Allocator> batch_matrix_inverse(const fixed_matrix_batch<Ty, N, N, Allocator>& batch) {
+		const std::size_t count = batch.count();
+		fixed_matrix_batch<Ty, N, N, Allocator> inverse(count, Ty(), batch.get_allocator());
+		const std::size_t block = fixed_matrix_batch_impl::lane_block<Ty>(2U*N*N + fixed_matrix_batch_impl::inverse_scratch);
+		std::vector<Ty> scratch(N <= 4U ? fixed_matrix_batch_impl::inverse_scratch*std::min(block, count) : 0U);
+		for (std::size_t l0 = 0; l0 < count; l0 += block) {
+			fixed_matrix_batch_impl::inverse(fixed_matrix_batch_impl::block_planes<const Ty, N>{ batch.data() + l0, count },
+				fixed_matrix_batch_impl::block_planes<Ty, N>{ inverse.data() + l0, count }, scratch.data(), std::min(block, count - l0));
+		}
+		return inverse;
+	}
+	/**
+	 * \brief Applies the transform `t` to every matrix of `batch`, returning the batch of products `t*batch[b]`. A
+	 *        batch of `K x 1` matrices holds vectors, e.g. the points of a mesh to which an affine transform is applied.
+	 *
+	 * \param t Transform, an `M x K` matrix.
+	 * \param batch Batch of `K x C` matrices.
+	 * \return Batch of `batch.count()` matrices of dimensions `M x C`.
+	 * \complexity Linear in `count*M*C*K`, vectorised across the batch.
+	 */
+	template<typename Ty, std::size_t M, std::size_t K, std::size_t C, class Allocator>
+	fixed_matrix_batch<Ty, M, C, Allocator> batch_transform(const fixed_matrix<Ty, M, K>& t, const fixed_matrix_batch<Ty, K, C, Allocator>& batch) {
+		const std::size_t count = batch.count();
+		fixed_matrix_batch<Ty, M, C, Allocator> product(count, Ty(), batch.get_allocator());
+		const std::size_t block = fixed_matrix_batch_impl::lane_block<Ty>(K*C + M*C);
+		for (std::size_t l0 = 0; l0 < count; l0 += block) {
+			const std::size_t len = std::min(block, count - l0);
+			for (std::size_t i = 0; i < M; ++i) {
+				for (std::size_t j = 0; j < C; ++j) {
+					Ty* out = product.plane(i, j) + l0;
+					kernels::scale(batch.plane(0, j) + l0, t(i, 0), out, len);
+					for (std::size_t p = 1; p < K; ++p)
+						kernels::axpy(t(i, p), batch.plane(p, j) + l0, out, len);
+				}
+			}
+		}
+		return product;
+	}
+}
+
+#endif // !MATRIX_BATCH_H
@@ -0,0 +1,713 @@
+#ifndef MATRIX_DECOMPOSITION_H
+#define MATRIX_DECOMPOSITION_H
+#include "mathematical_dynamic_matrix.h"
+#include "matrix_kernels.h"
+#include "threading_utilities.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace crsc {
+	namespace parallel_cutoffs {
+		// order of the matrix being factorized
+		constexpr std::size_t decomposition = 256U;
+	}
+	/**
+	 * \brief Detail namespace for implementation of the matrix decompositions.
+	 */
+	namespace decomposition_impl {
+		// number of columns factorized per panel before the trailing matrix is updated with a single product
+		constexpr std::size_t block_size = 64U;
+		// invokes f(first, last) over [first, last), split into chunks of at most grain indices across pool if
+		// one is given and there is more than one chunk of work
+		template<class Fn>
+		void for_each_chunk(thread_pool* pool, std::size_t first, std::size_t last, std::size_t grain, Fn f) {
+			if (first >= last) return;
+			if (!pool || pool->size() < 2U || last - first <= grain) f(first, last);
+			else pool->parallel_for(first, last, grain, f);
+		}
+		// grain giving one chunk per thread of pool, rounded up to a multiple of align
+		inline std::size_t even_grain(thread_pool* pool, std::size_t count, std::size_t align) {
+			return pool ? dynamic_matrix_parallel_impl::chunk_size(count, pool->size() + 1U, align) : count;
+		}
+		// row r of x (n rows by nrhs columns) as a pointer
+		template<typename Ty>
+		Ty* row(Ty* x, std::size_t r, std::size_t nrhs) noexcept { return x + r*nrhs; }
+	}
+	/**
+	 * \class lu_decomposition
+	 *
+	 * \brief Factorization `P*A = L*U` of a square matrix `A` with partial (row) pivoting, where `L` is unit lower
+	 *        triangular, `U` is upper triangular and `P` is a permutation.
+	 *
+	 * The factorization is blocked: each panel of `decomposition_impl::block_size` columns is factorized with
+	 * row pivoting, the corresponding rows of `U` are found by forward substitution and the remaining trailing
+	 * matrix is updated by a single `crsc::kernels::gemm` product, which is partitioned by rows across a
+	 * `thread_pool` if one is given. Once constructed the factorization may be used to solve any number of
+	 * systems `A*X = B`, to compute the determinant of `A` or its inverse without being recomputed.
+	 *
+	 * \tparam Ty Type of the elements, must be a floating point type.
+	 * \tparam Allocator Type of the allocator used for the factors.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>
+	> class lu_decomposition {
+		static_assert(std::is_floating_point<Ty>::value, "lu_decomposition requires a floating point element type.");
+	public:
+		typedef Ty value_type;
+		typedef std::size_t size_type;
+		typedef dynamic_matrix<Ty, Allocator> matrix_type;
+		typedef mathematical_dynamic_matrix<Ty, Allocator> result_type;
+		/**
+		 * \brief Factorizes the square matrix `a`.
+		 *
+		 * \param a Matrix to factorize.
+		 * \throw Throws `std::invalid_argument` exception if `a.rows() != a.columns()`.
+		 * \complexity Cubic in `a.rows()`.
+		 */
+		explicit lu_decomposition(matrix_type a)
+			: lu_(std::move(a)) {
+			factorize(nullptr);
+		}
+		explicit lu_decomposition(const result_type& a)
+			: lu_decomposition(a.matrix()) {}
+		/**
+		 * \brief Factorizes the square matrix `a`, updating the trailing matrix after each panel across the
+		 *        threads of `pool`.
+		 *
+		 * \param pool Thread pool on which to execute.
+		 * \param a Matrix to factorize.
+		 * \param cutoff Order of `a` below which the factorization runs serially.
+		 * \throw Throws `std::invalid_argument` exception if `a.rows() != a.columns()`.
+		 * \complexity Cubic in `a.rows()`, the trailing updates divided across `pool.size() + 1` threads.
+		 */
+		lu_decomposition(thread_pool& pool, matrix_type a, std::size_t cutoff = parallel_cutoffs::decomposition)
+			: lu_(std::move(a)) {
+			factorize(lu_.rows() < cutoff ? nullptr : &pool);
+		}
+		lu_decomposition(thread_pool& pool, const result_type& a, std::size_t cutoff = parallel_cutoffs::decomposition)
+			: lu_decomposition(pool, a.matrix(), cutoff) {}
+		/**
+		 * \brief Returns the order of the factorized matrix.
+		 */
+		size_type size() const noexcept { return lu_.rows(); }
+		/**
+		 * \brief Returns `true` if a pivot of the factorization is exactly zero, i.e. if the factorized matrix is
+		 *        singular, in which case `solve` and `inverse` throw.
+		 */
+		bool is_singular() const noexcept { return singular_; }
+		/**
+		 * \brief Returns the factors `L` and `U` packed into a single matrix, `U` occupying the upper triangle and
+		 *        the diagonal and `L` (without its unit diagonal) the strict lower triangle.
+		 */
+		const matrix_type& packed_factors() const noexcept { return lu_; }
+		/**
+		 * \brief Returns the row interchanges of the factorization, row `i` having been swapped with row
+		 *        `pivots()[i]` at step `i`.
+		 */
+		const std::vector<size_type>& pivots() const noexcept { return pivots_; }
+		/**
+		 * \brief Computes the determinant of the factorized matrix.
+		 *
+		 * \complexity Linear in `size()`.
+		 */
+		value_type determinant() const noexcept {
+			value_type det = static_cast<value_type>(sign_);
+			for (size_type i = 0; i < size(); ++i) det *= lu_(i, i);
+			return det;
+		}
+		/**
+		 * \brief Solves `A*X = B` for `X`.
+		 *
+		 * \param b Right-hand sides, one per column.
+		 * \return Solution `X` with the dimensions of `b`.
+		 * \throw Throws `std::invalid_argument` exception if `b.rows() != size()`, or `std::domain_error`
+		 *        exception if the factorized matrix is singular.
+		 * \complexity Quadratic in `size()` multiplied by linear in `b.columns()`.
+		 */
+		result_type solve(const result_type& b) const {
+			if (b.rows() != size())
+				throw std::invalid_argument("lu_decomposition right-hand side must have size() rows.");
+			result_type x(b);
+			solve_in_place(x.data(), x.columns());
+			return x;
+		}
+		/**
+		 * \brief Solves `A*x = b` for the single right-hand side `b`.
+		 *
+		 * \throw Throws `std::invalid_argument` exception if `b.size() != size()`, or `std::domain_error`
+		 *        exception if the factorized matrix is singular.
+		 * \complexity Quadratic in `size()`.
+		 */
+		std::vector<value_type> solve(std::vector<value_type> b) const {
+			if (b.size() != size())
+				throw std::invalid_argument("lu_decomposition right-hand side must have size() elements.");
+			solve_in_place(b.data(), 1U);
+			return b;
+		}
+		/**
+		 * \brief Computes the inverse of the factorized matrix by solving for each column of the identity.
+		 *
+		 * \throw Throws `std::domain_error` exception if the factorized matrix is singular.
+		 * \complexity Cubic in `size()`.
+		 */
+		result_type inverse() const {
+			result_type x(size(), size(), value_type(0), lu_.get_allocator());
+			for (size_type i = 0; i < size(); ++i) x(i, i) = value_type(1);
+			solve_in_place(x.data(), size());
+			return x;
+		}
+	private:
+		matrix_type lu_;
+		std::vector<size_type> pivots_;
+		int sign_ = 1;
+		bool singular_ = false;
+		void factorize(thread_pool* pool) {
+			if (lu_.rows() != lu_.columns())
+				throw std::invalid_argument("lu_decomposition requires a square matrix.");
+			const size_type n = lu_.rows();
+			const size_type nb = decomposition_impl::block_size;
+			Ty* a = lu_.data();
+			pivots_.resize(n);
+			std::vector<Ty> neg_l;
+			for (size_type k0 = 0; k0 < n; k0 += nb) {
+				const size_type k1 = std::min(n, k0 + nb), kb = k1 - k0;
+				factorize_panel(a, n, k0, k1);
+				if (k1 == n) break;
+				// U12 = inv(L11)*A12 by forward substitution over the rows of the panel
+				for (size_type i = k0 + 1; i < k1; ++i) {
+					for (size_type p = k0; p < i; ++p)
+						kernels::axpy(-a[i*n + p], a + p*n + k1, a + i*n + k1, n - k1);
+				}
+				// A22 -= L21*U12, negating L21 into a contiguous buffer as gemm accumulates
+				neg_l.resize((n - k1)*kb);
+				for (size_type i = k1; i < n; ++i) {
+					for (size_type p = 0; p < kb; ++p) neg_l[(i - k1)*kb + p] = -a[i*n + k0 + p];
+				}
+				const Ty* l21 = neg_l.data();
+				decomposition_impl::for_each_chunk(pool, k1, n,
+					decomposition_impl::even_grain(pool, n - k1, kernels::gemm_blocking<Ty>::mr),
+					[a, l21, n, k0, k1, kb](size_type first, size_type last) {
+					kernels::gemm(last - first, n - k1, kb, l21 + (first - k1)*kb, kb, 1,
+						a + k0*n + k1, n, 1, a + first*n + k1, n, 1);
+				});
+			}
+		}
+		// unblocked right-looking factorization of columns [k0, k1), whole rows being interchanged on pivoting
+		void factorize_panel(Ty* a, size_type n, size_type k0, size_type k1) {
+			using std::abs;
+			for (size_type k = k0; k < k1; ++k) {
+				size_type p = k;
+				for (size_type i = k + 1; i < n; ++i) {
+					if (abs(a[i*n + k]) > abs(a[p*n + k])) p = i;
+				}
+				pivots_[k] = p;
+				if (p != k) {
+					std::swap_ranges(a + k*n, a + (k + 1)*n, a + p*n);
+					sign_ = -sign_;
+				}
+				if (a[k*n + k] == Ty(0)) {
+					singular_ = true;
+					continue;
+				}
+				const Ty inv_pivot = Ty(1) / a[k*n + k];
+				for (size_type i = k + 1; i < n; ++i) {
+					Ty* ri = a + i*n;
+					ri[k] *= inv_pivot;
+					kernels::axpy(-ri[k], a + k*n + k + 1, ri + k + 1, k1 - k - 1);
+				}
+			}
+		}
+		void solve_in_place(Ty* x, size_type nrhs) const {
+			using decomposition_impl::row;
+			if (singular_) throw std::domain_error("lu_decomposition of a singular matrix cannot be solved.");
+			const size_type n = size();
+			const Ty* a = lu_.data();
+			for (size_type k = 0; k < n; ++k) {
+				if (pivots_[k] != k) std::swap_ranges(row(x, k, nrhs), row(x, k + 1, nrhs), row(x, pivots_[k], nrhs));
+			}
+			for (size_type i = 1; i < n; ++i) {
+				for (size_type p = 0; p < i; ++p)
+					kernels::axpy(-a[i*n + p], row(x, p, nrhs), row(x, i, nrhs), nrhs);
+			}
+			for (size_type i = n; i-- > 0;) {
+				for (size_type p = i + 1; p < n; ++p)
+					kernels::axpy(-a[i*n + p], row(x, p, nrhs), row(x, i, nrhs), nrhs);
+				kernels::scale(row(x, i, nrhs), Ty(1) / a[i*n + i], row(x, i, nrhs), nrhs);
+			}
+		}
+	};
+	/**
+	 * \class cholesky_decomposition
+	 *
+	 * \brief Factorization `A = L*transpose(L)` of a symmetric positive definite matrix `A`, where `L` is lower
+	 *        triangular with a positive diagonal.
+	 *
+	 * Only the lower triangle of `A` is read. The factorization is blocked as for `lu_decomposition`: each panel
+	 * is factorized, the rows of `L` below it are found by substitution and the trailing matrix is updated by
+	 * `crsc::kernels::gemm`, with both of the latter steps partitioned by rows across a `thread_pool` if one is
+	 * given. Solving with a Cholesky factor costs half as much as with an LU factorization and requires no
+	 * pivoting.
+	 *
+	 * \tparam Ty Type of the elements, must be a floating point type.
+	 * \tparam Allocator Type of the allocator used for the factor.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>
+	> class cholesky_decomposition {
+		static_assert(std::is_floating_point<Ty>::value, "cholesky_decomposition requires a floating point element type.");
+	public:
+		typedef Ty value_type;
+		typedef std::size_t size_type;
+		typedef dynamic_matrix<Ty, Allocator> matrix_type;
+		typedef mathematical_dynamic_matrix<Ty, Allocator> result_type;
+		/**
+		 * \brief Factorizes the symmetric positive definite matrix `a`.
+		 *
+		 * \param a Matrix to factorize, only its lower triangle is read.
+		 * \throw Throws `std::invalid_argument` exception if `a.rows() != a.columns()`, or `std::domain_error`
+		 *        exception if `a` is not positive definite.
+		 * \complexity Cubic in `a.rows()`.
+		 */
+		explicit cholesky_decomposition(matrix_type a)
+			: l_(std::move(a)) {
+			factorize(nullptr);
+		}
+		explicit cholesky_decomposition(const result_type& a)
+			: cholesky_decomposition(a.matrix()) {}
+		/**
+		 * \brief Factorizes the symmetric positive definite matrix `a` across the threads of `pool`.
+		 *
+		 * \param pool Thread pool on which to execute.
+		 * \param a Matrix to factorize, only its lower triangle is read.
+		 * \param cutoff Order of `a` below which the factorization runs serially.
+		 * \throw Throws `std::invalid_argument` exception if `a.rows() != a.columns()`, or `std::domain_error`
+		 *        exception if `a` is not positive definite.
+		 * \complexity Cubic in `a.rows()`, divided across `pool.size() + 1` threads.
+		 */
+		cholesky_decomposition(thread_pool& pool, matrix_type a, std::size_t cutoff = parallel_cutoffs::decomposition)
+			: l_(std::move(a)) {
+			factorize(l_.rows() < cutoff ? nullptr : &pool);
+		}
+		cholesky_decomposition(thread_pool& pool, const result_type& a, std::size_t cutoff = parallel_cutoffs::decomposition)
+			: cholesky_decomposition(pool, a.matrix(), cutoff) {}
+		/**
+		 * \brief Returns the order of the factorized matrix.
+		 */
+		size_type size() const noexcept { return l_.rows(); }
+		/**
+		 * \brief Returns the lower triangular factor `L`, whose strict upper triangle is zero.
+		 */
+		const matrix_type& factor() const noexcept { return l_; }
+		/**
+		 * \brief Computes the determinant of the factorized matrix.
+		 *
+		 * \complexity Linear in `size()`.
+		 */
+		value_type determinant() const noexcept {
+			value_type det = value_type(1);
+			for (size_type i = 0; i < size(); ++i) det *= l_(i, i) * l_(i, i);
+			return det;
+		}
+		/**
+		 * \brief Solves `A*X = B` for `X`.
+		 *
+		 * \param b Right-hand sides, one per column.
+		 * \return Solution `X` with the dimensions of `b`.
+		 * \throw Throws `std::invalid_argument` exception if `b.rows() != size()`.
+		 * \complexity Quadratic in `size()` multiplied by linear in `b.columns()`.
+		 */
+		result_type solve(const result_type& b) const {
+			if (b.rows() != size())
+				throw std::invalid_argument("cholesky_decomposition right-hand side must have size() rows.");
+			result_type x(b);
+			solve_in_place(x.data(), x.columns());
+			return x;
+		}
+		/**
+		 * \brief Solves `A*x = b` for the single right-hand side `b`.
+		 *
+		 * \throw Throws `std::invalid_argument` exception if `b.size() != size()`.
+		 * \complexity Quadratic in `size()`.
+		 */
+		std::vector<value_type> solve(std::vector<value_type> b) const {
+			if (b.size() != size())
+				throw std::invalid_argument("cholesky_decomposition right-hand side must have size() elements.");
+			solve_in_place(b.data(), 1U);
+			return b;
+		}
+		/**
+		 * \brief Computes the inverse of the factorized matrix by solving for each column of the identity.
+		 *
+		 * \complexity Cubic in `size()`.
+		 */
+		result_type inverse() const {
+			result_type x(size(), size(), value_type(0), l_.get_allocator());
+			for (size_type i = 0; i < size(); ++i) x(i, i) = value_type(1);
+			solve_in_place(x.data(), size());
+			return x;
+		}
+	private:
+		matrix_type l_;
+		// rows per chunk of the parallel steps, small as the work per row of the trailing update varies
+		static constexpr size_type row_grain = 32U;
+		void factorize(thread_pool* pool) {
+			if (l_.rows() != l_.columns())
+				throw std::invalid_argument("cholesky_decomposition requires a square matrix.");
+			const size_type n = l_.rows();
+			const size_type nb = decomposition_impl::block_size;
+			const size_type grain = row_grain;
+			Ty* a = l_.data();
+			std::vector<Ty> neg_l;
+			for (size_type k0 = 0; k0 < n; k0 += nb) {
+				const size_type k1 = std::min(n, k0 + nb), kb = k1 - k0;
+				// L11 from the diagonal block, which already holds A11 - L10*transpose(L10)
+				for (size_type j = k0; j < k1; ++j) {
+					Ty d = a[j*n + j];
+					for (size_type p = k0; p < j; ++p) d -= a[j*n + p] * a[j*n + p];
+					if (!(d > Ty(0)))
+						throw std::domain_error("cholesky_decomposition requires a positive definite matrix.");
+					a[j*n + j] = std::sqrt(d);
+					substitute_rows(a, n, j + 1, k1, k0, j, j + 1);
+				}
+				if (k1 == n) break;
+				// L21 = A21*inv(transpose(L11)), each row independently, also negated into a contiguous buffer
+				neg_l.resize((n - k1)*kb);
+				Ty* l21 = neg_l.data();
+				decomposition_impl::for_each_chunk(pool, k1, n, grain, [a, l21, n, k0, k1, kb](size_type first, size_type last) {
+					substitute_rows(a, n, first, last, k0, k0, k1);
+					for (size_type i = first; i < last; ++i) {
+						for (size_type p = 0; p < kb; ++p) l21[(i - k1)*kb + p] = -a[i*n + k0 + p];
+					}
+				});
+				// lower trapezoid of A22 -= L21*transpose(L21), transpose(L21) read in place through its strides
+				decomposition_impl::for_each_chunk(pool, k1, n, grain, [a, l21, n, k0, k1, kb](size_type first, size_type last) {
+					kernels::gemm(last - first, last - k1, kb, l21 + (first - k1)*kb, kb, 1,
+						a + k1*n + k0, 1, n, a + first*n + k1, n, 1);
+				});
+			}
+			for (size_type i = 0; i < n; ++i)
+				std::fill(a + i*n + i + 1, a + (i + 1)*n, Ty(0));
+		}
+		// for rows [first, last) computes columns [jfirst, jend) of L within the panel starting at column k0
+		static void substitute_rows(Ty* a, size_type n, size_type first, size_type last, size_type k0, size_type jfirst, size_type jend) {
+			for (size_type i = first; i < last; ++i) {
+				Ty* ri = a + i*n;
+				for (size_type j = jfirst; j < jend; ++j) {
+					const Ty* rj = a + j*n;
+					Ty s = ri[j];
+					for (size_type p = k0; p < j; ++p) s -= ri[p] * rj[p];
+					ri[j] = s / rj[j];
+				}
+			}
+		}
+		void solve_in_place(Ty* x, size_type nrhs) const {
+			using decomposition_impl::row;
+			const size_type n = size();
+			const Ty* a = l_.data();
+			// L*Y = B
+			for (size_type i = 0; i < n; ++i) {
+				for (size_type p = 0; p < i; ++p)
+					kernels::axpy(-a[i*n + p], row(x, p, nrhs), row(x, i, nrhs), nrhs);
+				kernels::scale(row(x, i, nrhs), Ty(1) / a[i*n + i], row(x, i, nrhs), nrhs);
+			}
+			// transpose(L)*X = Y, eliminating by rows of L such that it is read contiguously
+			for (size_type i = n; i-- > 0;) {
+				kernels::scale(row(x, i, nrhs), Ty(1) / a[i*n + i], row(x, i, nrhs), nrhs);
+				for (size_type p = 0; p < i; ++p)
+					kernels::axpy(-a[i*n + p], row(x, i, nrhs), row(x, p, nrhs), nrhs);
+			}
+		}
+	};
+	template<typename Ty, class Allocator>
+	constexpr std::size_t cholesky_decomposition<Ty, Allocator>::row_grain;
+	/**
+	 * \class qr_decomposition
+	 *
+	 * \brief Factorization `A = Q*R` of an `m x n` matrix `A` with `m >= n` by Householder reflections, where `Q`
+	 *        is orthogonal and `R` is upper triangular.
+	 *
+	 * `Q` is held implicitly as the product of `n` reflectors `H(k) = I - tau(k)*v(k)*transpose(v(k))`, whose
+	 * vectors `v(k)` occupy the strict lower triangle of the factorized storage. The reflectors of each panel of
+	 * `decomposition_impl::block_size` columns are aggregated into the compact "WY" form `I - V*T*transpose(V)`
+	 * such that they are applied to the trailing matrix by two `crsc::kernels::gemm` products, partitioned by
+	 * columns across a `thread_pool` if one is given. Solving with the factorization gives the least squares
+	 * solution of overdetermined systems.
+	 *
+	 * \tparam Ty Type of the elements, must be a floating point type.
+	 * \tparam Allocator Type of the allocator used for the factors.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>
+	> class qr_decomposition {
+		static_assert(std::is_floating_point<Ty>::value, "qr_decomposition requires a floating point element type.");
+	public:
+		typedef Ty value_type;
+		typedef std::size_t size_type;
+		typedef dynamic_matrix<Ty, Allocator> matrix_type;
+		typedef mathematical_dynamic_matrix<Ty, Allocator> result_type;
+		/**
+		 * \brief Factorizes the matrix `a`.
+		 *
+		 * \param a Matrix to factorize.
+		 * \throw Throws `std::invalid_argument` exception if `a.rows() < a.columns()`.
+		 * \complexity Linear in `a.rows()` multiplied by quadratic in `a.columns()`.
+		 */
+		explicit qr_decomposition(matrix_type a)
+			: qr_(std::move(a)) {
+			factorize(nullptr);
+		}
+		explicit qr_decomposition(const result_type& a)
+			: qr_decomposition(a.matrix()) {}
+		/**
+		 * \brief Factorizes the matrix `a`, applying the reflectors of each panel across the threads of `pool`.
+		 *
+		 * \param pool Thread pool on which to execute.
+		 * \param a Matrix to factorize.
+		 * \param cutoff Number of columns of `a` below which the factorization runs serially.
+		 * \throw Throws `std::invalid_argument` exception if `a.rows() < a.columns()`.
+		 * \complexity Linear in `a.rows()` multiplied by quadratic in `a.columns()`, the trailing updates divided
+		 *             across `pool.size() + 1` threads.
+		 */
+		qr_decomposition(thread_pool& pool, matrix_type a, std::size_t cutoff = parallel_cutoffs::decomposition)
+			: qr_(std::move(a)) {
+			factorize(qr_.columns() < cutoff ? nullptr : &pool);
+		}
+		qr_decomposition(thread_pool& pool, const result_type& a, std::size_t cutoff = parallel_cutoffs::decomposition)
+			: qr_decomposition(pool, a.matrix(), cutoff) {}
+		size_type rows() const noexcept { return qr_.rows(); }
+		size_type columns() const noexcept { return qr_.columns(); }
+		/**
+		 * \brief Returns `true` if a diagonal element of `R` is exactly zero, i.e. if the columns of the factorized
+		 *        matrix are linearly dependent, in which case `solve` throws.
+		 */
+		bool is_rank_deficient() const noexcept {
+			for (size_type i = 0; i < columns(); ++i) {
+				if (qr_(i, i) == Ty(0)) return true;
+			}
+			return false;
+		}
+		/**
+		 * \brief Returns `R` and the reflector vectors packed into a single matrix, `R` occupying the upper
+		 *        triangle and the diagonal and the vectors (without their unit leading element) the strict lower
+		 *        triangle.
+		 */
+		const matrix_type& packed_factors() const noexcept { return qr_; }
+		/**
+		 * \brief Returns the scalar factors `tau` of the reflectors.
+		 */
+		const std::vector<value_type>& reflector_scales() const noexcept { return tau_; }
+		/**
+		 * \brief Returns the `columns() x columns()` upper triangular factor `R`.
+		 *
+		 * \complexity Quadratic in `columns()`.
+		 */
+		result_type r() const {
+			const size_type n = columns();
+			result_type r(n, n, value_type(0), qr_.get_allocator());
+			for (size_type i = 0; i < n; ++i) {
+				for (size_type j = i; j < n; ++j) r(i, j) = qr_(i, j);
+			}
+			return r;
+		}
+		/**
+		 * \brief Returns the first `columns()` columns of the orthogonal factor `Q` (the "thin" `Q`), such that
+		 *        `q()*r()` equals the factorized matrix.
+		 *
+		 * \complexity Linear in `rows()` multiplied by quadratic in `columns()`.
+		 */
+		result_type q() const {
+			const size_type m = rows(), n = columns();
+			result_type q(m, n, value_type(0), qr_.get_allocator());
+			for (size_type i = 0; i < n; ++i) q(i, i) = value_type(1);
+			for (size_type k = n; k-- > 0;) apply_reflector(k, q.data(), n);
+			return q;
+		}
+		/**
+		 * \brief Computes the least squares solution `X` minimising the 2-norm of each column of `A*X - B`, which
+		 *        for square `A` is the solution of `A*X = B`.
+		 *
+		 * \param b Right-hand sides, one per column.
+		 * \return Solution `X` of `columns()` rows and `b.columns()` columns.
+		 * \throw Throws `std::invalid_argument` exception if `b.rows() != rows()`, or `std::domain_error`
+		 *        exception if `is_rank_deficient()`.
+		 * \complexity Linear in `rows()*columns()*b.columns()`.
+		 */
+		result_type solve(const result_type& b) const {
+			if (b.rows() != rows())
+				throw std::invalid_argument("qr_decomposition right-hand side must have rows() rows.");
+			result_type x(b);
+			solve_in_place(x.data(), x.columns());
+			x.rows_resize(columns());
+			return x;
+		}
+		/**
+		 * \brief Computes the least squares solution `x` minimising the 2-norm of `A*x - b`.
+		 *
+		 * \throw Throws `std::invalid_argument` exception if `b.size() != rows()`, or `std::domain_error`
+		 *        exception if `is_rank_deficient()`.
+		 * \complexity Linear in `rows()*columns()`.
+		 */
+		std::vector<value_type> solve(std::vector<value_type> b) const {
+			if (b.size() != rows())
+				throw std::invalid_argument("qr_decomposition right-hand side must have rows() elements.");
+			solve_in_place(b.data(), 1U);
+			b.resize(columns());
+			return b;
+		}
+	private:
+		matrix_type qr_;
+		std::vector<value_type> tau_;
+		// columns per chunk of the parallel trailing update
+		static constexpr size_type column_grain = 64U;
+		void factorize(thread_pool* pool) {
+			if (qr_.rows() < qr_.columns())
+				throw std::invalid_argument("qr_decomposition requires a matrix with rows() >= columns().");
+			const size_type m = qr_.rows(), n = qr_.columns();
+			const size_type nb = decomposition_impl::block_size;
+			Ty* a = qr_.data();
+			tau_.assign(n, Ty(0));
+			std::vector<Ty> v, t;
+			for (size_type k0 = 0; k0 < n; k0 += nb) {
+				const size_type k1 = std::min(n, k0 + nb), kb = k1 - k0, mv = m - k0;
+				factorize_panel(a, m, n, k0, k1);
+				if (k1 == n) break;
+				// V with explicit unit diagonal and zeros above it, and T such that H(k0)...H(k1-1) = I - V*T*transpose(V)
+				v.assign(mv*kb, Ty(0));
+				for (size_type r = 0; r < mv; ++r) {
+					for (size_type j = 0; j < kb && j <= r; ++j)
+						v[r*kb + j] = (j == r) ? Ty(1) : a[(k0 + r)*n + k0 + j];
+				}
+				t.assign(kb*kb, Ty(0));
+				for (size_type i = 0; i < kb; ++i) {
+					const Ty tau = tau_[k0 + i];
+					t[i*kb + i] = tau;
+					std::vector<Ty> z(i, Ty(0));
+					for (size_type r = i; r < mv; ++r) {
+						for (size_type j = 0; j < i; ++j) z[j] += v[r*kb + j] * v[r*kb + i];
+					}
+					for (size_type j = 0; j < i; ++j) {
+						Ty s = Ty(0);
+						for (size_type l = j; l < i; ++l) s += t[j*kb + l] * z[l];
+						t[j*kb + i] = -tau*s;
+					}
+				}
+				// C = transpose(I - V*T*transpose(V))*C for the trailing columns C, i.e. C -= V*(transpose(T)*(transpose(V)*C))
+				const Ty* pv = v.data();
+				const Ty* pt = t.data();
+				decomposition_impl::for_each_chunk(pool, k1, n, column_grain, [a, pv, pt, n, k0, kb, mv](size_type first, size_type last) {
+					const size_type w = last - first;
+					std::vector<Ty> wk(kb*w, Ty(0));
+					Ty* c = a + k0*n + first;
+					kernels::gemm(kb, w, mv, pv, 1, kb, c, n, 1, wk.data(), w, 1);
+					for (size_type i = kb; i-- > 0;) {
+						Ty* wi = wk.data() + i*w;
+						kernels::scale(wi, -pt[i*kb + i], wi, w);
+						for (size_type j = 0; j < i; ++j)
+							kernels::axpy(-pt[j*kb + i], wk.data() + j*w, wi, w);
+					}
+					kernels::gemm(mv, w, kb, pv, kb, 1, wk.data(), w, 1, c, n, 1);
+				});
+			}
+		}
+		// unblocked factorization of columns [k0, k1), the reflectors being applied only within the panel
+		void factorize_panel(Ty* a, size_type m, size_type n, size_type k0, size_type k1) {
+			std::vector<Ty> w(k1 - k0);
+			for (size_type k = k0; k < k1; ++k) {
+				const Ty alpha = a[k*n + k];
+				Ty sigma = Ty(0);
+				for (size_type i = k + 1; i < m; ++i) sigma += a[i*n + k] * a[i*n + k];
+				if (sigma == Ty(0)) {
+					tau_[k] = Ty(0);
+					continue;
+				}
+				const Ty norm = std::sqrt(alpha*alpha + sigma);
+				const Ty beta = (alpha >= Ty(0)) ? -norm : norm;
+				tau_[k] = (beta - alpha) / beta;
+				const Ty inv = Ty(1) / (alpha - beta);
+				for (size_type i = k + 1; i < m; ++i) a[i*n + k] *= inv;
+				a[k*n + k] = beta;
+				// w = transpose(v)*A(k:m, k+1:k1) accumulated by rows, then A(k:m, k+1:k1) -= tau*v*w
+				const size_type wn = k1 - k - 1;
+				std::copy(a + k*n + k + 1, a + k*n + k1, w.begin());
+				for (size_type i = k + 1; i < m; ++i)
+					kernels::axpy(a[i*n + k], a + i*n + k + 1, w.data(), wn);
+				kernels::axpy(-tau_[k], w.data(), a + k*n + k + 1, wn);
+				for (size_type i = k + 1; i < m; ++i)
+					kernels::axpy(-tau_[k] * a[i*n + k], w.data(), a + i*n + k + 1, wn);
+			}
+		}
+		// applies H(k) to the rows() by nrhs matrix x
+		void apply_reflector(size_type k, Ty* x, size_type nrhs) const {
+			using decomposition_impl::row;
+			const Ty tau = tau_[k];
+			if (tau == Ty(0)) return;
+			const size_type m = rows(), n = columns();
+			const Ty* a = qr_.data();
+			std::vector<Ty> w(row(x, k, nrhs), row(x, k + 1, nrhs));
+			for (size_type i = k + 1; i < m; ++i)
+				kernels::axpy(a[i*n + k], row(x, i, nrhs), w.data(), nrhs);
+			kernels::axpy(-tau, w.data(), row(x, k, nrhs), nrhs);
+			for (size_type i = k + 1; i < m; ++i)
+				kernels::axpy(-tau*a[i*n + k], w.data(), row(x, i, nrhs), nrhs);
+		}
+		void solve_in_place(Ty* x, size_type nrhs) const {
+			using decomposition_impl::row;
+			if (is_rank_deficient())
+				throw std::domain_error("qr_decomposition of a rank deficient matrix cannot be solved.");
+			const size_type n = columns();
+			const Ty* a = qr_.data();
+			for (size_type k = 0; k < n; ++k) apply_reflector(k, x, nrhs);
+			for (size_type i = n; i-- > 0;) {
+				for (size_type p = i + 1; p < n; ++p)
+					kernels::axpy(-a[i*n + p], row(x, p, nrhs), row(x, i, nrhs), nrhs);
+				kernels::scale(row(x, i, nrhs), Ty(1) / a[i*n + i], row(x, i, nrhs), nrhs);
+			}
+		}
+	};
+	template<typename Ty, class Allocator>
+	constexpr std::size_t qr_decomposition<Ty, Allocator>::column_grain;
+	/**
+	 * \brief Computes the determinant of the square matrix `mdm` via `lu_decomposition`.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `mdm.rows() != mdm.columns()`.
+	 * \complexity Cubic in `mdm.rows()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>
+	> Ty matrix_determinant(const mathematical_dynamic_matrix<Ty, Allocator>& mdm) {
+		return lu_decomposition<Ty, Allocator>(mdm).determinant();
+	}
+	/**
+	 * \brief Computes the inverse of the square matrix `mdm` via `lu_decomposition`.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `mdm.rows() != mdm.columns()`, or `std::domain_error`
+	 *        exception if `mdm` is singular.
+	 * \complexity Cubic in `mdm.rows()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>
+	> mathematical_dynamic_matrix<Ty, Allocator> matrix_inverse(const mathematical_dynamic_matrix<Ty, Allocator>& mdm) {
+		return lu_decomposition<Ty, Allocator>(mdm).inverse();
+	}
+	/**
+	 * \brief Solves `a*X = b` for `X` via `lu_decomposition`. To solve repeatedly with the same `a` construct an
+	 *        `lu_decomposition` once and call its `solve` method instead.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `a.rows() != a.columns() || b.rows() != a.rows()`, or
+	 *        `std::domain_error` exception if `a` is singular.
+	 * \complexity Cubic in `a.rows()` plus quadratic in `a.rows()` multiplied by linear in `b.columns()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>
+	> mathematical_dynamic_matrix<Ty, Allocator> matrix_solve(const mathematical_dynamic_matrix<Ty, Allocator>& a,
+		const mathematical_dynamic_matrix<Ty, Allocator>& b) {
+		return lu_decomposition<Ty, Allocator>(a).solve(b);
+	}
+}
+
+#endif // !MATRIX_DECOMPOSITION_H
@@ -0,0 +1,247 @@
+#ifndef MATRIX_EXPRESSION_H
+#define MATRIX_EXPRESSION_H
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+namespace crsc {
+	/**
+	 * \class matrix_expression
+	 *
+	 * \brief CRTP base of all lazily evaluated elementwise matrix expressions.
+	 *
+	 * Arithmetic on matrix expressions (e.g. `A + B - 2*C`) does not compute anything, it builds a lightweight tree
+	 * of expression nodes recording the operands and operations. The tree is evaluated element by element in a single
+	 * fused loop when it is assigned to a container (such as `crsc::mathematical_dynamic_matrix`), so chained
+	 * arithmetic requires no temporary matrices and only one pass over memory.
+	 *
+	 * Every expression type `Expr` provides:
+	 *
+	 * - `value_type` and `size_type` type definitions.
+	 * - `rows()` and `columns()` giving the dimensions of the expression.
+	 * - `operator()(i, j)` giving the value of element `(i,j)`.
+	 * - `linear_element(k)` giving the value of the `k`-th element in row-major order, only used when all leaf
+	 *   operands of the expression have contiguous row-major storage (see `is_contiguous_expression`).
+	 *
+	 * \warning Expressions hold references to their leaf operands (containers), so an expression must not outlive
+	 *          the containers it was built from - in particular avoid storing expressions in `auto` variables whose
+	 *          leaves are temporaries.
+	 * \tparam Expr The derived expression type.
+	 */
+	template<class Expr>
+	class matrix_expression {
+	public:
+		const Expr& self() const noexcept { return static_cast<const Expr&>(*this); }
+	};
+	/**
+	 * \struct is_contiguous_expression
+	 *
+	 * \brief Trait indicating whether an expression may be evaluated through `linear_element`, i.e. whether every
+	 *        leaf operand stores its elements contiguously in row-major order. Defaults to `true`, leaf types with
+	 *        strided storage specialise this to `std::false_type`.
+	 */
+	template<class Expr>
+	struct is_contiguous_expression : std::true_type {};
+	/**
+	 * \brief Detail namespace for implementation of the matrix expression nodes.
+	 */
+	namespace matrix_expression_impl {
+		// leaves (containers) are held by reference, expression nodes are cheap and held by value such that
+		// temporaries created while building an expression survive until it is evaluated
+		template<class Expr>
+		struct operand {
+			typedef const Expr& type;
+		};
+		struct plus {
+			template<typename Ty> static Ty apply(const Ty& lhs, const Ty& rhs) { return lhs + rhs; }
+		};
+		struct minus {
+			template<typename Ty> static Ty apply(const Ty& lhs, const Ty& rhs) { return lhs - rhs; }
+		};
+		struct multiplies {
+			template<typename Ty> static Ty apply(const Ty& lhs, const Ty& rhs) { return lhs * rhs; }
+		};
+		struct divides {
+			template<typename Ty> static Ty apply(const Ty& lhs, const Ty& rhs) { return lhs / rhs; }
+		};
+		struct negate {
+			template<typename Ty> static Ty apply(const Ty& val) { return -val; }
+		};
+	}
+	/**
+	 * \class matrix_binary_expression
+	 *
+	 * \brief Expression node applying the elementwise operation `Op` to two expressions of equal dimensions.
+	 */
+	template<class Lhs, class Rhs, class Op>
+	class matrix_binary_expression : public matrix_expression<matrix_binary_expression<Lhs, Rhs, Op>> {
+	public:
+		typedef typename Lhs::value_type value_type;
+		typedef typename Lhs::size_type size_type;
+		/**
+		 * \brief Constructs the node from its operands.
+		 *
+		 * \throw Throws `std::invalid_argument` exception if the dimensions of `_lhs` and `_rhs` do not agree.
+		 */
+		matrix_binary_expression(const Lhs& _lhs, const Rhs& _rhs)
+			: lhs(_lhs), rhs(_rhs) {
+			if (lhs.rows() != rhs.rows() || lhs.columns() != rhs.columns())
+				throw std::invalid_argument("matrix_expression dimensions must agree for component-wise operations.");
+		}
+		size_type rows() const noexcept { return lhs.rows(); }
+		size_type columns() const noexcept { return lhs.columns(); }
+		value_type operator()(size_type i, size_type j) const { return Op::apply(lhs(i, j), rhs(i, j)); }
+		value_type linear_element(size_type k) const { return Op::apply(lhs.linear_element(k), rhs.linear_element(k)); }
+		const Lhs& left() const noexcept { return lhs; }
+		const Rhs& right() const noexcept { return rhs; }
+	private:
+		typename matrix_expression_impl::operand<Lhs>::type lhs;
+		typename matrix_expression_impl::operand<Rhs>::type rhs;
+	};
+	/**
+	 * \class matrix_scalar_expression
+	 *
+	 * \brief Expression node applying the elementwise operation `Op` to each element of an expression and a scalar,
+	 *        i.e. `Op::apply(expr(i,j), scalar)`.
+	 */
+	template<class Expr, class Op>
+	class matrix_scalar_expression : public matrix_expression<matrix_scalar_expression<Expr, Op>> {
+	public:
+		typedef typename Expr::value_type value_type;
+		typedef typename Expr::size_type size_type;
+		matrix_scalar_expression(const Expr& _expr, const value_type& _scalar)
+			: expr(_expr), scalar(_scalar) {}
+		size_type rows() const noexcept { return expr.rows(); }
+		size_type columns() const noexcept { return expr.columns(); }
+		value_type operator()(size_type i, size_type j) const { return Op::apply(expr(i, j), scalar); }
+		value_type linear_element(size_type k) const { return Op::apply(expr.linear_element(k), scalar); }
+	private:
+		typename matrix_expression_impl::operand<Expr>::type expr;
+		value_type scalar;
+	};
+	/**
+	 * \class matrix_unary_expression
+	 *
+	 * \brief Expression node applying the elementwise operation `Op` to each element of an expression.
+	 */
+	template<class Expr, class Op>
+	class matrix_unary_expression : public matrix_expression<matrix_unary_expression<Expr, Op>> {
+	public:
+		typedef typename Expr::value_type value_type;
+		typedef typename Expr::size_type size_type;
+		explicit matrix_unary_expression(const Expr& _expr)
+			: expr(_expr) {}
+		size_type rows() const noexcept { return expr.rows(); }
+		size_type columns() const noexcept { return expr.columns(); }
+		value_type operator()(size_type i, size_type j) const { return Op::apply(expr(i, j)); }
+		value_type linear_element(size_type k) const { return Op::apply(expr.linear_element(k)); }
+	private:
+		typename matrix_expression_impl::operand<Expr>::type expr;
+	};
+	namespace matrix_expression_impl {
+		template<class Lhs, class Rhs, class Op>
+		struct operand<matrix_binary_expression<Lhs, Rhs, Op>> {
+			typedef matrix_binary_expression<Lhs, Rhs, Op> type;
+		};
+		template<class Expr, class Op>
+		struct operand<matrix_scalar_expression<Expr, Op>> {
+			typedef matrix_scalar_expression<Expr, Op> type;
+		};
+		template<class Expr, class Op>
+		struct operand<matrix_unary_expression<Expr, Op>> {
+			typedef matrix_unary_expression<Expr, Op> type;
+		};
+	}
+	template<class Lhs, class Rhs, class Op>
+	struct is_contiguous_expression<matrix_binary_expression<Lhs, Rhs, Op>>
+		: std::integral_constant<bool, is_contiguous_expression<Lhs>::value && is_contiguous_expression<Rhs>::value> {};
+	template<class Expr, class Op>
+	struct is_contiguous_expression<matrix_scalar_expression<Expr, Op>> : is_contiguous_expression<Expr> {};
+	template<class Expr, class Op>
+	struct is_contiguous_expression<matrix_unary_expression<Expr, Op>> : is_contiguous_expression<Expr> {};
+	/**
+	 * \brief Evaluates the expression `expr` into the row-major storage `out` of `expr.rows()*expr.columns()`
+	 *        elements using a single fused loop.
+	 *
+	 * \remark `out` may be the storage of a leaf of `expr` as every element of the result depends only upon the
+	 *         elements at the same position in the operands.
+	 * \complexity Linear in `expr.rows()*expr.columns()`.
+	 */
+	template<class Expr>
+	void evaluate_expression(const matrix_expression<Expr>& expr, typename Expr::value_type* out) {
+		const Expr& e = expr.self();
+		typedef typename Expr::size_type size_type;
+		if (is_contiguous_expression<Expr>::value) {
+			const size_type n = e.rows()*e.columns();
+			for (size_type k = 0; k < n; ++k)
+				out[k] = e.linear_element(k);
+		}
+		else {
+			for (size_type i = 0; i < e.rows(); ++i) {
+				for (size_type j = 0; j < e.columns(); ++j)
+					*out++ = e(i, j);
+			}
+		}
+	}
+	/**
+	 * \brief Lazy component-wise addition of two matrix expressions.
+	 * \throw Throws `std::invalid_argument` exception if the dimensions of `lhs` and `rhs` do not agree.
+	 */
+	template<class Lhs, class Rhs>
+	matrix_binary_expression<Lhs, Rhs, matrix_expression_impl::plus>
+	operator+(const matrix_expression<Lhs>& lhs, const matrix_expression<Rhs>& rhs) {
+		return matrix_binary_expression<Lhs, Rhs, matrix_expression_impl::plus>(lhs.self(), rhs.self());
+	}
+	/**
+	 * \brief Lazy component-wise subtraction of two matrix expressions.
+	 * \throw Throws `std::invalid_argument` exception if the dimensions of `lhs` and `rhs` do not agree.
+	 */
+	template<class Lhs, class Rhs>
+	matrix_binary_expression<Lhs, Rhs, matrix_expression_impl::minus>
+	operator-(const matrix_expression<Lhs>& lhs, const matrix_expression<Rhs>& rhs) {
+		return matrix_binary_expression<Lhs, Rhs, matrix_expression_impl::minus>(lhs.self(), rhs.self());
+	}
+	/**
+	 * \brief Lazy component-wise (Hadamard) product of two matrix expressions.
+	 * \throw Throws `std::invalid_argument` exception if the dimensions of `lhs` and `rhs` do not agree.
+	 */
+	template<class Lhs, class Rhs>
+	matrix_binary_expression<Lhs, Rhs, matrix_expression_impl::multiplies>
+	hadamard_product(const matrix_expression<Lhs>& lhs, const matrix_expression<Rhs>& rhs) {
+		return matrix_binary_expression<Lhs, Rhs, matrix_expression_impl::multiplies>(lhs.self(), rhs.self());
+	}
+	/**
+	 * \brief Lazy negation of a matrix expression.
+	 */
+	template<class Expr>
+	matrix_unary_expression<Expr, matrix_expression_impl::negate>
+	operator-(const matrix_expression<Expr>& expr) {
+		return matrix_unary_expression<Expr, matrix_expression_impl::negate>(expr.self());
+	}
+	/**
+	 * \brief Lazy multiplication of every element of a matrix expression by a scalar.
+	 */
+	template<class Expr>
+	matrix_scalar_expression<Expr, matrix_expression_impl::multiplies>
+	operator*(const matrix_expression<Expr>& expr, const typename Expr::value_type& scalar) {
+		return matrix_scalar_expression<Expr, matrix_expression_impl::multiplies>(expr.self(), scalar);
+	}
+	/**
+	 * \brief Lazy multiplication of every element of a matrix expression by a scalar.
+	 */
+	template<class Expr>
+	matrix_scalar_expression<Expr, matrix_expression_impl::multiplies>
+	operator*(const typename Expr::value_type& scalar, const matrix_expression<Expr>& expr) {
+		return matrix_scalar_expression<Expr, matrix_expression_impl::multiplies>(expr.self(), scalar);
+	}
+	/**
+	 * \brief Lazy division of every element of a matrix expression by a scalar.
+	 */
+	template<class Expr>
+	matrix_scalar_expression<Expr, matrix_expression_impl::divides>
+	operator/(const matrix_expression<Expr>& expr, const typename Expr::value_type& scalar) {
+		return matrix_scalar_expression<Expr, matrix_expression_impl::divides>(expr.self(), scalar);
+	}
+}
+
+#endif // !MATRIX_EXPRESSION_H
@@ -0,0 +1,628 @@
+#ifndef MATRIX_IO_H
+#define MATRIX_IO_H
+#include "dynamic_matrix.h"
+#include "fixed_matrix.h"
+#include "matrix_layout.h"
+#include "matrix_view.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace crsc {
+	/**
+	 * \brief Type tag of the elements stored in a matrix file.
+	 */
+	enum class matrix_element_type : std::uint32_t {
+		unsupported = 0U,
+		int8 = 1U, int16 = 2U, int32 = 3U, int64 = 4U,
+		uint8 = 5U, uint16 = 6U, uint32 = 7U, uint64 = 8U,
+		float32 = 9U, float64 = 10U,
+		boolean = 11U
+	};
+	/**
+	 * \brief Layout tag of the elements stored in a matrix file, see matrix_layout.h.
+	 */
+	enum class matrix_file_layout : std::uint32_t {
+		row_major = 0U,
+		column_major = 1U,
+		tiled = 2U
+	};
+	/**
+	 * \struct matrix_file_header
+	 *
+	 * \brief The 64 byte header at the start of every matrix file.
+	 *
+	 * A matrix file is the header, zero padding up to `data_offset` and the `rows*cols` elements in the storage
+	 * order of the layout, exactly as they are held by a `dynamic_matrix` of that layout. `data_offset` is a multiple
+	 * of `alignment`, so the elements of a file mapped into memory by `mapped_matrix` are at least `alignment` byte
+	 * aligned. Fields are in the byte order of the machine which wrote the file, recorded by `byte_order`.
+	 */
+	struct matrix_file_header {
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t byte_order;
+		std::uint32_t element_type;
+		std::uint32_t element_size;
+		std::uint32_t layout;
+		std::uint32_t alignment;
+		std::uint64_t tile_size;
+		std::uint64_t rows;
+		std::uint64_t cols;
+		std::uint64_t data_offset;
+	};
+	static_assert(sizeof(matrix_file_header) == 64U, "matrix_file_header must occupy 64 bytes.");
+	/**
+	 * \brief Detail namespace for implementation of matrix files.
+	 */
+	namespace matrix_io_impl {
+		constexpr char magic[8] = { 'C', 'R', 'S', 'C', 'M', 'T', 'X', '\0' };
+		constexpr std::uint32_t version = 1U;
+		constexpr std::uint32_t byte_order = 0x01020304U;
+		constexpr std::size_t default_alignment = 64U;
+		template<typename Ty>
+		constexpr matrix_element_type element_type() noexcept {
+			return std::is_same<Ty, bool>::value ? matrix_element_type::boolean
+				: std::is_floating_point<Ty>::value
+					? (sizeof(Ty) == 4U ? matrix_element_type::float32
+						: sizeof(Ty) == 8U ? matrix_element_type::float64 : matrix_element_type::unsupported)
+				: std::is_integral<Ty>::value
+					? (sizeof(Ty) == 1U ? (std::is_signed<Ty>::value ? matrix_element_type::int8 : matrix_element_type::uint8)
+						: sizeof(Ty) == 2U ? (std::is_signed<Ty>::value ? matrix_element_type::int16 : matrix_element_type::uint16)
+						: sizeof(Ty) == 4U ? (std::is_signed<Ty>::value ? matrix_element_type::int32 : matrix_element_type::uint32)
+						: sizeof(Ty) == 8U ? (std::is_signed<Ty>::value ? matrix_element_type::int64 : matrix_element_type::uint64)
+						: matrix_element_type::unsupported)
+				: matrix_element_type::unsupported;
+		}
+		template<class Layout>
+		struct layout_tag;
+		template<>
+		struct layout_tag<row_major> {
+			static matrix_file_layout layout() noexcept { return matrix_file_layout::row_major; }
+			static std::uint64_t tile_size() noexcept { return 0U; }
+		};
+		template<>
+		struct layout_tag<column_major> {
+			static matrix_file_layout layout() noexcept { return matrix_file_layout::column_major; }
+			static std::uint64_t tile_size() noexcept { return 0U; }
+		};
+		template<std::size_t TileSize>
+		struct layout_tag<tiled<TileSize>> {
+			static matrix_file_layout layout() noexcept { return matrix_file_layout::tiled; }
+			static std::uint64_t tile_size() noexcept { return TileSize; }
+		};
+		template<class Layout>
+		bool same_layout(const matrix_file_header& h) noexcept {
+			return h.layout == static_cast<std::uint32_t>(layout_tag<Layout>::layout()) && h.tile_size == layout_tag<Layout>::tile_size();
+		}
+		// storage offset of element (i,j) in the layout described by h
+		inline std::size_t offset(const matrix_file_header& h, std::size_t i, std::size_t j) noexcept {
+			const std::size_t rows = static_cast<std::size_t>(h.rows);
+			const std::size_t cols = static_cast<std::size_t>(h.cols);
+			switch (static_cast<matrix_file_layout>(h.layout)) {
+			case matrix_file_layout::column_major:
+				return column_major::offset(i, j, rows, cols);
+			case matrix_file_layout::tiled: {
+				const std::size_t tile = static_cast<std::size_t>(h.tile_size);
+				const std::size_t ti = i / tile*tile;
+				const std::size_t tj = j / tile*tile;
+				const std::size_t height = std::min(tile, rows - ti);
+				const std::size_t width = std::min(tile, cols - tj);
+				return ti*cols + tj*height + (i - ti)*width + (j - tj);
+			}
+			default:
+				return row_major::offset(i, j, rows, cols);
+			}
+		}
+		template<typename Ty, class Layout>
+		matrix_file_header make_header(std::size_t rows, std::size_t cols, std::size_t alignment) {
+			if (!alignment || (alignment & (alignment - 1U)) || alignment < alignof(Ty))
+				throw std::invalid_argument("Matrix file alignment must be a power of two no less than alignof(Ty).");
+			matrix_file_header h;
+			std::memcpy(h.magic, magic, sizeof(magic));
+			h.version = version;
+			h.byte_order = byte_order;
+			h.element_type = static_cast<std::uint32_t>(element_type<Ty>());
+			h.element_size = static_cast<std::uint32_t>(sizeof(Ty));
+			h.layout = static_cast<std::uint32_t>(layout_tag<Layout>::layout());
+			h.alignment = static_cast<std::uint32_t>(alignment);
+			h.tile_size = layout_tag<Layout>::tile_size();
+			h.rows = rows;
+			h.cols = cols;
+			h.data_offset = (sizeof(matrix_file_header) + alignment - 1U) / alignment*alignment;
+			return h;
+		}
+		// validates a header read from a file of file_size bytes (or unknown size if file_size is max) for elements of type Ty
+		template<typename Ty>
+		std::size_t validate(const matrix_file_header& h, std::uint64_t file_size) {
+			if (std::memcmp(h.magic, magic, sizeof(magic)) || h.version != version)
+				throw std::runtime_error("Not a crescent matrix file.");
+			if (h.byte_order != byte_order)
+				throw std::runtime_error("Matrix file was written with a different byte order.");
+			if (h.element_type != static_cast<std::uint32_t>(element_type<Ty>()) || h.element_size != sizeof(Ty))
+				throw std::runtime_error("Matrix file element type does not match the requested element type.");
+			if (h.layout > static_cast<std::uint32_t>(matrix_file_layout::tiled)
+				|| (h.layout == static_cast<std::uint32_t>(matrix_file_layout::tiled)) != (h.tile_size != 0U))
+				throw std::runtime_error("Matrix file has an invalid layout.");
+			const std::uint64_t max = std::numeric_limits<std::size_t>::max() / sizeof(Ty);
+			if (h.rows > max || h.cols > max || (h.cols && h.rows > max / h.cols))
+				throw std::runtime_error("Matrix file has invalid dimensions.");
+			// mapped_matrix reinterprets the bytes at data_offset as Ty, so the offset must honour the stated alignment
+			if (!h.alignment || (h.alignment & (h.alignment - 1U)) || h.data_offset < sizeof(matrix_file_header)
+				|| h.data_offset % alignof(Ty) || h.data_offset % h.alignment)
+				throw std::runtime_error("Matrix file has an invalid data offset.");
+			const std::uint64_t bytes = h.rows*h.cols*sizeof(Ty);
+			if (h.data_offset > file_size || bytes > file_size - h.data_offset)
+				throw std::runtime_error("Matrix file is truncated.");
+			return static_cast<std::size_t>(h.rows*h.cols);
+		}
+		inline void read_bytes(std::istream& is, void* dst, std::size_t n) {
+			// read in chunks such that each count fits std::streamsize
+			char* p = static_cast<char*>(dst);
+			const std::size_t chunk = static_cast<std::size_t>(1U) << 30U;
+			while (n) {
+				const std::size_t count = std::min(n, chunk);
+				if (!is.read(p, static_cast<std::streamsize>(count)))
+					throw std::runtime_error("Matrix file is truncated.");
+				p += count;
+				n -= count;
+			}
+		}
+		inline void write_bytes(std::ostream& os, const void* src, std::size_t n) {
+			const char* p = static_cast<const char*>(src);
+			const std::size_t chunk = static_cast<std::size_t>(1U) << 30U;
+			while (n) {
+				const std::size_t count = std::min(n, chunk);
+				if (!os.write(p, static_cast<std::streamsize>(count)))
+					throw std::runtime_error("Failed to write matrix file.");
+				p += count;
+				n -= count;
+			}
+		}
+	}
+	/**
+	 * \brief Writes `_dm` to `_os` in the binary matrix file format (see `matrix_file_header`), with its elements
+	 *        in the storage order of `Layout` starting at an offset which is a multiple of `_alignment`.
+	 *
+	 * The stream must have been opened in binary mode.
+	 *
+	 * \param _dm Matrix to write, of an arithmetic element type.
+	 * \param _os Output stream to write to.
+	 * \param _alignment Alignment of the elements within the file in bytes, a power of two.
+	 * \throw Throws `std::invalid_argument` exception if `_alignment` is not a power of two or less than `alignof(Ty)`,
+	 *        throws `std::runtime_error` exception if writing fails.
+	 * \complexity Linear in `_dm.size()`, a single write of the contiguous storage of `_dm`.
+	 */
+	template<typename Ty, class Allocator, class Layout>
+	void save_matrix(const dynamic_matrix<Ty, Allocator, Layout>& _dm, std::ostream& _os,
+		std::size_t _alignment = matrix_io_impl::default_alignment) {
+		static_assert(matrix_io_impl::element_type<Ty>() != matrix_element_type::unsupported,
+			"save_matrix requires an arithmetic element type of size 1, 2, 4 or 8 bytes.");
+		const matrix_file_header h = matrix_io_impl::make_header<Ty, Layout>(_dm.rows(), _dm.columns(), _alignment);
+		matrix_io_impl::write_bytes(_os, &h, sizeof(h));
+		const std::vector<char> padding(static_cast<std::size_t>(h.data_offset) - sizeof(h), '\0');
+		matrix_io_impl::write_bytes(_os, padding.data(), padding.size());
+		matrix_io_impl::write_bytes(_os, _dm.data(), _dm.size()*sizeof(Ty));
+	}
+	/**
+	 * \brief Writes `_dm` to the file `_filename`, replacing any existing contents, in the binary matrix file
+	 *        format (see `matrix_file_header`).
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `_alignment` is not a power of two or less than `alignof(Ty)`,
+	 *        throws `std::runtime_error` exception if the file cannot be opened or written.
+	 * \complexity Linear in `_dm.size()`.
+	 */
+	template<typename Ty, class Allocator, class Layout>
+	void save_matrix(const dynamic_matrix<Ty, Allocator, Layout>& _dm, const std::string& _filename,
+		std::size_t _alignment = matrix_io_impl::default_alignment) {
+		std::ofstream ofs(_filename, std::ios::binary | std::ios::trunc);
+		if (!ofs) throw std::runtime_error("Failed to open file: " + _filename + " for writing.");
+		save_matrix(_dm, ofs, _alignment);
+		ofs.close();
+		if (!ofs) throw std::runtime_error("Failed to write file: " + _filename + ".");
+	}
+	/**
+	 * \brief Reads the header of a matrix file from `_is`, leaving the stream positioned after the header.
+	 *
+	 * \throw Throws `std::runtime_error` exception if the stream does not begin with a matrix file header.
+	 */
+	inline matrix_file_header read_matrix_header(std::istream& _is) {
+		matrix_file_header h;
+		matrix_io_impl::read_bytes(_is, &h, sizeof(h));
+		if (std::memcmp(h.magic, matrix_io_impl::magic, sizeof(h.magic)))
+			throw std::runtime_error("Not a crescent matrix file.");
+		return h;
+	}
+	/**
+	 * \brief Reads the header of the matrix file `_filename`, e.g. to inspect its dimensions and element type
+	 *        before loading or mapping it.
+	 *
+	 * \throw Throws `std::runtime_error` exception if the file cannot be opened or is not a matrix file.
+	 */
+	inline matrix_file_header read_matrix_header(const std::string& _filename) {
+		std::ifstream ifs(_filename, std::ios::binary);
+		if (!ifs) throw std::runtime_error("Failed to open file: " + _filename + " for reading.");
+		return read_matrix_header(ifs);
+	}
+	/**
+	 * \brief Reads a matrix written by `save_matrix` from `_is` into a new `dynamic_matrix`.
+	 *
+	 * If the layout recorded in the file differs from `Layout` the elements are rearranged into `Layout`.
+	 *
+	 * \tparam Ty Element type, which must match the element type recorded in the file.
+	 * \tparam Allocator Allocator of the result.
+	 * \tparam Layout Layout of the result.
+	 * \param _is Input stream positioned at the start of a matrix file, opened in binary mode.
+	 * \return `dynamic_matrix` holding the elements of the file.
+	 * \throw Throws `std::runtime_error` exception if the stream does not hold a valid matrix file of elements of
+	 *        type `Ty` or is truncated.
+	 * \complexity Linear in the number of elements, a single read when the layouts match.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout> load_matrix(std::istream& _is) {
+		static_assert(matrix_io_impl::element_type<Ty>() != matrix_element_type::unsupported,
+			"load_matrix requires an arithmetic element type of size 1, 2, 4 or 8 bytes.");
+		const matrix_file_header h = read_matrix_header(_is);
+		const std::size_t n = matrix_io_impl::validate<Ty>(h, std::numeric_limits<std::uint64_t>::max());
+		_is.ignore(static_cast<std::streamsize>(h.data_offset - sizeof(h)));
+		dynamic_matrix<Ty, Allocator, Layout> dm(static_cast<std::size_t>(h.rows), static_cast<std::size_t>(h.cols));
+		if (matrix_io_impl::same_layout<Layout>(h)) {
+			matrix_io_impl::read_bytes(_is, dm.data(), n*sizeof(Ty));
+		}
+		else {
+			std::vector<Ty> buffer(n);
+			matrix_io_impl::read_bytes(_is, buffer.data(), n*sizeof(Ty));
+			Ty* out = dm.data();
+			Layout::for_each_index(dm.rows(), dm.columns(), [&h, &buffer, &out](std::size_t i, std::size_t j) {
+				*out++ = buffer[matrix_io_impl::offset(h, i, j)];
+			});
+		}
+		return dm;
+	}
+	/**
+	 * \brief Reads the matrix file `_filename` written by `save_matrix` into a new `dynamic_matrix`.
+	 *
+	 * \throw Throws `std::runtime_error` exception if the file cannot be opened, or does not hold a valid matrix
+	 *        file of elements of type `Ty`.
+	 * \complexity Linear in the number of elements.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout> load_matrix(const std::string& _filename) {
+		std::ifstream ifs(_filename, std::ios::binary);
+		if (!ifs) throw std::runtime_error("Failed to open file: " + _filename + " for reading.");
+		return load_matrix<Ty, Allocator, Layout>(ifs);
+	}
+	/**
+	 * \brief Writes the `_count` matrices of the array `_first` to `_os` in the binary matrix file format (see
+	 *        `matrix_file_header`), as the row-major `(_count*Rows) x Cols` matrix formed by stacking them.
+	 *
+	 * `fixed_matrix` of arithmetic elements is trivially copyable and holds its elements with no padding, so the
+	 * array is written as a single block of bytes. The file may equally be read by `load_matrix`.
+	 *
+	 * \param _first Pointer to the first of `_count` contiguous matrices, e.g. `v.data()` of a `std::vector`.
+	 * \param _count Number of matrices.
+	 * \param _os Output stream to write to, opened in binary mode.
+	 * \param _alignment Alignment of the elements within the file in bytes, a power of two.
+	 * \throw Throws `std::invalid_argument` exception if `_alignment` is not a power of two or less than `alignof(Ty)`,
+	 *        throws `std::runtime_error` exception if writing fails.
+	 * \complexity Linear in `_count*Rows*Cols`.
+	 */
+	template<typename Ty, std::size_t Rows, std::size_t Cols>
+	void save_fixed_matrices(const fixed_matrix<Ty, Rows, Cols>* _first, std::size_t _count, std::ostream& _os,
+		std::size_t _alignment = matrix_io_impl::default_alignment) {
+		static_assert(matrix_io_impl::element_type<Ty>() != matrix_element_type::unsupported,
+			"save_fixed_matrices requires an arithmetic element type of size 1, 2, 4 or 8 bytes.");
+		static_assert(std::is_trivially_copyable<fixed_matrix<Ty, Rows, Cols>>::value
+			&& sizeof(fixed_matrix<Ty, Rows, Cols>) == Rows*Cols*sizeof(Ty), "save_fixed_matrices requires unpadded, trivially copyable matrices.");
+		const matrix_file_header h = matrix_io_impl::make_header<Ty, row_major>(_count*Rows, Cols, _alignment);
+		matrix_io_impl::write_bytes(_os, &h, sizeof(h));
+		const std::vector<char> padding(static_cast<std::size_t>(h.data_offset) - sizeof(h), '\0');
+		matrix_io_impl::write_bytes(_os, padding.data(), padding.size());
+		matrix_io_impl::write_bytes(_os, _first, _count*sizeof(fixed_matrix<Ty, Rows, Cols>));
+	}
+	/**
+	 * \brief Writes the `_count` matrices of the array `_first` to the file `_filename`, replacing any existing
+	 *        contents, as for `save_fixed_matrices` to a stream.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `_alignment` is not a power of two or less than `alignof(Ty)`,
+	 *        throws `std::runtime_error` exception if the file cannot be opened or written.
+	 * \complexity Linear in `_count*Rows*Cols`.
+	 */
+	template<typename Ty, std::size_t Rows, std::size_t Cols>
+	void save_fixed_matrices(const fixed_matrix<Ty, Rows, Cols>* _first, std::size_t _count, const std::string& _filename,
+		std::size_t _alignment = matrix_io_impl::default_alignment) {
+		std::ofstream ofs(_filename, std::ios::binary | std::ios::trunc);
+		if (!ofs) throw std::runtime_error("Failed to open file: " + _filename + " for writing.");
+		save_fixed_matrices(_first, _count, ofs, _alignment);
+		ofs.close();
+		if (!ofs) throw std::runtime_error("Failed to write file: " + _filename + ".");
+	}
+	/**
+	 * \brief Reads a sequence of `Rows x Cols` matrices written by `save_fixed_matrices` (or any matrix file of
+	 *        `Cols` columns and a multiple of `Rows` rows, taken as the matrices stacked vertically) from `_is`.
+	 *
+	 * A row-major file is read directly into the storage of the result in a single read, other layouts are
+	 * rearranged as for `load_matrix`.
+	 *
+	 * \tparam Ty Element type, which must match the element type recorded in the file.
+	 * \param _is Input stream positioned at the start of a matrix file, opened in binary mode.
+	 * \return `std::vector` of the matrices of the file, in order.
+	 * \throw Throws `std::runtime_error` exception if the stream does not hold a valid matrix file of elements of
+	 *        type `Ty` whose dimensions are those of a sequence of `Rows x Cols` matrices, or is truncated.
+	 * \complexity Linear in the number of elements.
+	 */
+	template<typename Ty, std::size_t Rows, std::size_t Cols>
+	std::vector<fixed_matrix<Ty, Rows, Cols>> load_fixed_matrices(std::istream& _is) {
+		static_assert(matrix_io_impl::element_type<Ty>() != matrix_element_type::unsupported,
+			"load_fixed_matrices requires an arithmetic element type of size 1, 2, 4 or 8 bytes.");
+		static_assert(std::is_trivially_copyable<fixed_matrix<Ty, Rows, Cols>>::value && Rows > 0U && Cols > 0U
+			&& sizeof(fixed_matrix<Ty, Rows, Cols>) == Rows*Cols*sizeof(Ty), "load_fixed_matrices requires unpadded, trivially copyable matrices.");
+		const matrix_file_header h = read_matrix_header(_is);
+		const std::size_t n = matrix_io_impl::validate<Ty>(h, std::numeric_limits<std::uint64_t>::max());
+		if (h.cols != Cols || h.rows % Rows)
+			throw std::runtime_error("Matrix file dimensions are not those of a sequence of fixed_matrix.");
+		_is.ignore(static_cast<std::streamsize>(h.data_offset - sizeof(h)));
+		std::vector<fixed_matrix<Ty, Rows, Cols>> matrices(static_cast<std::size_t>(h.rows) / Rows);
+		if (matrix_io_impl::same_layout<row_major>(h)) {
+			matrix_io_impl::read_bytes(_is, matrices.data(), n*sizeof(Ty));
+		}
+		else {
+			std::vector<Ty> buffer(n);
+			matrix_io_impl::read_bytes(_is, buffer.data(), n*sizeof(Ty));
+			for (std::size_t b = 0; b < matrices.size(); ++b) {
+				for (std::size_t i = 0; i < Rows; ++i)
+					for (std::size_t j = 0; j < Cols; ++j)
+						matrices[b](i, j) = buffer[matrix_io_impl::offset(h, b*Rows + i, j)];
+			}
+		}
+		return matrices;
+	}
+	/**
+	 * \brief Reads the matrix file `_filename` written by `save_fixed_matrices` into a `std::vector` of matrices.
+	 *
+	 * \throw Throws `std::runtime_error` exception if the file cannot be opened, or does not hold a valid matrix
+	 *        file of elements of type `Ty` whose dimensions are those of a sequence of `Rows x Cols` matrices.
+	 * \complexity Linear in the number of elements.
+	 */
+	template<typename Ty, std::size_t Rows, std::size_t Cols>
+	std::vector<fixed_matrix<Ty, Rows, Cols>> load_fixed_matrices(const std::string& _filename) {
+		std::ifstream ifs(_filename, std::ios::binary);
+		if (!ifs) throw std::runtime_error("Failed to open file: " + _filename + " for reading.");
+		return load_fixed_matrices<Ty, Rows, Cols>(ifs);
+	}
+	/**
+	 * \class mapped_matrix
+	 *
+	 * \brief A matrix file written by `save_matrix` mapped into memory, such that its elements are paged in from
+	 *        the file on first access rather than read up front.
+	 *
+	 * A `mapped_matrix<const Ty>` is a read-only mapping shared with the page cache. A `mapped_matrix<Ty>` is a
+	 * private copy-on-write mapping: its elements may be modified, the operating system copying each page on its
+	 * first write, and modifications are never written back to the file. In both cases opening a file of any size
+	 * is constant time and pages which are never accessed are never read.
+	 *
+	 * For strided layouts `view()` gives a `matrix_block_view` of the elements, usable in matrix expressions
+	 * and with the kernels of matrix_kernels.h.
+	 *
+	 * \warning Truncating or modifying the file while it is mapped results in undefined behaviour.
+	 * \tparam Ty Type of the elements, `const`-qualified for a read-only mapping.
+	 * \tparam Layout Storage layout of the elements, which must match the layout recorded in the file.
+	 */
+	template<typename Ty,
+		class Layout = row_major
+	> class mapped_matrix {
+	public:
+		// PUBLIC API TYPE DEFINITIONS
+		typedef std::remove_cv_t<Ty> value_type;
+		typedef Ty& reference;
+		typedef const Ty& const_reference;
+		typedef Ty* pointer;
+		typedef const Ty* const_pointer;
+		typedef std::size_t size_type;
+		typedef Layout layout_type;
+		static_assert(matrix_io_impl::element_type<value_type>() != matrix_element_type::unsupported,
+			"mapped_matrix requires an arithmetic element type of size 1, 2, 4 or 8 bytes.");
+		// CONSTRUCTION/ASSIGNMENT
+		/**
+		 * \brief Maps the matrix file `_filename` into memory.
+		 *
+		 * \throw Throws `std::runtime_error` exception if the file cannot be opened or mapped, does not hold a valid
+		 *        matrix file of elements of type `Ty`, or its layout is not `Layout`.
+		 * \complexity Constant, no elements are read.
+		 */
+		explicit mapped_matrix(const std::string& _filename) {
+			std::uint64_t file_size = 0U;
+			map(_filename, file_size);
+			matrix_file_header h;
+			try {
+				if (file_size < sizeof(h)) throw std::runtime_error("Not a crescent matrix file.");
+				std::memcpy(&h, base, sizeof(h));
+				matrix_io_impl::validate<value_type>(h, file_size);
+				if (!matrix_io_impl::same_layout<Layout>(h))
+					throw std::runtime_error("Matrix file layout does not match the layout of the mapped_matrix.");
+			}
+			catch (...) {
+				unmap();
+				throw;
+			}
+			ptr = reinterpret_cast<pointer>(static_cast<char*>(base) + h.data_offset);
+			rows_ = static_cast<size_type>(h.rows);
+			cols_ = static_cast<size_type>(h.cols);
+		}
+		mapped_matrix(const mapped_matrix&) = delete;
+		/**
+		 * \brief Move constructor, transfers the mapping of `_other` to this, leaving `_other` empty.
+		 */
+		mapped_matrix(mapped_matrix&& _other) noexcept
+			: base(_other.base), length(_other.length), ptr(_other.ptr), rows_(_other.rows_), cols_(_other.cols_) {
+			_other.release();
+		}
+		~mapped_matrix() { unmap(); }
+		mapped_matrix& operator=(const mapped_matrix&) = delete;
+		/**
+		 * \brief Move assignment operator, unmaps the file mapped by this and transfers the mapping of `_other`.
+		 */
+		mapped_matrix& operator=(mapped_matrix&& _other) noexcept {
+			if (this != &_other) {
+				unmap();
+				base = _other.base;
+				length = _other.length;
+				ptr = _other.ptr;
+				rows_ = _other.rows_;
+				cols_ = _other.cols_;
+				_other.release();
+			}
+			return *this;
+		}
+		// CAPACITY
+		size_type rows() const noexcept { return rows_; }
+		size_type columns() const noexcept { return cols_; }
+		size_type size() const noexcept { return rows_*cols_; }
+		bool empty() const noexcept { return !size(); }
+		// ELEMENT ACCESS
+		/**
+		 * \brief Gets reference to the element at the specified row-column indices.
+		 *
+		 * \throw Throws `std::out_of_range` exception if `_row_index >= rows() || _col_index >= columns()`.
+		 * \complexity Constant.
+		 */
+		reference at(size_type _row_index, size_type _col_index) const {
+			if (_row_index >= rows_ || _col_index >= cols_)
+				throw std::out_of_range("mapped_matrix indices out of bounds.");
+			return (*this)(_row_index, _col_index);
+		}
+		reference operator()(size_type _row_index, size_type _col_index) const noexcept {
+			return ptr[Layout::offset(_row_index, _col_index, rows_, cols_)];
+		}
+		/**
+		 * \brief Pointer to the mapped elements, in the storage order of `Layout` and aligned to the alignment
+		 *        recorded in the file.
+		 */
+		pointer data() const noexcept { return ptr; }
+		/**
+		 * \brief Gets a view of the mapped elements, valid for the lifetime of the mapping.
+		 *
+		 * \complexity Constant.
+		 */
+		matrix_block_view<Ty> view() const noexcept {
+			static_assert(is_strided_layout<Layout>::value, "mapped_matrix::view requires a strided layout.");
+			return matrix_block_view<Ty>(ptr, rows_, cols_, Layout::row_stride(rows_, cols_), Layout::column_stride(rows_, cols_));
+		}
+		// OPERATIONS
+		/**
+		 * \brief Copies the mapped elements into a new `dynamic_matrix`.
+		 *
+		 * \complexity Linear in `size()`.
+		 */
+		template<class Allocator = std::allocator<value_type>>
+		dynamic_matrix<value_type, Allocator, Layout> to_matrix() const {
+			dynamic_matrix<value_type, Allocator, Layout> dm(rows_, cols_);
+			std::copy(ptr, ptr + size(), dm.data());
+			return dm;
+		}
+		void swap(mapped_matrix& _other) noexcept {
+			std::swap(base, _other.base);
+			std::swap(length, _other.length);
+			std::swap(ptr, _other.ptr);
+			std::swap(rows_, _other.rows_);
+			std::swap(cols_, _other.cols_);
+		}
+	private:
+		void* base = nullptr;
+		std::size_t length = 0U;
+		pointer ptr = nullptr;
+		size_type rows_ = 0U;
+		size_type cols_ = 0U;
+		static constexpr bool read_only = std::is_const<Ty>::value;
+		void release() noexcept {
+			base = nullptr;
+			length = 0U;
+			ptr = nullptr;
+			rows_ = 0U;
+			cols_ = 0U;
+		}
+#if defined(_WIN32)
+		void map(const std::string& _filename, std::uint64_t& _file_size) {
+			HANDLE file = CreateFileA(_filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("Failed to open file: " + _filename + " for reading.");
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(file, &size) || !size.QuadPart) {
+				CloseHandle(file);
+				throw std::runtime_error("Not a crescent matrix file.");
+			}
+			// a read-only mapping object supports copy-on-write views
+			HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			CloseHandle(file);
+			if (!mapping) throw std::runtime_error("Failed to map file: " + _filename + ".");
+			base = MapViewOfFile(mapping, read_only ? FILE_MAP_READ : FILE_MAP_COPY, 0, 0, 0);
+			// the view keeps the mapping object alive
+			CloseHandle(mapping);
+			if (!base) throw std::runtime_error("Failed to map file: " + _filename + ".");
+			_file_size = static_cast<std::uint64_t>(size.QuadPart);
+			length = static_cast<std::size_t>(_file_size);
+		}
+		void unmap() noexcept {
+			if (base) UnmapViewOfFile(base);
+			base = nullptr;
+		}
+#else
+		void map(const std::string& _filename, std::uint64_t& _file_size) {
+			const int fd = ::open(_filename.c_str(), O_RDONLY);
+			if (fd < 0) throw std::runtime_error("Failed to open file: " + _filename + " for reading.");
+			struct stat st;
+			if (::fstat(fd, &st) || st.st_size <= 0) {
+				::close(fd);
+				throw std::runtime_error("Not a crescent matrix file.");
+			}
+			_file_size = static_cast<std::uint64_t>(st.st_size);
+			if (_file_size > std::numeric_limits<std::size_t>::max()) {
+				::close(fd);
+				throw std::runtime_error("Matrix file: " + _filename + " is too large to map.");
+			}
+			length = static_cast<std::size_t>(_file_size);
+			void* p = read_only ? ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0)
+				: ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+			// the mapping remains valid once the descriptor is closed
+			::close(fd);
+			if (p == MAP_FAILED) throw std::runtime_error("Failed to map file: " + _filename + ".");
+			base = p;
+		}
+		void unmap() noexcept {
+			if (base) ::munmap(base, length);
+			base = nullptr;
+		}
+#endif
+	};
+	template<typename Ty, class Layout>
+	constexpr bool mapped_matrix<Ty, Layout>::read_only;
+	template<typename Ty, class Layout>
+	void swap(mapped_matrix<Ty, Layout>& _lhs, mapped_matrix<Ty, Layout>& _rhs) noexcept {
+		_lhs.swap(_rhs);
+	}
+}
+
+#endif // !MATRIX_IO_H
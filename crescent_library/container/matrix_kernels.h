@@ -0,0 +1,1392 @@
+#ifndef MATRIX_KERNELS_H
+#define MATRIX_KERNELS_H
+#include "simd_utilities.h"
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace crsc {
+	/**
+	 * \brief Low-level numerical kernels operating on raw, strided matrix storage. These are the building
+	 *        blocks used by the free algorithms of the matrix containers (e.g. `crsc::matrix_product`) and
+	 *        are exposed so that views and other containers can share them.
+	 *
+	 * A matrix operand is described by a pointer to its first element together with a row stride `rs` and a
+	 * column stride `cs` (both in units of elements), such that element `(i,j)` lives at `ptr[i*rs + j*cs]`.
+	 * A row-major matrix with `c` columns therefore has `rs == c, cs == 1`.
+	 */
+	namespace kernels {
+		/**
+		 * \struct gemm_blocking
+		 *
+		 * \brief Cache blocking parameters used by `gemm` for a given element type.
+		 *
+		 * - `mr`, `nr` - dimensions of the register tile computed by the micro-kernel.
+		 * - `kc` - depth of a packed panel, chosen such that an `mr*kc` sliver of the left operand and a
+		 *          `kc*nr` sliver of the right operand remain resident in L1 cache.
+		 * - `mc` - rows of the packed left operand block, chosen such that the `mc*kc` block fits in L2 cache.
+		 * - `nc` - columns of the packed right operand panel, chosen such that the `kc*nc` panel fits in L3 cache.
+		 *
+		 * \tparam Ty The type of the elements.
+		 */
+		template<typename Ty>
+		struct gemm_blocking {
+			static constexpr std::size_t mr = 4U;
+			static constexpr std::size_t nr = (sizeof(Ty) >= 8U) ? 8U : 16U;
+			static constexpr std::size_t kc = (sizeof(Ty) >= 8U) ? 256U : 512U;
+			static constexpr std::size_t mc = 96U;
+			static constexpr std::size_t nc = 2048U;
+			// below this many multiply-adds the cost of packing outweighs the benefit of blocking
+			static constexpr std::size_t small_threshold = 32U * 32U * 32U;
+		};
+		/**
+		 * \brief Computes `C += A*B` using an i-k-j loop ordering, such that the innermost loop walks rows of
+		 *        `B` and `C`. Used for small operands and for element types which are not arithmetic.
+		 *
+		 * \param m Number of rows of `A` and `C`.
+		 * \param n Number of columns of `B` and `C`.
+		 * \param k Number of columns of `A` and rows of `B`.
+		 */
+		template<typename Ty>
+		void gemm_reference(std::size_t m, std::size_t n, std::size_t k,
+			const Ty* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+			const Ty* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+			Ty* c, std::ptrdiff_t rsc, std::ptrdiff_t csc) {
+			for (std::size_t i = 0; i < m; ++i) {
+				for (std::size_t p = 0; p < k; ++p) {
+					const Ty& aip = a[i*rsa + p*csa];
+					const Ty* brow = b + p*rsb;
+					Ty* crow = c + i*rsc;
+					for (std::size_t j = 0; j < n; ++j)
+						crow[j*csc] += aip * brow[j*csb];
+				}
+			}
+		}
+		/**
+		 * \brief Detail namespace for implementation of the blocked `gemm` kernel.
+		 */
+		namespace gemm_impl {
+			// packs an mc x kc block of A into consecutive mr-row slivers, each stored as kc columns of mr
+			// contiguous values - rows beyond m are zero padded so the micro-kernel never needs edge cases
+			template<typename Ty, std::size_t MR>
+			void pack_a(std::size_t m, std::size_t k, const Ty* a, std::ptrdiff_t rsa, std::ptrdiff_t csa, Ty* buf) {
+				for (std::size_t i0 = 0; i0 < m; i0 += MR) {
+					const std::size_t mb = std::min(MR, m - i0);
+					for (std::size_t p = 0; p < k; ++p) {
+						const Ty* src = a + i0*rsa + p*csa;
+						std::size_t i = 0;
+						for (; i < mb; ++i) buf[i] = src[i*rsa];
+						for (; i < MR; ++i) buf[i] = Ty();
+						buf += MR;
+					}
+				}
+			}
+			// packs a kc x nc panel of B into consecutive nr-column slivers, each stored as kc rows of nr
+			// contiguous values - columns beyond n are zero padded
+			template<typename Ty, std::size_t NR>
+			void pack_b(std::size_t k, std::size_t n, const Ty* b, std::ptrdiff_t rsb, std::ptrdiff_t csb, Ty* buf) {
+				for (std::size_t j0 = 0; j0 < n; j0 += NR) {
+					const std::size_t nb = std::min(NR, n - j0);
+					for (std::size_t p = 0; p < k; ++p) {
+						const Ty* src = b + p*rsb + j0*csb;
+						std::size_t j = 0;
+						for (; j < nb; ++j) buf[j] = src[j*csb];
+						for (; j < NR; ++j) buf[j] = Ty();
+						buf += NR;
+					}
+				}
+			}
+			// computes an MR x NR tile of C from packed slivers, accumulating in registers and writing back
+			// only the m x n valid part of the tile
+			template<typename Ty, std::size_t MR, std::size_t NR>
+			void micro_kernel(std::size_t k, const Ty* __restrict pa, const Ty* __restrict pb,
+				Ty* c, std::ptrdiff_t rsc, std::ptrdiff_t csc, std::size_t m, std::size_t n) {
+				Ty acc[MR][NR] = {};
+				for (std::size_t p = 0; p < k; ++p) {
+					for (std::size_t i = 0; i < MR; ++i) {
+						const Ty ai = pa[i];
+						for (std::size_t j = 0; j < NR; ++j)
+							acc[i][j] += ai * pb[j];
+					}
+					pa += MR;
+					pb += NR;
+				}
+				if (m == MR && n == NR && csc == 1) {
+					for (std::size_t i = 0; i < MR; ++i) {
+						Ty* crow = c + i*rsc;
+						for (std::size_t j = 0; j < NR; ++j)
+							crow[j] += acc[i][j];
+					}
+				}
+				else {
+					for (std::size_t i = 0; i < m; ++i) {
+						for (std::size_t j = 0; j < n; ++j)
+							c[i*rsc + j*csc] += acc[i][j];
+					}
+				}
+			}
+			template<typename Ty>
+			void gemm_blocked(std::size_t m, std::size_t n, std::size_t k,
+				const Ty* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+				const Ty* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+				Ty* c, std::ptrdiff_t rsc, std::ptrdiff_t csc) {
+				typedef gemm_blocking<Ty> blk;
+				const std::size_t MR = blk::mr, NR = blk::nr, KC = blk::kc, MC = blk::mc, NC = blk::nc;
+				const std::size_t nc_max = std::min(NC, (n + NR - 1) / NR * NR);
+				const std::size_t kc_max = std::min(KC, k);
+				const std::size_t mc_max = std::min(MC, (m + MR - 1) / MR * MR);
+				std::vector<Ty> abuf(mc_max*kc_max);
+				std::vector<Ty> bbuf(kc_max*nc_max);
+				for (std::size_t jc = 0; jc < n; jc += NC) {
+					const std::size_t nc = std::min(NC, n - jc);
+					for (std::size_t pc = 0; pc < k; pc += KC) {
+						const std::size_t kc = std::min(KC, k - pc);
+						pack_b<Ty, blk::nr>(kc, nc, b + pc*rsb + jc*csb, rsb, csb, bbuf.data());
+						for (std::size_t ic = 0; ic < m; ic += MC) {
+							const std::size_t mc = std::min(MC, m - ic);
+							pack_a<Ty, blk::mr>(mc, kc, a + ic*rsa + pc*csa, rsa, csa, abuf.data());
+							for (std::size_t jr = 0; jr < nc; jr += NR) {
+								const Ty* pb = bbuf.data() + jr*kc;
+								for (std::size_t ir = 0; ir < mc; ir += MR) {
+									micro_kernel<Ty, blk::mr, blk::nr>(kc, abuf.data() + ir*kc, pb,
+										c + (ic + ir)*rsc + (jc + jr)*csc, rsc, csc,
+										std::min(MR, mc - ir), std::min(NR, nc - jr));
+								}
+							}
+						}
+					}
+				}
+			}
+			template<typename Ty>
+			void gemm_dispatch(std::true_type, std::size_t m, std::size_t n, std::size_t k,
+				const Ty* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+				const Ty* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+				Ty* c, std::ptrdiff_t rsc, std::ptrdiff_t csc) {
+				if (m*n*k < gemm_blocking<Ty>::small_threshold)
+					gemm_reference(m, n, k, a, rsa, csa, b, rsb, csb, c, rsc, csc);
+				else gemm_blocked(m, n, k, a, rsa, csa, b, rsb, csb, c, rsc, csc);
+			}
+			template<typename Ty>
+			void gemm_dispatch(std::false_type, std::size_t m, std::size_t n, std::size_t k,
+				const Ty* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+				const Ty* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+				Ty* c, std::ptrdiff_t rsc, std::ptrdiff_t csc) {
+				gemm_reference(m, n, k, a, rsa, csa, b, rsb, csb, c, rsc, csc);
+			}
+		}
+		/**
+		 * \brief General matrix multiply, computes `C += A*B` where `A` is `m x k`, `B` is `k x n` and `C` is
+		 *        `m x n`, all with arbitrary row and column strides.
+		 *
+		 * For arithmetic element types the product is computed with a cache-blocked algorithm in the style of
+		 * Goto/BLIS: panels of `B` and blocks of `A` are packed into contiguous buffers sized according to
+		 * `gemm_blocking<Ty>` and an `mr x nr` register-tiled micro-kernel accumulates each tile of `C`. Small
+		 * products and non-arithmetic element types use `gemm_reference`.
+		 *
+		 * \warning `C` must not alias `A` or `B`.
+		 * \complexity Linear in `m*n*k` multiply-adds plus linear in `m*k + k*n` (packing) per block.
+		 */
+		template<typename Ty>
+		void gemm(std::size_t m, std::size_t n, std::size_t k,
+			const Ty* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+			const Ty* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+			Ty* c, std::ptrdiff_t rsc, std::ptrdiff_t csc) {
+			if (!m || !n || !k) return;
+			gemm_impl::gemm_dispatch(std::is_arithmetic<Ty>{}, m, n, k, a, rsa, csa, b, rsb, csb, c, rsc, csc);
+		}
+		/**
+		 * \enum elementwise_op
+		 *
+		 * \brief Operations supported by `elementwise`, given inputs `a`, `b` and a scalar `s`:
+		 *
+		 * - `add` - `out[i] = a[i] + b[i]`.
+		 * - `subtract` - `out[i] = a[i] - b[i]`.
+		 * - `multiply` - `out[i] = a[i] * b[i]` (Hadamard product).
+		 * - `scale` - `out[i] = a[i] * s`, `b` is not accessed.
+		 * - `axpy` - `out[i] = s * a[i] + b[i]`.
+		 * - `multiply_add` - `out[i] += a[i] * b[i]`.
+		 * - `multiply_subtract` - `out[i] -= a[i] * b[i]`.
+		 * - `divide` - `out[i] = a[i] / b[i]`.
+		 */
+		enum class elementwise_op {
+			add,
+			subtract,
+			multiply,
+			scale,
+			axpy,
+			multiply_add,
+			multiply_subtract,
+			divide
+		};
+		/**
+		 * \brief Detail namespace for implementation of the `elementwise` kernels.
+		 */
+		namespace elementwise_impl {
+			template<elementwise_op Op, typename Ty>
+			void scalar_loop(const Ty* a, const Ty* b, Ty* out, const Ty& s, std::size_t n) {
+				for (std::size_t i = 0; i < n; ++i) {
+					switch (Op) {
+					case elementwise_op::add: out[i] = a[i] + b[i]; break;
+					case elementwise_op::subtract: out[i] = a[i] - b[i]; break;
+					case elementwise_op::multiply: out[i] = a[i] * b[i]; break;
+					case elementwise_op::scale: out[i] = a[i] * s; break;
+					case elementwise_op::axpy: out[i] = s * a[i] + b[i]; break;
+					case elementwise_op::multiply_add: out[i] += a[i] * b[i]; break;
+					case elementwise_op::multiply_subtract: out[i] -= a[i] * b[i]; break;
+					case elementwise_op::divide: out[i] = a[i] / b[i]; break;
+					}
+				}
+			}
+#if defined(CRSC_SIMD_X86)
+			// the vector loops are identical apart from their target annotation, which must be on the function
+			// containing the loop for the register wrappers of that instruction set to be inlined into it
+			template<class V, elementwise_op Op>
+			CRSC_TARGET("sse2") void sse2_loop(const typename V::value_type* a, const typename V::value_type* b,
+				typename V::value_type* out, typename V::value_type s, std::size_t n) {
+				const typename V::reg vs = V::set1(s);
+				std::size_t i = 0;
+				for (; i + V::width <= n; i += V::width) {
+					const typename V::reg x = V::load(a + i);
+					if (Op == elementwise_op::scale) { V::store(out + i, V::mul(x, vs)); continue; }
+					const typename V::reg y = V::load(b + i);
+					V::store(out + i, Op == elementwise_op::add ? V::add(x, y)
+						: Op == elementwise_op::subtract ? V::sub(x, y)
+						: Op == elementwise_op::multiply ? V::mul(x, y)
+						: Op == elementwise_op::multiply_add ? V::add(V::mul(x, y), V::load(out + i))
+						: Op == elementwise_op::multiply_subtract ? V::sub(V::load(out + i), V::mul(x, y))
+						: Op == elementwise_op::divide ? V::div(x, y)
+						: V::add(V::mul(vs, x), y));
+				}
+				scalar_loop<Op>(a + i, (Op == elementwise_op::scale) ? b : b + i, out + i, s, n - i);
+			}
+			template<class V, elementwise_op Op>
+			CRSC_TARGET("avx2") void avx2_loop(const typename V::value_type* a, const typename V::value_type* b,
+				typename V::value_type* out, typename V::value_type s, std::size_t n) {
+				const typename V::reg vs = V::set1(s);
+				std::size_t i = 0;
+				for (; i + V::width <= n; i += V::width) {
+					const typename V::reg x = V::load(a + i);
+					if (Op == elementwise_op::scale) { V::store(out + i, V::mul(x, vs)); continue; }
+					const typename V::reg y = V::load(b + i);
+					V::store(out + i, Op == elementwise_op::add ? V::add(x, y)
+						: Op == elementwise_op::subtract ? V::sub(x, y)
+						: Op == elementwise_op::multiply ? V::mul(x, y)
+						: Op == elementwise_op::multiply_add ? V::add(V::mul(x, y), V::load(out + i))
+						: Op == elementwise_op::multiply_subtract ? V::sub(V::load(out + i), V::mul(x, y))
+						: Op == elementwise_op::divide ? V::div(x, y)
+						: V::add(V::mul(vs, x), y));
+				}
+				scalar_loop<Op>(a + i, (Op == elementwise_op::scale) ? b : b + i, out + i, s, n - i);
+			}
+			template<class V, elementwise_op Op>
+			CRSC_TARGET("avx512f") void avx512_loop(const typename V::value_type* a, const typename V::value_type* b,
+				typename V::value_type* out, typename V::value_type s, std::size_t n) {
+				const typename V::reg vs = V::set1(s);
+				std::size_t i = 0;
+				for (; i + V::width <= n; i += V::width) {
+					const typename V::reg x = V::load(a + i);
+					if (Op == elementwise_op::scale) { V::store(out + i, V::mul(x, vs)); continue; }
+					const typename V::reg y = V::load(b + i);
+					V::store(out + i, Op == elementwise_op::add ? V::add(x, y)
+						: Op == elementwise_op::subtract ? V::sub(x, y)
+						: Op == elementwise_op::multiply ? V::mul(x, y)
+						: Op == elementwise_op::multiply_add ? V::add(V::mul(x, y), V::load(out + i))
+						: Op == elementwise_op::multiply_subtract ? V::sub(V::load(out + i), V::mul(x, y))
+						: Op == elementwise_op::divide ? V::div(x, y)
+						: V::add(V::mul(vs, x), y));
+				}
+				scalar_loop<Op>(a + i, (Op == elementwise_op::scale) ? b : b + i, out + i, s, n - i);
+			}
+			// selects the widest loop supported by the executing CPU, once per (operation, type) pair
+			template<elementwise_op Op, typename Ty>
+			struct dispatcher {
+				typedef void(*loop_fn)(const Ty*, const Ty*, Ty*, Ty, std::size_t);
+				static void scalar(const Ty* a, const Ty* b, Ty* out, Ty s, std::size_t n) {
+					scalar_loop<Op>(a, b, out, s, n);
+				}
+				static loop_fn select() noexcept {
+					switch (detect_simd_level()) {
+					case simd_level::avx512: return &avx512_loop<simd::avx512_vec<Ty>, Op>;
+					case simd_level::avx2: return &avx2_loop<simd::avx2_vec<Ty>, Op>;
+					case simd_level::sse2: return &sse2_loop<simd::sse2_vec<Ty>, Op>;
+					default: return &scalar;
+					}
+				}
+				static loop_fn get() noexcept {
+					static const loop_fn fn = select();
+					return fn;
+				}
+			};
+			template<elementwise_op Op, typename Ty>
+			void run(std::true_type, const Ty* a, const Ty* b, Ty* out, const Ty& s, std::size_t n) {
+				dispatcher<Op, Ty>::get()(a, b, out, s, n);
+			}
+#endif
+			template<elementwise_op Op, typename Ty>
+			void run(std::false_type, const Ty* a, const Ty* b, Ty* out, const Ty& s, std::size_t n) {
+				scalar_loop<Op>(a, b, out, s, n);
+			}
+			template<typename Ty>
+			struct is_vectorizable : std::integral_constant<bool,
+#if defined(CRSC_SIMD_X86)
+				std::is_same<Ty, float>::value || std::is_same<Ty, double>::value
+#else
+				false
+#endif
+			> {};
+		}
+		/**
+		 * \brief Applies the elementwise operation `Op` over `n` contiguous elements (see `elementwise_op`).
+		 *
+		 * For `float` and `double` on x86 targets the loop uses SSE2, AVX2 or AVX-512 registers depending
+		 * upon the instruction sets available on the executing CPU (see `crsc::detect_simd_level`), selected
+		 * once on first use. All other element types, and all other targets, use a scalar loop.
+		 *
+		 * \remark `out` may alias `a` and/or `b` exactly (e.g. for in-place `+=`), partial overlap is not permitted.
+		 * \param a First input range of `n` elements.
+		 * \param b Second input range of `n` elements, not accessed if `Op == elementwise_op::scale`.
+		 * \param out Output range of `n` elements.
+		 * \param s Scalar operand for `elementwise_op::scale` and `elementwise_op::axpy`.
+		 * \param n Number of elements.
+		 * \complexity Linear in `n`.
+		 */
+		template<elementwise_op Op, typename Ty>
+		void elementwise(const Ty* a, const Ty* b, Ty* out, const Ty& s, std::size_t n) {
+			elementwise_impl::run<Op>(elementwise_impl::is_vectorizable<Ty>{}, a, b, out, s, n);
+		}
+		/**
+		 * \brief Computes `out[i] = a[i] + b[i]` for `i` in `[0, n)`.
+		 */
+		template<typename Ty>
+		void add(const Ty* a, const Ty* b, Ty* out, std::size_t n) {
+			elementwise<elementwise_op::add>(a, b, out, Ty(), n);
+		}
+		/**
+		 * \brief Computes `out[i] = a[i] - b[i]` for `i` in `[0, n)`.
+		 */
+		template<typename Ty>
+		void subtract(const Ty* a, const Ty* b, Ty* out, std::size_t n) {
+			elementwise<elementwise_op::subtract>(a, b, out, Ty(), n);
+		}
+		/**
+		 * \brief Computes the Hadamard product `out[i] = a[i] * b[i]` for `i` in `[0, n)`.
+		 */
+		template<typename Ty>
+		void hadamard(const Ty* a, const Ty* b, Ty* out, std::size_t n) {
+			elementwise<elementwise_op::multiply>(a, b, out, Ty(), n);
+		}
+		/**
+		 * \brief Computes `out[i] = a[i] * s` for `i` in `[0, n)`.
+		 */
+		template<typename Ty>
+		void scale(const Ty* a, const Ty& s, Ty* out, std::size_t n) {
+			elementwise<elementwise_op::scale>(a, static_cast<const Ty*>(nullptr), out, s, n);
+		}
+		/**
+		 * \brief Computes `y[i] += alpha * x[i]` for `i` in `[0, n)`.
+		 */
+		template<typename Ty>
+		void axpy(const Ty& alpha, const Ty* x, Ty* y, std::size_t n) {
+			elementwise<elementwise_op::axpy>(x, static_cast<const Ty*>(y), y, alpha, n);
+		}
+		/**
+		 * \brief Computes `out[i] += a[i] * b[i]` for `i` in `[0, n)`.
+		 */
+		template<typename Ty>
+		void multiply_add(const Ty* a, const Ty* b, Ty* out, std::size_t n) {
+			elementwise<elementwise_op::multiply_add>(a, b, out, Ty(), n);
+		}
+		/**
+		 * \brief Computes `out[i] -= a[i] * b[i]` for `i` in `[0, n)`.
+		 */
+		template<typename Ty>
+		void multiply_subtract(const Ty* a, const Ty* b, Ty* out, std::size_t n) {
+			elementwise<elementwise_op::multiply_subtract>(a, b, out, Ty(), n);
+		}
+		/**
+		 * \brief Computes `out[i] = a[i] / b[i]` for `i` in `[0, n)`.
+		 */
+		template<typename Ty>
+		void divide(const Ty* a, const Ty* b, Ty* out, std::size_t n) {
+			elementwise<elementwise_op::divide>(a, b, out, Ty(), n);
+		}
+		/**
+		 * \brief Detail namespace for implementation of the `gemv` kernel.
+		 */
+		namespace gemv_impl {
+			// below this many multiply-adds the product is computed by the reference loop
+			constexpr std::size_t small_threshold = 256U;
+			// rows (or columns) of the matrix processed together, sharing each load of x (or y)
+			constexpr std::size_t block = 4U;
+			// signature shared by the dot and axpy block loops
+			template<typename Ty>
+			using block_fn = void(*)(std::size_t, const Ty* const*, const Ty*, Ty*);
+			template<typename Ty>
+			void reference(std::size_t m, std::size_t n, const Ty* a, std::ptrdiff_t rsa, std::ptrdiff_t csa, const Ty* x, Ty* y) {
+				for (std::size_t i = 0; i < m; ++i) {
+					Ty sum = Ty();
+					for (std::size_t j = 0; j < n; ++j) sum += a[i*rsa + j*csa] * x[j];
+					y[i] += sum;
+				}
+			}
+			// out[q] += dot product of the n contiguous elements of rows[q] with x, for q in [0, block)
+			template<typename Ty>
+			void dot_block_scalar(std::size_t n, const Ty* const* rows, const Ty* x, Ty* out) {
+				for (std::size_t q = 0; q < block; ++q) {
+					Ty sum = Ty();
+					for (std::size_t j = 0; j < n; ++j) sum += rows[q][j] * x[j];
+					out[q] += sum;
+				}
+			}
+			// y[i] += sum of cols[q][i]*s[q] over q in [0, block), for i in [0, m)
+			template<typename Ty>
+			void axpy_block_scalar(std::size_t m, const Ty* const* cols, const Ty* s, Ty* y) {
+				for (std::size_t i = 0; i < m; ++i)
+					y[i] += cols[0][i] * s[0] + cols[1][i] * s[1] + cols[2][i] * s[2] + cols[3][i] * s[3];
+			}
+#if defined(CRSC_SIMD_X86)
+			// as for elementwise, the loops differ only by target annotation
+			template<class V>
+			CRSC_TARGET("sse2") void sse2_dot_block(std::size_t n, const typename V::value_type* const* rows,
+				const typename V::value_type* x, typename V::value_type* out) {
+				typedef typename V::value_type value_type;
+				typename V::reg acc[block] = { V::set1(0), V::set1(0), V::set1(0), V::set1(0) };
+				std::size_t j = 0;
+				for (; j + V::width <= n; j += V::width) {
+					const typename V::reg xv = V::load(x + j);
+					for (std::size_t q = 0; q < block; ++q) acc[q] = V::add(acc[q], V::mul(V::load(rows[q] + j), xv));
+				}
+				for (std::size_t q = 0; q < block; ++q) {
+					value_type lanes[V::width];
+					V::store(lanes, acc[q]);
+					value_type sum = value_type();
+					for (std::size_t l = 0; l < V::width; ++l) sum += lanes[l];
+					for (std::size_t t = j; t < n; ++t) sum += rows[q][t] * x[t];
+					out[q] += sum;
+				}
+			}
+			template<class V>
+			CRSC_TARGET("avx2") void avx2_dot_block(std::size_t n, const typename V::value_type* const* rows,
+				const typename V::value_type* x, typename V::value_type* out) {
+				typedef typename V::value_type value_type;
+				typename V::reg acc[block] = { V::set1(0), V::set1(0), V::set1(0), V::set1(0) };
+				std::size_t j = 0;
+				for (; j + V::width <= n; j += V::width) {
+					const typename V::reg xv = V::load(x + j);
+					for (std::size_t q = 0; q < block; ++q) acc[q] = V::add(acc[q], V::mul(V::load(rows[q] + j), xv));
+				}
+				for (std::size_t q = 0; q < block; ++q) {
+					value_type lanes[V::width];
+					V::store(lanes, acc[q]);
+					value_type sum = value_type();
+					for (std::size_t l = 0; l < V::width; ++l) sum += lanes[l];
+					for (std::size_t t = j; t < n; ++t) sum += rows[q][t] * x[t];
+					out[q] += sum;
+				}
+			}
+			template<class V>
+			CRSC_TARGET("avx512f") void avx512_dot_block(std::size_t n, const typename V::value_type* const* rows,
+				const typename V::value_type* x, typename V::value_type* out) {
+				typedef typename V::value_type value_type;
+				typename V::reg acc[block] = { V::set1(0), V::set1(0), V::set1(0), V::set1(0) };
+				std::size_t j = 0;
+				for (; j + V::width <= n; j += V::width) {
+					const typename V::reg xv = V::load(x + j);
+					for (std::size_t q = 0; q < block; ++q) acc[q] = V::add(acc[q], V::mul(V::load(rows[q] + j), xv));
+				}
+				for (std::size_t q = 0; q < block; ++q) {
+					value_type lanes[V::width];
+					V::store(lanes, acc[q]);
+					value_type sum = value_type();
+					for (std::size_t l = 0; l < V::width; ++l) sum += lanes[l];
+					for (std::size_t t = j; t < n; ++t) sum += rows[q][t] * x[t];
+					out[q] += sum;
+				}
+			}
+			template<class V>
+			CRSC_TARGET("sse2") void sse2_axpy_block(std::size_t m, const typename V::value_type* const* cols,
+				const typename V::value_type* s, typename V::value_type* y) {
+				const typename V::reg s0 = V::set1(s[0]), s1 = V::set1(s[1]), s2 = V::set1(s[2]), s3 = V::set1(s[3]);
+				std::size_t i = 0;
+				for (; i + V::width <= m; i += V::width) {
+					typename V::reg yv = V::add(V::load(y + i), V::mul(V::load(cols[0] + i), s0));
+					yv = V::add(yv, V::mul(V::load(cols[1] + i), s1));
+					yv = V::add(yv, V::mul(V::load(cols[2] + i), s2));
+					V::store(y + i, V::add(yv, V::mul(V::load(cols[3] + i), s3)));
+				}
+				for (; i < m; ++i) y[i] += cols[0][i] * s[0] + cols[1][i] * s[1] + cols[2][i] * s[2] + cols[3][i] * s[3];
+			}
+			template<class V>
+			CRSC_TARGET("avx2") void avx2_axpy_block(std::size_t m, const typename V::value_type* const* cols,
+				const typename V::value_type* s, typename V::value_type* y) {
+				const typename V::reg s0 = V::set1(s[0]), s1 = V::set1(s[1]), s2 = V::set1(s[2]), s3 = V::set1(s[3]);
+				std::size_t i = 0;
+				for (; i + V::width <= m; i += V::width) {
+					typename V::reg yv = V::add(V::load(y + i), V::mul(V::load(cols[0] + i), s0));
+					yv = V::add(yv, V::mul(V::load(cols[1] + i), s1));
+					yv = V::add(yv, V::mul(V::load(cols[2] + i), s2));
+					V::store(y + i, V::add(yv, V::mul(V::load(cols[3] + i), s3)));
+				}
+				for (; i < m; ++i) y[i] += cols[0][i] * s[0] + cols[1][i] * s[1] + cols[2][i] * s[2] + cols[3][i] * s[3];
+			}
+			template<class V>
+			CRSC_TARGET("avx512f") void avx512_axpy_block(std::size_t m, const typename V::value_type* const* cols,
+				const typename V::value_type* s, typename V::value_type* y) {
+				const typename V::reg s0 = V::set1(s[0]), s1 = V::set1(s[1]), s2 = V::set1(s[2]), s3 = V::set1(s[3]);
+				std::size_t i = 0;
+				for (; i + V::width <= m; i += V::width) {
+					typename V::reg yv = V::add(V::load(y + i), V::mul(V::load(cols[0] + i), s0));
+					yv = V::add(yv, V::mul(V::load(cols[1] + i), s1));
+					yv = V::add(yv, V::mul(V::load(cols[2] + i), s2));
+					V::store(y + i, V::add(yv, V::mul(V::load(cols[3] + i), s3)));
+				}
+				for (; i < m; ++i) y[i] += cols[0][i] * s[0] + cols[1][i] * s[1] + cols[2][i] * s[2] + cols[3][i] * s[3];
+			}
+			// selects the widest block loops supported by the executing CPU, once per type
+			template<typename Ty>
+			struct dispatcher {
+				typedef block_fn<Ty> dot_fn;
+				typedef block_fn<Ty> axpy_fn;
+				static dot_fn select_dot() noexcept {
+					switch (detect_simd_level()) {
+					case simd_level::avx512: return &avx512_dot_block<simd::avx512_vec<Ty>>;
+					case simd_level::avx2: return &avx2_dot_block<simd::avx2_vec<Ty>>;
+					case simd_level::sse2: return &sse2_dot_block<simd::sse2_vec<Ty>>;
+					default: return &dot_block_scalar<Ty>;
+					}
+				}
+				static axpy_fn select_axpy() noexcept {
+					switch (detect_simd_level()) {
+					case simd_level::avx512: return &avx512_axpy_block<simd::avx512_vec<Ty>>;
+					case simd_level::avx2: return &avx2_axpy_block<simd::avx2_vec<Ty>>;
+					case simd_level::sse2: return &sse2_axpy_block<simd::sse2_vec<Ty>>;
+					default: return &axpy_block_scalar<Ty>;
+					}
+				}
+				static dot_fn dot() noexcept {
+					static const dot_fn fn = select_dot();
+					return fn;
+				}
+				static axpy_fn axpy() noexcept {
+					static const axpy_fn fn = select_axpy();
+					return fn;
+				}
+			};
+			template<typename Ty>
+			block_fn<Ty> dot_block(std::true_type) { return dispatcher<Ty>::dot(); }
+			template<typename Ty>
+			block_fn<Ty> axpy_block(std::true_type) { return dispatcher<Ty>::axpy(); }
+#endif
+			template<typename Ty>
+			block_fn<Ty> dot_block(std::false_type) { return &dot_block_scalar<Ty>; }
+			template<typename Ty>
+			block_fn<Ty> axpy_block(std::false_type) { return &axpy_block_scalar<Ty>; }
+			// rows of a are contiguous: each y[i] is the dot product of row i with x, taken block rows at a time
+			template<typename Ty>
+			void rows_contiguous(std::size_t m, std::size_t n, const Ty* a, std::ptrdiff_t rsa, const Ty* x, Ty* y) {
+				const auto fn = dot_block<Ty>(elementwise_impl::is_vectorizable<Ty>{});
+				for (std::size_t i = 0; i < m; i += block) {
+					const std::size_t rows = std::min(block, m - i);
+					const Ty* r[block];
+					Ty out[block] = {};
+					// missing rows of a partial block repeat the first row and are discarded
+					for (std::size_t q = 0; q < block; ++q) r[q] = a + (i + (q < rows ? q : 0U))*rsa;
+					fn(n, r, x, out);
+					for (std::size_t q = 0; q < rows; ++q) y[i + q] += out[q];
+				}
+			}
+			// columns of a are contiguous: y accumulates block columns at a time, scaled by the elements of x
+			template<typename Ty>
+			void columns_contiguous(std::size_t m, std::size_t n, const Ty* a, std::ptrdiff_t csa, const Ty* x, Ty* y) {
+				const auto fn = axpy_block<Ty>(elementwise_impl::is_vectorizable<Ty>{});
+				for (std::size_t j = 0; j < n; j += block) {
+					const std::size_t cols = std::min(block, n - j);
+					const Ty* c[block];
+					Ty s[block];
+					// missing columns of a partial block repeat the first column with a zero multiplier
+					for (std::size_t q = 0; q < block; ++q) {
+						c[q] = a + (j + (q < cols ? q : 0U))*csa;
+						s[q] = q < cols ? x[j + q] : Ty();
+					}
+					fn(m, c, s, y);
+				}
+			}
+		}
+		/**
+		 * \brief General matrix-vector multiply, computes `y += A*x` where `A` is `m x n` with arbitrary row and
+		 *        column strides, `x` holds `n` contiguous elements and `y` holds `m` contiguous elements.
+		 *
+		 * If the rows of `A` are contiguous (`csa == 1`) each element of `y` is a dot product, computed four rows
+		 * at a time such that each load of `x` is shared; if the columns of `A` are contiguous (`rsa == 1`) `y`
+		 * accumulates four scaled columns at a time. For `float` and `double` on x86 targets both loops use the
+		 * widest of SSE2, AVX2 or AVX-512 supported by the executing CPU. Small products, other strides and other
+		 * element types use a scalar loop.
+		 *
+		 * \warning `y` must not alias `A` or `x`.
+		 * \complexity Linear in `m*n`.
+		 */
+		template<typename Ty>
+		void gemv(std::size_t m, std::size_t n, const Ty* a, std::ptrdiff_t rsa, std::ptrdiff_t csa, const Ty* x, Ty* y) {
+			if (!m || !n) return;
+			if (m*n < gemv_impl::small_threshold || !std::is_arithmetic<Ty>::value || (csa != 1 && rsa != 1))
+				gemv_impl::reference(m, n, a, rsa, csa, x, y);
+			else if (csa == 1) gemv_impl::rows_contiguous(m, n, a, rsa, x, y);
+			else gemv_impl::columns_contiguous(m, n, a, csa, x, y);
+		}
+		/**
+		 * \brief Batched general matrix multiply on interleaved storage, computes `C_l += A_l*B_l` for each of the
+		 *        `lanes` products `l`, where `A_l` is `m x k`, `B_l` is `k x n` and `C_l` is `m x n`.
+		 *
+		 * Element `(i,j)` of the `l`-th matrix of an operand with `c` columns is at `ptr[(i*c + j)*stride + l]`,
+		 * i.e. the same element of every matrix of the batch is contiguous. Each multiply-add of the products is
+		 * therefore a vector operation across the batch (see `elementwise_op::multiply_add`), whatever the size of
+		 * the matrices. Lanes are processed in blocks small enough for the corresponding parts of all three
+		 * operands to remain in L1 cache.
+		 *
+		 * \warning `C` must not alias `A` or `B`.
+		 * \complexity Linear in `lanes*m*n*k`.
+		 */
+		template<typename Ty>
+		void gemm_interleaved(std::size_t m, std::size_t n, std::size_t k, std::size_t lanes,
+			const Ty* a, const Ty* b, Ty* c, std::size_t stride) {
+			if (!m || !n || !k || !lanes) return;
+			const std::size_t bytes = (m*k + k*n + m*n)*sizeof(Ty);
+			const std::size_t lane_block = std::max<std::size_t>(16U, std::min<std::size_t>(1024U, 16384U / bytes) / 16U*16U);
+			for (std::size_t l0 = 0; l0 < lanes; l0 += lane_block) {
+				const std::size_t len = std::min(lane_block, lanes - l0);
+				for (std::size_t i = 0; i < m; ++i) {
+					for (std::size_t j = 0; j < n; ++j) {
+						Ty* cij = c + (i*n + j)*stride + l0;
+						for (std::size_t p = 0; p < k; ++p)
+							multiply_add(a + (i*k + p)*stride + l0, b + (p*n + j)*stride + l0, cij, len);
+					}
+				}
+			}
+		}
+		/**
+		 * \brief Detail namespace for implementation of the `transpose` kernels.
+		 */
+		namespace transpose_impl {
+			// operands of at most base_size rows and columns are handled directly, larger operands are halved
+			// along their larger dimension - the recursion reaches a block fitting each level of the cache
+			// hierarchy without knowing its size, so every line brought into cache is used fully
+			constexpr std::size_t base_size = 32U;
+			// halves are rounded down to a multiple of the widest micro-tile, such that the recursion never cuts
+			// through the register tiles of a base block
+			constexpr std::size_t split_alignment = 8U;
+			inline std::size_t split_point(std::size_t n) noexcept {
+				return n / 2U / split_alignment * split_alignment;
+			}
+			template<typename Ty>
+			void copy_block(std::size_t r, std::size_t c, const Ty* src, std::size_t lds, Ty* dst, std::size_t ldd) {
+				for (std::size_t i = 0; i < r; ++i) {
+					for (std::size_t j = 0; j < c; ++j)
+						dst[j*ldd + i] = src[i*lds + j];
+				}
+			}
+			template<typename Ty>
+			void swap_block(std::size_t r, std::size_t c, Ty* a, Ty* b, std::size_t ld) {
+				using std::swap;
+				for (std::size_t i = 0; i < r; ++i) {
+					for (std::size_t j = 0; j < c; ++j)
+						swap(a[i*ld + j], b[j*ld + i]);
+				}
+			}
+#if defined(CRSC_SIMD_X86)
+			// the block loops transpose width x width tiles held in registers, leaving the ragged edges of the
+			// block to the scalar loops - as for the elementwise kernels they differ only in target annotation
+			template<class V>
+			CRSC_TARGET("sse2") void sse2_copy_block(std::size_t r, std::size_t c, const typename V::value_type* src,
+				std::size_t lds, typename V::value_type* dst, std::size_t ldd) {
+				const std::size_t w = V::width;
+				typename V::reg t[V::width];
+				std::size_t i = 0;
+				for (; i + w <= r; i += w) {
+					std::size_t j = 0;
+					for (; j + w <= c; j += w) {
+						for (std::size_t k = 0; k < w; ++k) t[k] = V::load(src + (i + k)*lds + j);
+						V::transpose(t);
+						for (std::size_t k = 0; k < w; ++k) V::store(dst + (j + k)*ldd + i, t[k]);
+					}
+					copy_block(w, c - j, src + i*lds + j, lds, dst + j*ldd + i, ldd);
+				}
+				copy_block(r - i, c, src + i*lds, lds, dst + i, ldd);
+			}
+			template<class V>
+			CRSC_TARGET("sse2") void sse2_swap_block(std::size_t r, std::size_t c, typename V::value_type* a,
+				typename V::value_type* b, std::size_t ld) {
+				const std::size_t w = V::width;
+				typename V::reg ta[V::width], tb[V::width];
+				std::size_t i = 0;
+				for (; i + w <= r; i += w) {
+					std::size_t j = 0;
+					for (; j + w <= c; j += w) {
+						for (std::size_t k = 0; k < w; ++k) {
+							ta[k] = V::load(a + (i + k)*ld + j);
+							tb[k] = V::load(b + (j + k)*ld + i);
+						}
+						V::transpose(ta);
+						V::transpose(tb);
+						for (std::size_t k = 0; k < w; ++k) {
+							V::store(a + (i + k)*ld + j, tb[k]);
+							V::store(b + (j + k)*ld + i, ta[k]);
+						}
+					}
+					swap_block(w, c - j, a + i*ld + j, b + j*ld + i, ld);
+				}
+				swap_block(r - i, c, a + i*ld, b + i, ld);
+			}
+			template<class V>
+			CRSC_TARGET("avx2") void avx2_copy_block(std::size_t r, std::size_t c, const typename V::value_type* src,
+				std::size_t lds, typename V::value_type* dst, std::size_t ldd) {
+				const std::size_t w = V::width;
+				typename V::reg t[V::width];
+				std::size_t i = 0;
+				for (; i + w <= r; i += w) {
+					std::size_t j = 0;
+					for (; j + w <= c; j += w) {
+						for (std::size_t k = 0; k < w; ++k) t[k] = V::load(src + (i + k)*lds + j);
+						V::transpose(t);
+						for (std::size_t k = 0; k < w; ++k) V::store(dst + (j + k)*ldd + i, t[k]);
+					}
+					copy_block(w, c - j, src + i*lds + j, lds, dst + j*ldd + i, ldd);
+				}
+				copy_block(r - i, c, src + i*lds, lds, dst + i, ldd);
+			}
+			template<class V>
+			CRSC_TARGET("avx2") void avx2_swap_block(std::size_t r, std::size_t c, typename V::value_type* a,
+				typename V::value_type* b, std::size_t ld) {
+				const std::size_t w = V::width;
+				typename V::reg ta[V::width], tb[V::width];
+				std::size_t i = 0;
+				for (; i + w <= r; i += w) {
+					std::size_t j = 0;
+					for (; j + w <= c; j += w) {
+						for (std::size_t k = 0; k < w; ++k) {
+							ta[k] = V::load(a + (i + k)*ld + j);
+							tb[k] = V::load(b + (j + k)*ld + i);
+						}
+						V::transpose(ta);
+						V::transpose(tb);
+						for (std::size_t k = 0; k < w; ++k) {
+							V::store(a + (i + k)*ld + j, tb[k]);
+							V::store(b + (j + k)*ld + i, ta[k]);
+						}
+					}
+					swap_block(w, c - j, a + i*ld + j, b + j*ld + i, ld);
+				}
+				swap_block(r - i, c, a + i*ld, b + i, ld);
+			}
+#endif
+			// selects the block loops for the executing CPU once per element type, AVX-512 machines use the
+			// AVX2 tiles as the wider transposes would spill the register file
+			template<typename Ty, bool Vectorizable>
+			struct dispatcher {
+				typedef void(*copy_fn)(std::size_t, std::size_t, const Ty*, std::size_t, Ty*, std::size_t);
+				typedef void(*swap_fn)(std::size_t, std::size_t, Ty*, Ty*, std::size_t);
+				static copy_fn copy() noexcept { return &copy_block<Ty>; }
+				static swap_fn swap() noexcept { return &swap_block<Ty>; }
+			};
+#if defined(CRSC_SIMD_X86)
+			template<typename Ty>
+			struct dispatcher<Ty, true> {
+				typedef void(*copy_fn)(std::size_t, std::size_t, const Ty*, std::size_t, Ty*, std::size_t);
+				typedef void(*swap_fn)(std::size_t, std::size_t, Ty*, Ty*, std::size_t);
+				static copy_fn select_copy() noexcept {
+					switch (detect_simd_level()) {
+					case simd_level::avx512:
+					case simd_level::avx2: return &avx2_copy_block<simd::avx2_vec<Ty>>;
+					case simd_level::sse2: return &sse2_copy_block<simd::sse2_vec<Ty>>;
+					default: return &copy_block<Ty>;
+					}
+				}
+				static swap_fn select_swap() noexcept {
+					switch (detect_simd_level()) {
+					case simd_level::avx512:
+					case simd_level::avx2: return &avx2_swap_block<simd::avx2_vec<Ty>>;
+					case simd_level::sse2: return &sse2_swap_block<simd::sse2_vec<Ty>>;
+					default: return &swap_block<Ty>;
+					}
+				}
+				static copy_fn copy() noexcept {
+					static const copy_fn fn = select_copy();
+					return fn;
+				}
+				static swap_fn swap() noexcept {
+					static const swap_fn fn = select_swap();
+					return fn;
+				}
+			};
+#endif
+			template<typename Ty, class CopyFn>
+			void copy_recursive(std::size_t r, std::size_t c, const Ty* src, std::size_t lds, Ty* dst, std::size_t ldd,
+				CopyFn block) {
+				if (r <= base_size && c <= base_size) block(r, c, src, lds, dst, ldd);
+				else if (r >= c) {
+					const std::size_t h = split_point(r);
+					copy_recursive(h, c, src, lds, dst, ldd, block);
+					copy_recursive(r - h, c, src + h*lds, lds, dst + h, ldd, block);
+				}
+				else {
+					const std::size_t h = split_point(c);
+					copy_recursive(r, h, src, lds, dst, ldd, block);
+					copy_recursive(r, c - h, src + h, lds, dst + h*ldd, ldd, block);
+				}
+			}
+			// exchanges the r x c block a with the transpose of the c x r block b, both with leading dimension ld
+			template<typename Ty, class SwapFn>
+			void swap_recursive(std::size_t r, std::size_t c, Ty* a, Ty* b, std::size_t ld, SwapFn block) {
+				if (r <= base_size && c <= base_size) block(r, c, a, b, ld);
+				else if (r >= c) {
+					const std::size_t h = split_point(r);
+					swap_recursive(h, c, a, b, ld, block);
+					swap_recursive(r - h, c, a + h*ld, b + h, ld, block);
+				}
+				else {
+					const std::size_t h = split_point(c);
+					swap_recursive(r, h, a, b, ld, block);
+					swap_recursive(r, c - h, a + h, b + h*ld, ld, block);
+				}
+			}
+			// transposes the diagonal blocks in place and exchanges each pair of off-diagonal blocks
+			template<typename Ty, class SwapFn>
+			void square_recursive(std::size_t n, Ty* a, std::size_t ld, SwapFn block) {
+				if (n <= base_size) {
+					using std::swap;
+					for (std::size_t i = 0; i < n; ++i) {
+						for (std::size_t j = i + 1; j < n; ++j)
+							swap(a[i*ld + j], a[j*ld + i]);
+					}
+					return;
+				}
+				const std::size_t h = split_point(n);
+				square_recursive(h, a, ld, block);
+				square_recursive(n - h, a + h*ld + h, ld, block);
+				swap_recursive(h, n - h, a + h, a + h*ld, ld, block);
+			}
+		}
+		/**
+		 * \brief Writes the transpose of the `r x c` row-major matrix `src` to the `c x r` row-major matrix `dst`.
+		 *
+		 * The operands are halved recursively along their larger dimension until both dimensions are at most
+		 * 32, such that reads of `src` and writes of `dst` each stay within cache whatever its size ("cache
+		 * oblivious"). For `float` and `double` on x86 targets the resulting blocks are transposed as 4x4 or 8x8
+		 * register tiles using SSE2 or AVX2 shuffles depending upon the executing CPU, other element types are
+		 * copied element by element.
+		 *
+		 * \warning `dst` must not overlap `src`.
+		 * \param r Number of rows of `src` and columns of `dst`.
+		 * \param c Number of columns of `src` and rows of `dst`.
+		 * \param src Pointer to element `(0,0)` of the source.
+		 * \param lds Row stride of `src`, at least `c`.
+		 * \param dst Pointer to element `(0,0)` of the destination.
+		 * \param ldd Row stride of `dst`, at least `r`.
+		 * \complexity Linear in `r*c`.
+		 */
+		template<typename Ty>
+		void transpose(std::size_t r, std::size_t c, const Ty* src, std::size_t lds, Ty* dst, std::size_t ldd) {
+			if (!r || !c) return;
+			transpose_impl::copy_recursive(r, c, src, lds, dst, ldd,
+				transpose_impl::dispatcher<Ty, elementwise_impl::is_vectorizable<Ty>::value>::copy());
+		}
+		/**
+		 * \brief Transposes the `n x n` row-major matrix `a` in place.
+		 *
+		 * Diagonal blocks are transposed in place and off-diagonal blocks exchanged with the transpose of their
+		 * mirror image, recursing as for `transpose` such that both blocks of a pair stay within cache.
+		 *
+		 * \param n Number of rows and columns of `a`.
+		 * \param a Pointer to element `(0,0)`.
+		 * \param lda Row stride of `a`, at least `n`.
+		 * \complexity Linear in `n*n` (swaps).
+		 */
+		template<typename Ty>
+		void transpose_square(std::size_t n, Ty* a, std::size_t lda) {
+			transpose_impl::square_recursive(n, a, lda,
+				transpose_impl::dispatcher<Ty, elementwise_impl::is_vectorizable<Ty>::value>::swap());
+		}
+		/**
+		 * \brief Transposes the contiguous `r x c` row-major matrix `a` in place, such that it holds the `c x r`
+		 *        row-major transpose.
+		 *
+		 * Square matrices use `transpose_square`. Otherwise the element at offset `k` belongs at offset
+		 * `k*r mod (r*c - 1)`, and the permutation is applied by following each of its cycles in turn, tracking
+		 * visited offsets with one bit per element.
+		 *
+		 * \param r Number of rows of `a` before the transpose.
+		 * \param c Number of columns of `a` before the transpose.
+		 * \param a Pointer to the first of `r*c` contiguous elements.
+		 * \complexity Linear in `r*c` (swaps).
+		 * \exceptionsafety Basic guarantee if swapping elements may throw, otherwise no-throw guarantee other than
+		 *                  `std::bad_alloc` for the visited bits (thrown before any element is modified).
+		 */
+		template<typename Ty>
+		void transpose_inplace(std::size_t r, std::size_t c, Ty* a) {
+			if (r == c) {
+				transpose_square(r, a, r);
+				return;
+			}
+			if (r < 2U || c < 2U) return;
+			const std::size_t last = r*c - 1U;
+			std::vector<bool> visited(r*c, false);
+			using std::swap;
+			// offsets 0 and last are fixed points
+			for (std::size_t start = 1U; start < last; ++start) {
+				if (visited[start]) continue;
+				visited[start] = true;
+				// a[start] carries the element displaced at each step until the cycle closes
+				for (std::size_t k = start*r % last; k != start; k = k*r % last) {
+					swap(a[start], a[k]);
+					visited[k] = true;
+				}
+			}
+		}
+		/**
+		 * \enum reduction_op
+		 *
+		 * \brief Reductions supported by `reduce` and `accumulate`, over elements `x`:
+		 *
+		 * - `sum` - sum of `x`.
+		 * - `sum_squares` - sum of `x*x`.
+		 * - `sum_abs` - sum of `|x|`.
+		 * - `max_abs` - maximum of `|x|`, zero for no elements.
+		 * - `min` - minimum of `x`.
+		 * - `max` - maximum of `x`.
+		 */
+		enum class reduction_op {
+			sum,
+			sum_squares,
+			sum_abs,
+			max_abs,
+			min,
+			max
+		};
+		/**
+		 * \brief Detail namespace for implementation of the reduction kernels.
+		 */
+		namespace reduction_impl {
+			// elements reduced directly at each leaf of the pairwise summation tree
+			constexpr std::size_t pairwise_block = 512U;
+			// independent vector accumulators per leaf, hiding the latency of the add
+			constexpr std::size_t accumulators = 4U;
+			template<reduction_op Op>
+			using op_tag = std::integral_constant<reduction_op, Op>;
+			template<reduction_op Op>
+			struct is_summing : std::integral_constant<bool, Op == reduction_op::sum
+				|| Op == reduction_op::sum_squares || Op == reduction_op::sum_abs> {};
+			template<typename Ty>
+			Ty magnitude(const Ty& x) { return x < Ty() ? -x : x; }
+			// value of x contributed to the reduction
+			template<typename Ty> Ty term(const Ty& x, op_tag<reduction_op::sum>) { return x; }
+			template<typename Ty> Ty term(const Ty& x, op_tag<reduction_op::sum_squares>) { return x*x; }
+			template<typename Ty> Ty term(const Ty& x, op_tag<reduction_op::sum_abs>) { return magnitude(x); }
+			template<typename Ty> Ty term(const Ty& x, op_tag<reduction_op::max_abs>) { return magnitude(x); }
+			template<typename Ty> Ty term(const Ty& x, op_tag<reduction_op::min>) { return x; }
+			template<typename Ty> Ty term(const Ty& x, op_tag<reduction_op::max>) { return x; }
+			// combines two partial results
+			template<reduction_op Op, typename Ty>
+			Ty merge(const Ty& a, const Ty& b, std::true_type) { return a + b; }
+			template<reduction_op Op, typename Ty>
+			Ty merge(const Ty& a, const Ty& b, std::false_type) {
+				return (Op == reduction_op::min) ? (b < a ? b : a) : (a < b ? b : a);
+			}
+			template<reduction_op Op, typename Ty>
+			Ty merge(const Ty& a, const Ty& b) { return merge<Op>(a, b, is_summing<Op>{}); }
+			template<reduction_op Op, typename Ty>
+			Ty initial(const Ty* a) { return (Op == reduction_op::min || Op == reduction_op::max) ? a[0] : Ty(); }
+			template<reduction_op Op, typename Ty>
+			Ty scalar_leaf(const Ty* a, std::size_t n) {
+				Ty result = initial<Op>(a);
+				for (std::size_t i = 0; i < n; ++i) result = merge<Op>(result, term(a[i], op_tag<Op>{}));
+				return result;
+			}
+			template<typename Ty>
+			Ty scalar_dot_leaf(const Ty* a, const Ty* b, std::size_t n) {
+				Ty result = Ty();
+				for (std::size_t i = 0; i < n; ++i) result += a[i] * b[i];
+				return result;
+			}
+			// Kahan summation of value into (acc, comp), or the plain reduction for min and max operations
+			template<reduction_op Op, typename Ty>
+			void compensated_merge(Ty& acc, Ty& comp, const Ty& value, std::true_type) {
+				const Ty y = value - comp;
+				const Ty t = acc + y;
+				comp = (t - acc) - y;
+				acc = t;
+			}
+			template<reduction_op Op, typename Ty>
+			void compensated_merge(Ty& acc, Ty&, const Ty& value, std::false_type) {
+				acc = merge<Op>(acc, value);
+			}
+			template<reduction_op Op, typename Ty>
+			void scalar_accumulate(const Ty* a, Ty* acc, Ty* comp, std::size_t n) {
+				for (std::size_t i = 0; i < n; ++i)
+					compensated_merge<Op>(acc[i], comp[i], term(a[i], op_tag<Op>{}), is_summing<Op>{});
+			}
+			// sum over [first, first + n) of the leaf results of blocks of at most pairwise_block elements
+			template<typename Ty, class Leaf>
+			Ty pairwise(std::size_t first, std::size_t n, const Leaf& leaf) {
+				if (n <= pairwise_block) return leaf(first, n);
+				const std::size_t half = (n / 2U + pairwise_block - 1U) / pairwise_block * pairwise_block;
+				return pairwise<Ty>(first, half, leaf) + pairwise<Ty>(first + half, n - half, leaf);
+			}
+#if defined(CRSC_SIMD_X86)
+			// as for the elementwise loops, each instruction set has its own copy of the leaf loops
+			template<class V, reduction_op Op>
+			CRSC_TARGET("sse2") typename V::value_type sse2_leaf(const typename V::value_type* a, std::size_t n) {
+				typedef typename V::reg reg;
+				typename V::value_type result = initial<Op>(a);
+				std::size_t i = 0;
+				if (n >= accumulators*V::width) {
+					reg r[accumulators];
+					for (std::size_t q = 0; q < accumulators; ++q) r[q] = V::set1(result);
+					for (; i + accumulators*V::width <= n; i += accumulators*V::width) {
+						for (std::size_t q = 0; q < accumulators; ++q) {
+							const reg x = V::load(a + i + q*V::width);
+							r[q] = Op == reduction_op::sum ? V::add(r[q], x)
+								: Op == reduction_op::sum_squares ? V::add(r[q], V::mul(x, x))
+								: Op == reduction_op::sum_abs ? V::add(r[q], V::abs(x))
+								: Op == reduction_op::max_abs ? V::max(r[q], V::abs(x))
+								: Op == reduction_op::min ? V::min(r[q], x) : V::max(r[q], x);
+						}
+					}
+					for (std::size_t q = 1; q < accumulators; ++q)
+						r[0] = is_summing<Op>::value ? V::add(r[0], r[q]) : Op == reduction_op::min ? V::min(r[0], r[q]) : V::max(r[0], r[q]);
+					typename V::value_type lanes[V::width];
+					V::store(lanes, r[0]);
+					result = lanes[0];
+					for (std::size_t q = 1; q < V::width; ++q) result = merge<Op>(result, lanes[q]);
+				}
+				for (; i < n; ++i) result = merge<Op>(result, term(a[i], op_tag<Op>{}));
+				return result;
+			}
+			template<class V, reduction_op Op>
+			CRSC_TARGET("avx2") typename V::value_type avx2_leaf(const typename V::value_type* a, std::size_t n) {
+				typedef typename V::reg reg;
+				typename V::value_type result = initial<Op>(a);
+				std::size_t i = 0;
+				if (n >= accumulators*V::width) {
+					reg r[accumulators];
+					for (std::size_t q = 0; q < accumulators; ++q) r[q] = V::set1(result);
+					for (; i + accumulators*V::width <= n; i += accumulators*V::width) {
+						for (std::size_t q = 0; q < accumulators; ++q) {
+							const reg x = V::load(a + i + q*V::width);
+							r[q] = Op == reduction_op::sum ? V::add(r[q], x)
+								: Op == reduction_op::sum_squares ? V::add(r[q], V::mul(x, x))
+								: Op == reduction_op::sum_abs ? V::add(r[q], V::abs(x))
+								: Op == reduction_op::max_abs ? V::max(r[q], V::abs(x))
+								: Op == reduction_op::min ? V::min(r[q], x) : V::max(r[q], x);
+						}
+					}
+					for (std::size_t q = 1; q < accumulators; ++q)
+						r[0] = is_summing<Op>::value ? V::add(r[0], r[q]) : Op == reduction_op::min ? V::min(r[0], r[q]) : V::max(r[0], r[q]);
+					typename V::value_type lanes[V::width];
+					V::store(lanes, r[0]);
+					result = lanes[0];
+					for (std::size_t q = 1; q < V::width; ++q) result = merge<Op>(result, lanes[q]);
+				}
+				for (; i < n; ++i) result = merge<Op>(result, term(a[i], op_tag<Op>{}));
+				return result;
+			}
+			template<class V, reduction_op Op>
+			CRSC_TARGET("avx512f") typename V::value_type avx512_leaf(const typename V::value_type* a, std::size_t n) {
+				typedef typename V::reg reg;
+				typename V::value_type result = initial<Op>(a);
+				std::size_t i = 0;
+				if (n >= accumulators*V::width) {
+					reg r[accumulators];
+					for (std::size_t q = 0; q < accumulators; ++q) r[q] = V::set1(result);
+					for (; i + accumulators*V::width <= n; i += accumulators*V::width) {
+						for (std::size_t q = 0; q < accumulators; ++q) {
+							const reg x = V::load(a + i + q*V::width);
+							r[q] = Op == reduction_op::sum ? V::add(r[q], x)
+								: Op == reduction_op::sum_squares ? V::add(r[q], V::mul(x, x))
+								: Op == reduction_op::sum_abs ? V::add(r[q], V::abs(x))
+								: Op == reduction_op::max_abs ? V::max(r[q], V::abs(x))
+								: Op == reduction_op::min ? V::min(r[q], x) : V::max(r[q], x);
+						}
+					}
+					for (std::size_t q = 1; q < accumulators; ++q)
+						r[0] = is_summing<Op>::value ? V::add(r[0], r[q]) : Op == reduction_op::min ? V::min(r[0], r[q]) : V::max(r[0], r[q]);
+					typename V::value_type lanes[V::width];
+					V::store(lanes, r[0]);
+					result = lanes[0];
+					for (std::size_t q = 1; q < V::width; ++q) result = merge<Op>(result, lanes[q]);
+				}
+				for (; i < n; ++i) result = merge<Op>(result, term(a[i], op_tag<Op>{}));
+				return result;
+			}
+			template<class V>
+			CRSC_TARGET("sse2") typename V::value_type sse2_dot_leaf(const typename V::value_type* a,
+				const typename V::value_type* b, std::size_t n) {
+				typedef typename V::reg reg;
+				typename V::value_type result = typename V::value_type();
+				std::size_t i = 0;
+				if (n >= accumulators*V::width) {
+					reg r[accumulators];
+					for (std::size_t q = 0; q < accumulators; ++q) r[q] = V::set1(result);
+					for (; i + accumulators*V::width <= n; i += accumulators*V::width) {
+						for (std::size_t q = 0; q < accumulators; ++q)
+							r[q] = V::add(r[q], V::mul(V::load(a + i + q*V::width), V::load(b + i + q*V::width)));
+					}
+					for (std::size_t q = 1; q < accumulators; ++q) r[0] = V::add(r[0], r[q]);
+					typename V::value_type lanes[V::width];
+					V::store(lanes, r[0]);
+					for (std::size_t q = 0; q < V::width; ++q) result += lanes[q];
+				}
+				for (; i < n; ++i) result += a[i] * b[i];
+				return result;
+			}
+			template<class V>
+			CRSC_TARGET("avx2") typename V::value_type avx2_dot_leaf(const typename V::value_type* a,
+				const typename V::value_type* b, std::size_t n) {
+				typedef typename V::reg reg;
+				typename V::value_type result = typename V::value_type();
+				std::size_t i = 0;
+				if (n >= accumulators*V::width) {
+					reg r[accumulators];
+					for (std::size_t q = 0; q < accumulators; ++q) r[q] = V::set1(result);
+					for (; i + accumulators*V::width <= n; i += accumulators*V::width) {
+						for (std::size_t q = 0; q < accumulators; ++q)
+							r[q] = V::add(r[q], V::mul(V::load(a + i + q*V::width), V::load(b + i + q*V::width)));
+					}
+					for (std::size_t q = 1; q < accumulators; ++q) r[0] = V::add(r[0], r[q]);
+					typename V::value_type lanes[V::width];
+					V::store(lanes, r[0]);
+					for (std::size_t q = 0; q < V::width; ++q) result += lanes[q];
+				}
+				for (; i < n; ++i) result += a[i] * b[i];
+				return result;
+			}
+			template<class V>
+			CRSC_TARGET("avx512f") typename V::value_type avx512_dot_leaf(const typename V::value_type* a,
+				const typename V::value_type* b, std::size_t n) {
+				typedef typename V::reg reg;
+				typename V::value_type result = typename V::value_type();
+				std::size_t i = 0;
+				if (n >= accumulators*V::width) {
+					reg r[accumulators];
+					for (std::size_t q = 0; q < accumulators; ++q) r[q] = V::set1(result);
+					for (; i + accumulators*V::width <= n; i += accumulators*V::width) {
+						for (std::size_t q = 0; q < accumulators; ++q)
+							r[q] = V::add(r[q], V::mul(V::load(a + i + q*V::width), V::load(b + i + q*V::width)));
+					}
+					for (std::size_t q = 1; q < accumulators; ++q) r[0] = V::add(r[0], r[q]);
+					typename V::value_type lanes[V::width];
+					V::store(lanes, r[0]);
+					for (std::size_t q = 0; q < V::width; ++q) result += lanes[q];
+				}
+				for (; i < n; ++i) result += a[i] * b[i];
+				return result;
+			}
+			template<class V, reduction_op Op>
+			CRSC_TARGET("sse2") void sse2_accumulate(const typename V::value_type* a, typename V::value_type* acc,
+				typename V::value_type* comp, std::size_t n) {
+				typedef typename V::reg reg;
+				std::size_t i = 0;
+				for (; i + V::width <= n; i += V::width) {
+					const reg x = V::load(a + i);
+					const reg s = V::load(acc + i);
+					if (is_summing<Op>::value) {
+						const reg y = V::sub(Op == reduction_op::sum ? x : Op == reduction_op::sum_squares ? V::mul(x, x) : V::abs(x),
+							V::load(comp + i));
+						const reg t = V::add(s, y);
+						V::store(comp + i, V::sub(V::sub(t, s), y));
+						V::store(acc + i, t);
+					}
+					else V::store(acc + i, Op == reduction_op::max_abs ? V::max(s, V::abs(x)) : Op == reduction_op::min ? V::min(s, x) : V::max(s, x));
+				}
+				scalar_accumulate<Op>(a + i, acc + i, comp + i, n - i);
+			}
+			template<class V, reduction_op Op>
+			CRSC_TARGET("avx2") void avx2_accumulate(const typename V::value_type* a, typename V::value_type* acc,
+				typename V::value_type* comp, std::size_t n) {
+				typedef typename V::reg reg;
+				std::size_t i = 0;
+				for (; i + V::width <= n; i += V::width) {
+					const reg x = V::load(a + i);
+					const reg s = V::load(acc + i);
+					if (is_summing<Op>::value) {
+						const reg y = V::sub(Op == reduction_op::sum ? x : Op == reduction_op::sum_squares ? V::mul(x, x) : V::abs(x),
+							V::load(comp + i));
+						const reg t = V::add(s, y);
+						V::store(comp + i, V::sub(V::sub(t, s), y));
+						V::store(acc + i, t);
+					}
+					else V::store(acc + i, Op == reduction_op::max_abs ? V::max(s, V::abs(x)) : Op == reduction_op::min ? V::min(s, x) : V::max(s, x));
+				}
+				scalar_accumulate<Op>(a + i, acc + i, comp + i, n - i);
+			}
+			template<class V, reduction_op Op>
+			CRSC_TARGET("avx512f") void avx512_accumulate(const typename V::value_type* a, typename V::value_type* acc,
+				typename V::value_type* comp, std::size_t n) {
+				typedef typename V::reg reg;
+				std::size_t i = 0;
+				for (; i + V::width <= n; i += V::width) {
+					const reg x = V::load(a + i);
+					const reg s = V::load(acc + i);
+					if (is_summing<Op>::value) {
+						const reg y = V::sub(Op == reduction_op::sum ? x : Op == reduction_op::sum_squares ? V::mul(x, x) : V::abs(x),
+							V::load(comp + i));
+						const reg t = V::add(s, y);
+						V::store(comp + i, V::sub(V::sub(t, s), y));
+						V::store(acc + i, t);
+					}
+					else V::store(acc + i, Op == reduction_op::max_abs ? V::max(s, V::abs(x)) : Op == reduction_op::min ? V::min(s, x) : V::max(s, x));
+				}
+				scalar_accumulate<Op>(a + i, acc + i, comp + i, n - i);
+			}
+			// selects the widest loops supported by the executing CPU, once per (operation, type) pair
+			template<reduction_op Op, typename Ty>
+			struct dispatcher {
+				typedef Ty(*leaf_fn)(const Ty*, std::size_t);
+				typedef void(*accumulate_fn)(const Ty*, Ty*, Ty*, std::size_t);
+				static leaf_fn select_leaf() noexcept {
+					switch (detect_simd_level()) {
+					case simd_level::avx512: return &avx512_leaf<simd::avx512_vec<Ty>, Op>;
+					case simd_level::avx2: return &avx2_leaf<simd::avx2_vec<Ty>, Op>;
+					case simd_level::sse2: return &sse2_leaf<simd::sse2_vec<Ty>, Op>;
+					default: return &scalar_leaf<Op, Ty>;
+					}
+				}
+				static accumulate_fn select_accumulate() noexcept {
+					switch (detect_simd_level()) {
+					case simd_level::avx512: return &avx512_accumulate<simd::avx512_vec<Ty>, Op>;
+					case simd_level::avx2: return &avx2_accumulate<simd::avx2_vec<Ty>, Op>;
+					case simd_level::sse2: return &sse2_accumulate<simd::sse2_vec<Ty>, Op>;
+					default: return &scalar_accumulate<Op, Ty>;
+					}
+				}
+				static leaf_fn leaf() noexcept {
+					static const leaf_fn fn = select_leaf();
+					return fn;
+				}
+				static accumulate_fn accumulate() noexcept {
+					static const accumulate_fn fn = select_accumulate();
+					return fn;
+				}
+			};
+			template<typename Ty>
+			struct dot_dispatcher {
+				typedef Ty(*leaf_fn)(const Ty*, const Ty*, std::size_t);
+				static leaf_fn select() noexcept {
+					switch (detect_simd_level()) {
+					case simd_level::avx512: return &avx512_dot_leaf<simd::avx512_vec<Ty>>;
+					case simd_level::avx2: return &avx2_dot_leaf<simd::avx2_vec<Ty>>;
+					case simd_level::sse2: return &sse2_dot_leaf<simd::sse2_vec<Ty>>;
+					default: return &scalar_dot_leaf<Ty>;
+					}
+				}
+				static leaf_fn get() noexcept {
+					static const leaf_fn fn = select();
+					return fn;
+				}
+			};
+			template<reduction_op Op, typename Ty>
+			typename dispatcher<Op, Ty>::leaf_fn leaf_loop(std::true_type) { return dispatcher<Op, Ty>::leaf(); }
+			template<reduction_op Op, typename Ty>
+			typename dispatcher<Op, Ty>::accumulate_fn accumulate_loop(std::true_type) { return dispatcher<Op, Ty>::accumulate(); }
+			template<typename Ty>
+			typename dot_dispatcher<Ty>::leaf_fn dot_loop(std::true_type) { return dot_dispatcher<Ty>::get(); }
+#endif
+			template<reduction_op Op, typename Ty>
+			Ty(*leaf_loop(std::false_type))(const Ty*, std::size_t) { return &scalar_leaf<Op, Ty>; }
+			template<reduction_op Op, typename Ty>
+			void(*accumulate_loop(std::false_type))(const Ty*, Ty*, Ty*, std::size_t) { return &scalar_accumulate<Op, Ty>; }
+			template<typename Ty>
+			Ty(*dot_loop(std::false_type))(const Ty*, const Ty*, std::size_t) { return &scalar_dot_leaf<Ty>; }
+			template<reduction_op Op, typename Ty>
+			Ty reduce(const Ty* a, std::size_t n, std::true_type) {
+				const auto leaf = leaf_loop<Op, Ty>(elementwise_impl::is_vectorizable<Ty>{});
+				return pairwise<Ty>(0U, n, [a, leaf](std::size_t first, std::size_t count) { return leaf(a + first, count); });
+			}
+			template<reduction_op Op, typename Ty>
+			Ty reduce(const Ty* a, std::size_t n, std::false_type) {
+				return leaf_loop<Op, Ty>(elementwise_impl::is_vectorizable<Ty>{})(a, n);
+			}
+		}
+		/**
+		 * \brief Reduces `n` contiguous elements by the operation `Op` (see `reduction_op`).
+		 *
+		 * Sums are computed pairwise over blocks of elements, each block being accumulated in several independent
+		 * vector registers, such that the rounding error grows with the logarithm of `n` rather than with `n`. For
+		 * `float` and `double` on x86 targets the blocks use the widest instruction set available on the executing
+		 * CPU (see `crsc::detect_simd_level`), other element types use scalar loops.
+		 *
+		 * \param a Range of `n` elements, with `n > 0` for `reduction_op::min` and `reduction_op::max`.
+		 * \param n Number of elements.
+		 * \return Result of the reduction, `Ty()` for no elements where defined.
+		 * \remark The result for ranges containing NaN is unspecified.
+		 * \complexity Linear in `n`.
+		 */
+		template<reduction_op Op, typename Ty>
+		Ty reduce(const Ty* a, std::size_t n) {
+			return reduction_impl::reduce<Op>(a, n, reduction_impl::is_summing<Op>{});
+		}
+		/**
+		 * \brief Computes the dot product `sum(a[i] * b[i])` of `n` contiguous elements, summed pairwise as for `reduce`.
+		 *
+		 * \complexity Linear in `n`.
+		 */
+		template<typename Ty>
+		Ty dot(const Ty* a, const Ty* b, std::size_t n) {
+			const auto leaf = reduction_impl::dot_loop<Ty>(elementwise_impl::is_vectorizable<Ty>{});
+			return reduction_impl::pairwise<Ty>(0U, n, [a, b, leaf](std::size_t first, std::size_t count) {
+				return leaf(a + first, b + first, count);
+			});
+		}
+		/**
+		 * \brief Accumulates `n` contiguous elements into `n` running reductions by the operation `Op`, i.e. reduces
+		 *        `acc[i]` with `a[i]` for `i` in `[0, n)`.
+		 *
+		 * For summing operations each running sum carries the Kahan compensation `comp[i]` of its rounding error,
+		 * such that the accuracy of the final sums does not degrade with the number of accumulated ranges. This is
+		 * the reduction across rows of a row-major matrix (or columns of a column-major one), where pairwise
+		 * summation would need a temporary per level. `comp` is not accessed for `min`, `max` and `max_abs`.
+		 *
+		 * \remark `acc` must initially hold `Ty()` for summing operations and `max_abs`, or the first range for `min`
+		 *         and `max`, and `comp` must initially hold `Ty()`. The compensation is removed by value-changing
+		 *         floating point optimisations such as `-ffast-math`.
+		 * \complexity Linear in `n`.
+		 */
+		template<reduction_op Op, typename Ty>
+		void accumulate(const Ty* a, Ty* acc, Ty* comp, std::size_t n) {
+			reduction_impl::accumulate_loop<Op, Ty>(elementwise_impl::is_vectorizable<Ty>{})(a, acc, comp, n);
+		}
+		/**
+		 * \brief Reduces the running reduction `(acc, comp)` (see `accumulate`) with a single partial result `value`.
+		 */
+		template<reduction_op Op, typename Ty>
+		void accumulate(Ty& acc, Ty& comp, const Ty& value) {
+			reduction_impl::compensated_merge<Op>(acc, comp, value, reduction_impl::is_summing<Op>{});
+		}
+		/**
+		 * \brief Returns the index of the first minimum of `n > 0` contiguous elements.
+		 *
+		 * The minimum is found by `reduce` and its index by a second, scalar pass which usually ends early.
+		 *
+		 * \complexity Linear in `n`.
+		 */
+		template<typename Ty>
+		std::size_t argmin(const Ty* a, std::size_t n) {
+			const Ty value = reduce<reduction_op::min>(a, n);
+			const Ty* it = std::find(a, a + n, value);
+			return static_cast<std::size_t>((it != a + n ? it : std::min_element(a, a + n)) - a);
+		}
+		/**
+		 * \brief Returns the index of the first maximum of `n > 0` contiguous elements.
+		 *
+		 * \complexity Linear in `n`.
+		 */
+		template<typename Ty>
+		std::size_t argmax(const Ty* a, std::size_t n) {
+			const Ty value = reduce<reduction_op::max>(a, n);
+			const Ty* it = std::find(a, a + n, value);
+			return static_cast<std::size_t>((it != a + n ? it : std::max_element(a, a + n)) - a);
+		}
+	}
+}
+
+#endif // !MATRIX_KERNELS_H
@@ -0,0 +1,110 @@
+#ifndef MATRIX_LAYOUT_H
+#define MATRIX_LAYOUT_H
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+namespace crsc {
+	/**
+	 * \brief Storage layout policies for `crsc::dynamic_matrix`, mapping the logical position `(i,j)` of an element
+	 *        in a `rows` by `cols` matrix to the offset of that element in contiguous storage.
+	 *
+	 * Every layout policy provides:
+	 *
+	 * - `offset(i, j, rows, cols)` giving the storage offset of element `(i,j)`.
+	 * - `for_each_index(rows, cols, f)` invoking `f(i, j)` for every element in storage order, i.e. such
+	 *   that the `k`-th invocation corresponds to the element at storage offset `k`.
+	 *
+	 * Layouts for which `is_strided_layout` holds additionally provide `row_stride(rows, cols)` and
+	 * `column_stride(rows, cols)` such that `offset(i, j, rows, cols) == i*row_stride + j*column_stride`.
+	 */
+	/**
+	 * \struct row_major
+	 *
+	 * \brief Elements are stored row by row, such that each row is contiguous.
+	 */
+	struct row_major {
+		static std::size_t offset(std::size_t i, std::size_t j, std::size_t, std::size_t cols) noexcept {
+			return i*cols + j;
+		}
+		static std::size_t row_stride(std::size_t, std::size_t cols) noexcept { return cols; }
+		static std::size_t column_stride(std::size_t, std::size_t) noexcept { return 1U; }
+		template<class Fn>
+		static void for_each_index(std::size_t rows, std::size_t cols, Fn&& f) {
+			for (std::size_t i = 0; i < rows; ++i) {
+				for (std::size_t j = 0; j < cols; ++j) f(i, j);
+			}
+		}
+	};
+	/**
+	 * \struct column_major
+	 *
+	 * \brief Elements are stored column by column, such that each column is contiguous.
+	 */
+	struct column_major {
+		static std::size_t offset(std::size_t i, std::size_t j, std::size_t rows, std::size_t) noexcept {
+			return j*rows + i;
+		}
+		static std::size_t row_stride(std::size_t, std::size_t) noexcept { return 1U; }
+		static std::size_t column_stride(std::size_t rows, std::size_t) noexcept { return rows; }
+		template<class Fn>
+		static void for_each_index(std::size_t rows, std::size_t cols, Fn&& f) {
+			for (std::size_t j = 0; j < cols; ++j) {
+				for (std::size_t i = 0; i < rows; ++i) f(i, j);
+			}
+		}
+	};
+	/**
+	 * \struct tiled
+	 *
+	 * \brief Elements are stored in square tiles of `TileSize` by `TileSize` elements, each tile being contiguous
+	 *        and stored row-major, with the tiles themselves in row-major order.
+	 *
+	 * Tiles on the bottom and right edges of a matrix whose dimensions are not multiples of `TileSize` are
+	 * truncated rather than padded, so the storage holds exactly `rows*cols` elements. Every element of a tile
+	 * is close in memory to its neighbours in both directions, which keeps blocked algorithms such as the
+	 * matrix product within cache without packing.
+	 *
+	 * \tparam TileSize Number of rows and columns in each (full) tile.
+	 */
+	template<std::size_t TileSize = 64U>
+	struct tiled {
+		static_assert(TileSize > 0U, "tiled layout requires TileSize > 0.");
+		static constexpr std::size_t tile_size = TileSize;
+		static std::size_t offset(std::size_t i, std::size_t j, std::size_t rows, std::size_t cols) noexcept {
+			const std::size_t ti = i / TileSize*TileSize;
+			const std::size_t tj = j / TileSize*TileSize;
+			const std::size_t height = std::min(TileSize, rows - ti);
+			const std::size_t width = std::min(TileSize, cols - tj);
+			return ti*cols + tj*height + (i - ti)*width + (j - tj);
+		}
+		template<class Fn>
+		static void for_each_index(std::size_t rows, std::size_t cols, Fn&& f) {
+			for (std::size_t ti = 0; ti < rows; ti += TileSize) {
+				const std::size_t height = std::min(TileSize, rows - ti);
+				for (std::size_t tj = 0; tj < cols; tj += TileSize) {
+					const std::size_t width = std::min(TileSize, cols - tj);
+					for (std::size_t i = ti; i < ti + height; ++i) {
+						for (std::size_t j = tj; j < tj + width; ++j) f(i, j);
+					}
+				}
+			}
+		}
+	};
+	template<std::size_t TileSize>
+	constexpr std::size_t tiled<TileSize>::tile_size;
+	/**
+	 * \struct is_strided_layout
+	 *
+	 * \brief Trait indicating whether the layout policy `Layout` addresses elements through a row stride and a
+	 *        column stride, such that rows and columns can be described to strided kernels directly.
+	 */
+	template<class Layout>
+	struct is_strided_layout : std::false_type {};
+	template<>
+	struct is_strided_layout<row_major> : std::true_type {};
+	template<>
+	struct is_strided_layout<column_major> : std::true_type {};
+}
+
+#endif // !MATRIX_LAYOUT_H
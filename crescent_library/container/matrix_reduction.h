@@ -0,0 +1,741 @@
+#ifndef MATRIX_REDUCTION_H
+#define MATRIX_REDUCTION_H
+#include "dynamic_matrix.h"
+#include "matrix_kernels.h"
+#include "matrix_layout.h"
+#include "threading_utilities.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace crsc {
+	/**
+	 * \enum reduction_axis
+	 *
+	 * \brief Direction of a reduction over a matrix which gives a vector of results.
+	 *
+	 * - `per_row` - each row is reduced, giving `rows()` results.
+	 * - `per_column` - each column is reduced, giving `columns()` results.
+	 */
+	enum class reduction_axis {
+		per_row,
+		per_column
+	};
+	/**
+	 * \enum vector_norm
+	 *
+	 * \brief Norms of the rows or columns of a matrix computed by `vector_norms`.
+	 *
+	 * - `l1` - sum of the absolute values of the elements.
+	 * - `l2` - square root of the sum of the squares of the elements.
+	 * - `linf` - maximum of the absolute values of the elements.
+	 */
+	enum class vector_norm {
+		l1,
+		l2,
+		linf
+	};
+	namespace parallel_cutoffs {
+		// elements of the matrix, i.e. rows()*columns()
+		constexpr std::size_t reduction = 1U << 16;
+	}
+	/**
+	 * \brief Detail namespace for implementation of the matrix reductions.
+	 *
+	 * A reducer describes a reduction to the layout traversals in terms of contiguous runs of storage, which
+	 * either lie within a single row (or column) being reduced, `segment`, or span consecutive rows (or columns)
+	 * being reduced, `across`. Partial results are merged with Kahan compensation.
+	 */
+	namespace matrix_reduction_impl {
+		template<kernels::reduction_op Op, typename Ty>
+		struct op_reducer {
+			const Ty* a;
+			Ty segment(std::size_t offset, std::size_t n) const { return kernels::reduce<Op>(a + offset, n); }
+			void across(std::size_t offset, Ty* acc, Ty* comp, std::size_t n) { kernels::accumulate<Op>(a + offset, acc, comp, n); }
+			void merge(Ty& acc, Ty& comp, const Ty& value) const { kernels::accumulate<Op>(acc, comp, value); }
+		};
+		template<typename Ty>
+		struct dot_reducer {
+			const Ty* a;
+			const Ty* b;
+			std::vector<Ty> products;
+			Ty segment(std::size_t offset, std::size_t n) const { return kernels::dot(a + offset, b + offset, n); }
+			void across(std::size_t offset, Ty* acc, Ty* comp, std::size_t n) {
+				if (products.size() < n) products.resize(n);
+				kernels::hadamard(a + offset, b + offset, products.data(), n);
+				kernels::accumulate<kernels::reduction_op::sum>(products.data(), acc, comp, n);
+			}
+			void merge(Ty& acc, Ty& comp, const Ty& value) const { kernels::accumulate<kernels::reduction_op::sum>(acc, comp, value); }
+		};
+		// reduces each of rows [first, last) of the m by n matrix into acc and comp
+		template<class Reducer, typename Ty>
+		void reduce_rows(Reducer& r, std::size_t first, std::size_t last, std::size_t, std::size_t n, Ty* acc, Ty* comp, row_major) {
+			for (std::size_t i = first; i < last; ++i) r.merge(acc[i], comp[i], r.segment(i*n, n));
+		}
+		template<class Reducer, typename Ty>
+		void reduce_rows(Reducer& r, std::size_t first, std::size_t last, std::size_t m, std::size_t n, Ty* acc, Ty* comp, column_major) {
+			for (std::size_t j = 0; j < n; ++j) r.across(j*m + first, acc + first, comp + first, last - first);
+		}
+		// as above for tiled layouts, where first is a multiple of the tile size
+		template<class Reducer, typename Ty, std::size_t TileSize>
+		void reduce_rows(Reducer& r, std::size_t first, std::size_t last, std::size_t m, std::size_t n, Ty* acc, Ty* comp, tiled<TileSize>) {
+			for (std::size_t ti = first; ti < last; ti += TileSize) {
+				const std::size_t height = std::min(TileSize, m - ti);
+				for (std::size_t tj = 0; tj < n; tj += TileSize) {
+					const std::size_t width = std::min(TileSize, n - tj);
+					const std::size_t offset = tiled<TileSize>::offset(ti, tj, m, n);
+					for (std::size_t q = 0; q < height; ++q)
+						r.merge(acc[ti + q], comp[ti + q], r.segment(offset + q*width, width));
+				}
+			}
+		}
+		// reduces each of columns [first, last) of the m by n matrix into acc and comp, the columns of a row-major
+		// matrix being the rows of its column-major transpose and vice versa
+		template<class Reducer, typename Ty>
+		void reduce_columns(Reducer& r, std::size_t first, std::size_t last, std::size_t m, std::size_t n, Ty* acc, Ty* comp, row_major) {
+			reduce_rows(r, first, last, n, m, acc, comp, column_major());
+		}
+		template<class Reducer, typename Ty>
+		void reduce_columns(Reducer& r, std::size_t first, std::size_t last, std::size_t m, std::size_t n, Ty* acc, Ty* comp, column_major) {
+			reduce_rows(r, first, last, n, m, acc, comp, row_major());
+		}
+		template<class Reducer, typename Ty, std::size_t TileSize>
+		void reduce_columns(Reducer& r, std::size_t first, std::size_t last, std::size_t m, std::size_t n, Ty* acc, Ty* comp, tiled<TileSize>) {
+			for (std::size_t ti = 0; ti < m; ti += TileSize) {
+				const std::size_t height = std::min(TileSize, m - ti);
+				for (std::size_t tj = first; tj < last; tj += TileSize) {
+					const std::size_t width = std::min(TileSize, n - tj);
+					const std::size_t offset = tiled<TileSize>::offset(ti, tj, m, n);
+					for (std::size_t q = 0; q < height; ++q)
+						r.across(offset + q*width, acc + tj, comp + tj, width);
+				}
+			}
+		}
+		template<class Reducer, typename Ty, class Layout>
+		void reduce_axis(Reducer& r, reduction_axis axis, std::size_t first, std::size_t last, std::size_t m, std::size_t n,
+			Ty* acc, Ty* comp, Layout) {
+			if (axis == reduction_axis::per_row) reduce_rows(r, first, last, m, n, acc, comp, Layout());
+			else reduce_columns(r, first, last, m, n, acc, comp, Layout());
+		}
+		// granularity in results at which reduce_axis may split a reduction: a tile, or a cache line of results
+		template<typename Ty, class Layout>
+		std::size_t axis_alignment(Layout) { return std::max<std::size_t>(1U, 64U / sizeof(Ty)); }
+		template<typename Ty, std::size_t TileSize>
+		std::size_t axis_alignment(tiled<TileSize>) { return TileSize; }
+		template<typename Ty, class Allocator, class Layout, class Reducer>
+		std::vector<Ty, Allocator> axis_result(const dynamic_matrix<Ty, Allocator, Layout>& dm, reduction_axis axis, Reducer r) {
+			const std::size_t count = (axis == reduction_axis::per_row) ? dm.rows() : dm.columns();
+			std::vector<Ty, Allocator> acc(count, Ty());
+			std::vector<Ty, Allocator> comp(count, Ty());
+			reduce_axis(r, axis, 0U, count, dm.rows(), dm.columns(), acc.data(), comp.data(), Layout());
+			return acc;
+		}
+		template<typename Ty, class Allocator, class Layout, class Reducer>
+		std::vector<Ty, Allocator> axis_result(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& dm, reduction_axis axis,
+			const Reducer& r, std::size_t cutoff) {
+			const std::size_t count = (axis == reduction_axis::per_row) ? dm.rows() : dm.columns();
+			const std::size_t align = axis_alignment<Ty>(Layout());
+			if (dm.size() < cutoff || pool.size() < 2U || count < 2U * align) return axis_result(dm, axis, r);
+			std::vector<Ty, Allocator> acc(count, Ty());
+			std::vector<Ty, Allocator> comp(count, Ty());
+			const std::size_t m = dm.rows(), n = dm.columns();
+			Ty* pacc = acc.data();
+			Ty* pcomp = comp.data();
+			pool.parallel_for(0U, count, dynamic_matrix_parallel_impl::chunk_size(count, pool.size() + 1U, align),
+				[=](std::size_t first, std::size_t last) {
+				Reducer local = r;
+				reduce_axis(local, axis, first, last, m, n, pacc, pcomp, Layout());
+			});
+			return acc;
+		}
+		// partial results of reduce over contiguous chunks of the n elements of a, merged in order
+		template<kernels::reduction_op Op, typename Ty>
+		Ty parallel_reduce(thread_pool& pool, const Ty* a, std::size_t n) {
+			const std::size_t chunk = dynamic_matrix_parallel_impl::chunk_size(n, pool.size() + 1U, 64U);
+			std::vector<Ty> partials((n + chunk - 1) / chunk, Ty());
+			pool.parallel_for(0U, n, chunk, [a, chunk, &partials](std::size_t first, std::size_t last) {
+				partials[first / chunk] = kernels::reduce<Op>(a + first, last - first);
+			});
+			Ty acc = Ty(), comp = Ty();
+			for (const auto& partial : partials) kernels::accumulate<Op>(acc, comp, partial);
+			return acc;
+		}
+		template<typename Ty>
+		Ty parallel_dot(thread_pool& pool, const Ty* a, const Ty* b, std::size_t n) {
+			const std::size_t chunk = dynamic_matrix_parallel_impl::chunk_size(n, pool.size() + 1U, 64U);
+			std::vector<Ty> partials((n + chunk - 1) / chunk, Ty());
+			pool.parallel_for(0U, n, chunk, [a, b, chunk, &partials](std::size_t first, std::size_t last) {
+				partials[first / chunk] = kernels::dot(a + first, b + first, last - first);
+			});
+			Ty acc = Ty(), comp = Ty();
+			for (const auto& partial : partials) kernels::accumulate<kernels::reduction_op::sum>(acc, comp, partial);
+			return acc;
+		}
+		template<typename Ty>
+		Ty square_root(const Ty& x) {
+			using std::sqrt;
+			return static_cast<Ty>(sqrt(x));
+		}
+		template<typename Ty, class Allocator>
+		std::vector<Ty, Allocator>& square_roots(std::vector<Ty, Allocator>& v) {
+			for (auto& x : v) x = square_root(x);
+			return v;
+		}
+		template<typename Ty, class Allocator>
+		std::vector<Ty, Allocator>& divide(std::vector<Ty, Allocator>& v, std::size_t count) {
+			for (auto& x : v) x /= static_cast<Ty>(count);
+			return v;
+		}
+		template<typename Ty, class Allocator>
+		Ty max_element(const std::vector<Ty, Allocator>& v) {
+			return v.empty() ? Ty() : *std::max_element(v.begin(), v.end());
+		}
+		// position (i,j) of the element at storage offset k
+		inline std::pair<std::size_t, std::size_t> position(std::size_t k, std::size_t, std::size_t n, row_major) {
+			return std::make_pair(k / n, k % n);
+		}
+		inline std::pair<std::size_t, std::size_t> position(std::size_t k, std::size_t m, std::size_t, column_major) {
+			return std::make_pair(k % m, k / m);
+		}
+		template<std::size_t TileSize>
+		std::pair<std::size_t, std::size_t> position(std::size_t k, std::size_t m, std::size_t n, tiled<TileSize>) {
+			const std::size_t ti = k / (TileSize*n)*TileSize;
+			const std::size_t height = std::min(TileSize, m - ti);
+			const std::size_t r = k - ti*n;
+			const std::size_t tj = r / (height*TileSize)*TileSize;
+			const std::size_t width = std::min(TileSize, n - tj);
+			const std::size_t q = r - tj*height;
+			return std::make_pair(ti + q / width, tj + q % width);
+		}
+		template<bool Max, typename Ty>
+		bool better(const Ty& x, const Ty& best) { return Max ? best < x : x < best; }
+		template<bool Max, typename Ty>
+		std::size_t arg(const Ty* a, std::size_t n) { return Max ? kernels::argmax(a, n) : kernels::argmin(a, n); }
+		// storage offset of the first extreme element of the n elements of a, in storage order
+		template<bool Max, typename Ty>
+		std::size_t parallel_arg(thread_pool& pool, const Ty* a, std::size_t n) {
+			const std::size_t chunk = dynamic_matrix_parallel_impl::chunk_size(n, pool.size() + 1U, 64U);
+			std::vector<std::size_t> partials((n + chunk - 1) / chunk, 0U);
+			pool.parallel_for(0U, n, chunk, [a, chunk, &partials](std::size_t first, std::size_t last) {
+				partials[first / chunk] = first + arg<Max>(a + first, last - first);
+			});
+			std::size_t k = partials.front();
+			for (std::size_t p = 1; p < partials.size(); ++p)
+				if (better<Max>(a[partials[p]], a[k])) k = partials[p];
+			return k;
+		}
+		// first extreme element of each of rows [first, last) of the m by n matrix, as values best and column indices idx
+		template<bool Max, typename Ty>
+		void arg_rows(std::size_t first, std::size_t last, std::size_t, std::size_t n, const Ty* a, Ty*, std::size_t* idx, row_major) {
+			for (std::size_t i = first; i < last; ++i) idx[i] = arg<Max>(a + i*n, n);
+		}
+		template<bool Max, typename Ty>
+		void arg_rows(std::size_t first, std::size_t last, std::size_t m, std::size_t n, const Ty* a, Ty* best, std::size_t* idx, column_major) {
+			for (std::size_t i = first; i < last; ++i) {
+				best[i] = a[i];
+				idx[i] = 0U;
+			}
+			for (std::size_t j = 1; j < n; ++j) {
+				const Ty* column = a + j*m;
+				for (std::size_t i = first; i < last; ++i) {
+					if (better<Max>(column[i], best[i])) {
+						best[i] = column[i];
+						idx[i] = j;
+					}
+				}
+			}
+		}
+		template<bool Max, typename Ty, std::size_t TileSize>
+		void arg_rows(std::size_t first, std::size_t last, std::size_t m, std::size_t n, const Ty* a, Ty* best, std::size_t* idx, tiled<TileSize>) {
+			for (std::size_t ti = first; ti < last; ti += TileSize) {
+				const std::size_t height = std::min(TileSize, m - ti);
+				for (std::size_t tj = 0; tj < n; tj += TileSize) {
+					const std::size_t width = std::min(TileSize, n - tj);
+					const Ty* tile = a + tiled<TileSize>::offset(ti, tj, m, n);
+					for (std::size_t q = 0; q < height; ++q) {
+						const std::size_t k = arg<Max>(tile + q*width, width);
+						if (!tj || better<Max>(tile[q*width + k], best[ti + q])) {
+							best[ti + q] = tile[q*width + k];
+							idx[ti + q] = tj + k;
+						}
+					}
+				}
+			}
+		}
+		template<bool Max, typename Ty>
+		void arg_columns(std::size_t first, std::size_t last, std::size_t m, std::size_t n, const Ty* a, Ty* best, std::size_t* idx, row_major) {
+			arg_rows<Max>(first, last, n, m, a, best, idx, column_major());
+		}
+		template<bool Max, typename Ty>
+		void arg_columns(std::size_t first, std::size_t last, std::size_t m, std::size_t n, const Ty* a, Ty* best, std::size_t* idx, column_major) {
+			arg_rows<Max>(first, last, n, m, a, best, idx, row_major());
+		}
+		template<bool Max, typename Ty, std::size_t TileSize>
+		void arg_columns(std::size_t first, std::size_t last, std::size_t m, std::size_t n, const Ty* a, Ty* best, std::size_t* idx, tiled<TileSize>) {
+			for (std::size_t ti = 0; ti < m; ti += TileSize) {
+				const std::size_t height = std::min(TileSize, m - ti);
+				for (std::size_t tj = first; tj < last; tj += TileSize) {
+					const std::size_t width = std::min(TileSize, n - tj);
+					const Ty* tile = a + tiled<TileSize>::offset(ti, tj, m, n);
+					for (std::size_t q = 0; q < height; ++q) {
+						for (std::size_t c = 0; c < width; ++c) {
+							if (!(ti + q) || better<Max>(tile[q*width + c], best[tj + c])) {
+								best[tj + c] = tile[q*width + c];
+								idx[tj + c] = ti + q;
+							}
+						}
+					}
+				}
+			}
+		}
+		template<bool Max, typename Ty, class Layout>
+		void arg_axis(reduction_axis axis, std::size_t first, std::size_t last, std::size_t m, std::size_t n, const Ty* a,
+			Ty* best, std::size_t* idx, Layout) {
+			if (axis == reduction_axis::per_row) arg_rows<Max>(first, last, m, n, a, best, idx, Layout());
+			else arg_columns<Max>(first, last, m, n, a, best, idx, Layout());
+		}
+		template<bool Max, typename Ty, class Allocator, class Layout>
+		std::pair<std::size_t, std::size_t> arg_whole(thread_pool* pool, const dynamic_matrix<Ty, Allocator, Layout>& dm, std::size_t cutoff) {
+			if (dm.empty()) throw std::invalid_argument("cannot compute argmin or argmax of empty dynamic_matrix.");
+			const std::size_t k = (pool && dm.size() >= cutoff && pool->size() >= 2U)
+				? parallel_arg<Max>(*pool, dm.data(), dm.size()) : arg<Max>(dm.data(), dm.size());
+			return position(k, dm.rows(), dm.columns(), Layout());
+		}
+		template<bool Max, typename Ty, class Allocator, class Layout>
+		std::vector<std::size_t> arg_result(thread_pool* pool, const dynamic_matrix<Ty, Allocator, Layout>& dm, reduction_axis axis, std::size_t cutoff) {
+			if (dm.empty()) throw std::invalid_argument("cannot compute argmin or argmax of empty dynamic_matrix.");
+			const std::size_t count = (axis == reduction_axis::per_row) ? dm.rows() : dm.columns();
+			const std::size_t m = dm.rows(), n = dm.columns();
+			const std::size_t align = axis_alignment<Ty>(Layout());
+			std::vector<Ty, Allocator> best(count, Ty());
+			std::vector<std::size_t> idx(count, 0U);
+			const Ty* a = dm.data();
+			Ty* pbest = best.data();
+			std::size_t* pidx = idx.data();
+			if (!pool || dm.size() < cutoff || pool->size() < 2U || count < 2U * align)
+				arg_axis<Max>(axis, 0U, count, m, n, a, pbest, pidx, Layout());
+			else {
+				pool->parallel_for(0U, count, dynamic_matrix_parallel_impl::chunk_size(count, pool->size() + 1U, align),
+					[=](std::size_t first, std::size_t last) {
+					arg_axis<Max>(axis, first, last, m, n, a, pbest, pidx, Layout());
+				});
+			}
+			return idx;
+		}
+	}
+	/**
+	 * \brief Computes the sum of the elements of `dm`.
+	 *
+	 * The elements are summed pairwise in storage order by `crsc::kernels::reduce`, vectorised for `float` and
+	 * `double`, such that the rounding error grows with the logarithm of `dm.size()`.
+	 *
+	 * \param dm Instance of `dynamic_matrix`.
+	 * \return Sum of the elements, `Ty()` if `dm` is empty.
+	 * \complexity Linear in `dm.size()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> Ty matrix_element_sum(const dynamic_matrix<Ty, Allocator, Layout>& dm) {
+		return kernels::reduce<kernels::reduction_op::sum>(dm.data(), dm.size());
+	}
+	/**
+	 * \brief Computes the sum of the elements of each row or each column of `dm`.
+	 *
+	 * Rows or columns which are contiguous in storage are summed pairwise, otherwise the contiguous runs of
+	 * storage crossing them are accumulated into the sums with Kahan compensation (see `crsc::kernels::accumulate`),
+	 * such that `dm` is always read in storage order.
+	 *
+	 * \param dm Instance of `dynamic_matrix`.
+	 * \param axis Whether to sum each row or each column.
+	 * \return Vector of `dm.rows()` sums for `reduction_axis::per_row`, or `dm.columns()` sums otherwise.
+	 * \complexity Linear in `dm.size()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<Ty, Allocator> matrix_element_sum(const dynamic_matrix<Ty, Allocator, Layout>& dm, reduction_axis axis) {
+		return matrix_reduction_impl::axis_result(dm, axis, matrix_reduction_impl::op_reducer<kernels::reduction_op::sum, Ty>{ dm.data() });
+	}
+	/**
+	 * \brief Computes the arithmetic mean of the elements of `dm`, as `matrix_element_sum(dm) / dm.size()`.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `dm` is empty.
+	 * \complexity Linear in `dm.size()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> Ty matrix_mean(const dynamic_matrix<Ty, Allocator, Layout>& dm) {
+		if (dm.empty()) throw std::invalid_argument("cannot compute mean of empty dynamic_matrix.");
+		return matrix_element_sum(dm) / static_cast<Ty>(dm.size());
+	}
+	/**
+	 * \brief Computes the arithmetic mean of the elements of each row or each column of `dm`.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `dm` is empty.
+	 * \complexity Linear in `dm.size()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<Ty, Allocator> matrix_mean(const dynamic_matrix<Ty, Allocator, Layout>& dm, reduction_axis axis) {
+		if (dm.empty()) throw std::invalid_argument("cannot compute mean of empty dynamic_matrix.");
+		std::vector<Ty, Allocator> sums = matrix_element_sum(dm, axis);
+		return matrix_reduction_impl::divide(sums, axis == reduction_axis::per_row ? dm.columns() : dm.rows());
+	}
+	/**
+	 * \brief Computes the Frobenius norm of `dm`, the square root of the sum of the squares of its elements.
+	 *
+	 * \remark The sum of squares is not rescaled, so overflows if elements exceed the square root of the largest
+	 *         finite value of `Ty`.
+	 * \complexity Linear in `dm.size()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> Ty frobenius_norm(const dynamic_matrix<Ty, Allocator, Layout>& dm) {
+		return matrix_reduction_impl::square_root(kernels::reduce<kernels::reduction_op::sum_squares>(dm.data(), dm.size()));
+	}
+	/**
+	 * \brief Computes the 1-norm of `dm`, the maximum over the columns of the sum of the absolute values of their elements.
+	 *
+	 * \complexity Linear in `dm.size()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> Ty matrix_norm_1(const dynamic_matrix<Ty, Allocator, Layout>& dm) {
+		return matrix_reduction_impl::max_element(matrix_reduction_impl::axis_result(dm, reduction_axis::per_column,
+			matrix_reduction_impl::op_reducer<kernels::reduction_op::sum_abs, Ty>{ dm.data() }));
+	}
+	/**
+	 * \brief Computes the infinity-norm of `dm`, the maximum over the rows of the sum of the absolute values of their elements.
+	 *
+	 * \complexity Linear in `dm.size()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> Ty matrix_norm_inf(const dynamic_matrix<Ty, Allocator, Layout>& dm) {
+		return matrix_reduction_impl::max_element(matrix_reduction_impl::axis_result(dm, reduction_axis::per_row,
+			matrix_reduction_impl::op_reducer<kernels::reduction_op::sum_abs, Ty>{ dm.data() }));
+	}
+	/**
+	 * \brief Computes the vector norm `norm` of each row or each column of `dm`.
+	 *
+	 * \param dm Instance of `dynamic_matrix`.
+	 * \param axis Whether to compute the norm of each row or of each column.
+	 * \param norm Vector norm to compute.
+	 * \return Vector of `dm.rows()` norms for `reduction_axis::per_row`, or `dm.columns()` norms otherwise.
+	 * \complexity Linear in `dm.size()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<Ty, Allocator> vector_norms(const dynamic_matrix<Ty, Allocator, Layout>& dm, reduction_axis axis, vector_norm norm) {
+		using namespace matrix_reduction_impl;
+		switch (norm) {
+		case vector_norm::l1: return axis_result(dm, axis, op_reducer<kernels::reduction_op::sum_abs, Ty>{ dm.data() });
+		case vector_norm::linf: return axis_result(dm, axis, op_reducer<kernels::reduction_op::max_abs, Ty>{ dm.data() });
+		default: {
+			std::vector<Ty, Allocator> sums = axis_result(dm, axis, op_reducer<kernels::reduction_op::sum_squares, Ty>{ dm.data() });
+			return square_roots(sums);
+		}
+		}
+	}
+	/**
+	 * \brief Finds the position `(row, column)` of a minimum element of `dm`, the first in storage order if there
+	 *        are several.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `dm` is empty.
+	 * \complexity Linear in `dm.size()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::pair<std::size_t, std::size_t> matrix_argmin(const dynamic_matrix<Ty, Allocator, Layout>& dm) {
+		return matrix_reduction_impl::arg_whole<false>(nullptr, dm, 0U);
+	}
+	/**
+	 * \brief Finds the position `(row, column)` of a maximum element of `dm`, the first in storage order if there
+	 *        are several.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `dm` is empty.
+	 * \complexity Linear in `dm.size()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::pair<std::size_t, std::size_t> matrix_argmax(const dynamic_matrix<Ty, Allocator, Layout>& dm) {
+		return matrix_reduction_impl::arg_whole<true>(nullptr, dm, 0U);
+	}
+	/**
+	 * \brief Finds the column index of the first minimum of each row, or the row index of the first minimum of each
+	 *        column, of `dm`.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `dm` is empty.
+	 * \complexity Linear in `dm.size()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<std::size_t> matrix_argmin(const dynamic_matrix<Ty, Allocator, Layout>& dm, reduction_axis axis) {
+		return matrix_reduction_impl::arg_result<false>(nullptr, dm, axis, 0U);
+	}
+	/**
+	 * \brief Finds the column index of the first maximum of each row, or the row index of the first maximum of each
+	 *        column, of `dm`.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `dm` is empty.
+	 * \complexity Linear in `dm.size()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<std::size_t> matrix_argmax(const dynamic_matrix<Ty, Allocator, Layout>& dm, reduction_axis axis) {
+		return matrix_reduction_impl::arg_result<true>(nullptr, dm, axis, 0U);
+	}
+	/**
+	 * \brief Computes the Frobenius inner product of `lhs` and `rhs`, the sum of the products of their corresponding
+	 *        elements, summed pairwise as for `matrix_element_sum`.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if the dimensions of `lhs` and `rhs` differ.
+	 * \complexity Linear in `lhs.size()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> Ty matrix_dot(const dynamic_matrix<Ty, Allocator, Layout>& lhs, const dynamic_matrix<Ty, Allocator, Layout>& rhs) {
+		if (lhs.rows() != rhs.rows() || lhs.columns() != rhs.columns())
+			throw std::invalid_argument("dynamic_matrix dimensions must agree for matrix_dot.");
+		return kernels::dot(lhs.data(), rhs.data(), lhs.size());
+	}
+	/**
+	 * \brief Computes the dot products of corresponding rows, or corresponding columns, of `lhs` and `rhs`.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if the dimensions of `lhs` and `rhs` differ.
+	 * \complexity Linear in `lhs.size()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<Ty, Allocator> matrix_dot(const dynamic_matrix<Ty, Allocator, Layout>& lhs, const dynamic_matrix<Ty, Allocator, Layout>& rhs,
+		reduction_axis axis) {
+		if (lhs.rows() != rhs.rows() || lhs.columns() != rhs.columns())
+			throw std::invalid_argument("dynamic_matrix dimensions must agree for matrix_dot.");
+		return matrix_reduction_impl::axis_result(lhs, axis, matrix_reduction_impl::dot_reducer<Ty>{ lhs.data(), rhs.data(), std::vector<Ty>() });
+	}
+	/**
+	 * \brief Computes the sum of the elements of `dm`, with contiguous chunks of the storage summed concurrently
+	 *        across the threads of `pool` when `dm.size()` is at least `cutoff`.
+	 *
+	 * \param pool Thread pool on which to execute.
+	 * \param dm Instance of `dynamic_matrix`.
+	 * \param cutoff Number of elements below which the serial `matrix_element_sum` is used.
+	 * \return Sum of the elements, `Ty()` if `dm` is empty.
+	 * \complexity Linear in `dm.size()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> Ty matrix_element_sum(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& dm, std::size_t cutoff = parallel_cutoffs::reduction) {
+		if (dm.size() < cutoff || pool.size() < 2U) return matrix_element_sum(dm);
+		return matrix_reduction_impl::parallel_reduce<kernels::reduction_op::sum>(pool, dm.data(), dm.size());
+	}
+	/**
+	 * \brief Computes the sum of the elements of each row or each column of `dm`, with contiguous blocks of the
+	 *        sums computed concurrently across the threads of `pool` when `dm.size()` is at least `cutoff`.
+	 *
+	 * \complexity Linear in `dm.size()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<Ty, Allocator> matrix_element_sum(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& dm, reduction_axis axis,
+		std::size_t cutoff = parallel_cutoffs::reduction) {
+		return matrix_reduction_impl::axis_result(pool, dm, axis, matrix_reduction_impl::op_reducer<kernels::reduction_op::sum, Ty>{ dm.data() }, cutoff);
+	}
+	/**
+	 * \brief Computes the arithmetic mean of the elements of `dm`, in parallel as for `matrix_element_sum`.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `dm` is empty.
+	 * \complexity Linear in `dm.size()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> Ty matrix_mean(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& dm, std::size_t cutoff = parallel_cutoffs::reduction) {
+		if (dm.empty()) throw std::invalid_argument("cannot compute mean of empty dynamic_matrix.");
+		return matrix_element_sum(pool, dm, cutoff) / static_cast<Ty>(dm.size());
+	}
+	/**
+	 * \brief Computes the arithmetic mean of the elements of each row or each column of `dm`, in parallel as for
+	 *        `matrix_element_sum`.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `dm` is empty.
+	 * \complexity Linear in `dm.size()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<Ty, Allocator> matrix_mean(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& dm, reduction_axis axis,
+		std::size_t cutoff = parallel_cutoffs::reduction) {
+		if (dm.empty()) throw std::invalid_argument("cannot compute mean of empty dynamic_matrix.");
+		std::vector<Ty, Allocator> sums = matrix_element_sum(pool, dm, axis, cutoff);
+		return matrix_reduction_impl::divide(sums, axis == reduction_axis::per_row ? dm.columns() : dm.rows());
+	}
+	/**
+	 * \brief Computes the Frobenius norm of `dm`, in parallel as for `matrix_element_sum`.
+	 *
+	 * \complexity Linear in `dm.size()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> Ty frobenius_norm(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& dm, std::size_t cutoff = parallel_cutoffs::reduction) {
+		if (dm.size() < cutoff || pool.size() < 2U) return frobenius_norm(dm);
+		return matrix_reduction_impl::square_root(
+			matrix_reduction_impl::parallel_reduce<kernels::reduction_op::sum_squares>(pool, dm.data(), dm.size()));
+	}
+	/**
+	 * \brief Computes the 1-norm of `dm`, with the column sums computed in parallel as for `matrix_element_sum`.
+	 *
+	 * \complexity Linear in `dm.size()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> Ty matrix_norm_1(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& dm, std::size_t cutoff = parallel_cutoffs::reduction) {
+		return matrix_reduction_impl::max_element(matrix_reduction_impl::axis_result(pool, dm, reduction_axis::per_column,
+			matrix_reduction_impl::op_reducer<kernels::reduction_op::sum_abs, Ty>{ dm.data() }, cutoff));
+	}
+	/**
+	 * \brief Computes the infinity-norm of `dm`, with the row sums computed in parallel as for `matrix_element_sum`.
+	 *
+	 * \complexity Linear in `dm.size()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> Ty matrix_norm_inf(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& dm, std::size_t cutoff = parallel_cutoffs::reduction) {
+		return matrix_reduction_impl::max_element(matrix_reduction_impl::axis_result(pool, dm, reduction_axis::per_row,
+			matrix_reduction_impl::op_reducer<kernels::reduction_op::sum_abs, Ty>{ dm.data() }, cutoff));
+	}
+	/**
+	 * \brief Computes the vector norm `norm` of each row or each column of `dm`, in parallel as for `matrix_element_sum`.
+	 *
+	 * \complexity Linear in `dm.size()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<Ty, Allocator> vector_norms(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& dm, reduction_axis axis,
+		vector_norm norm, std::size_t cutoff = parallel_cutoffs::reduction) {
+		using namespace matrix_reduction_impl;
+		switch (norm) {
+		case vector_norm::l1: return axis_result(pool, dm, axis, op_reducer<kernels::reduction_op::sum_abs, Ty>{ dm.data() }, cutoff);
+		case vector_norm::linf: return axis_result(pool, dm, axis, op_reducer<kernels::reduction_op::max_abs, Ty>{ dm.data() }, cutoff);
+		default: {
+			std::vector<Ty, Allocator> sums = axis_result(pool, dm, axis, op_reducer<kernels::reduction_op::sum_squares, Ty>{ dm.data() }, cutoff);
+			return square_roots(sums);
+		}
+		}
+	}
+	/**
+	 * \brief Finds the position of a minimum element of `dm` as for the serial `matrix_argmin`, with contiguous
+	 *        chunks of the storage searched concurrently across the threads of `pool`.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `dm` is empty.
+	 * \complexity Linear in `dm.size()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::pair<std::size_t, std::size_t> matrix_argmin(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& dm,
+		std::size_t cutoff = parallel_cutoffs::reduction) {
+		return matrix_reduction_impl::arg_whole<false>(&pool, dm, cutoff);
+	}
+	/**
+	 * \brief Finds the position of a maximum element of `dm` as for the serial `matrix_argmax`, with contiguous
+	 *        chunks of the storage searched concurrently across the threads of `pool`.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `dm` is empty.
+	 * \complexity Linear in `dm.size()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::pair<std::size_t, std::size_t> matrix_argmax(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& dm,
+		std::size_t cutoff = parallel_cutoffs::reduction) {
+		return matrix_reduction_impl::arg_whole<true>(&pool, dm, cutoff);
+	}
+	/**
+	 * \brief Finds the index of the first minimum of each row or each column of `dm`, with contiguous blocks of
+	 *        the results computed concurrently across the threads of `pool`.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `dm` is empty.
+	 * \complexity Linear in `dm.size()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<std::size_t> matrix_argmin(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& dm, reduction_axis axis,
+		std::size_t cutoff = parallel_cutoffs::reduction) {
+		return matrix_reduction_impl::arg_result<false>(&pool, dm, axis, cutoff);
+	}
+	/**
+	 * \brief Finds the index of the first maximum of each row or each column of `dm`, with contiguous blocks of
+	 *        the results computed concurrently across the threads of `pool`.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if `dm` is empty.
+	 * \complexity Linear in `dm.size()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<std::size_t> matrix_argmax(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& dm, reduction_axis axis,
+		std::size_t cutoff = parallel_cutoffs::reduction) {
+		return matrix_reduction_impl::arg_result<true>(&pool, dm, axis, cutoff);
+	}
+	/**
+	 * \brief Computes the Frobenius inner product of `lhs` and `rhs`, with contiguous chunks of the storage
+	 *        computed concurrently across the threads of `pool` when `lhs.size()` is at least `cutoff`.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if the dimensions of `lhs` and `rhs` differ.
+	 * \complexity Linear in `lhs.size()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> Ty matrix_dot(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& lhs, const dynamic_matrix<Ty, Allocator, Layout>& rhs,
+		std::size_t cutoff = parallel_cutoffs::reduction) {
+		if (lhs.rows() != rhs.rows() || lhs.columns() != rhs.columns())
+			throw std::invalid_argument("dynamic_matrix dimensions must agree for matrix_dot.");
+		if (lhs.size() < cutoff || pool.size() < 2U) return matrix_dot(lhs, rhs);
+		return matrix_reduction_impl::parallel_dot(pool, lhs.data(), rhs.data(), lhs.size());
+	}
+	/**
+	 * \brief Computes the dot products of corresponding rows, or corresponding columns, of `lhs` and `rhs`, with
+	 *        contiguous blocks of the results computed concurrently across the threads of `pool`.
+	 *
+	 * \throw Throws `std::invalid_argument` exception if the dimensions of `lhs` and `rhs` differ.
+	 * \complexity Linear in `lhs.size()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<Ty, Allocator> matrix_dot(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& lhs,
+		const dynamic_matrix<Ty, Allocator, Layout>& rhs, reduction_axis axis, std::size_t cutoff = parallel_cutoffs::reduction) {
+		if (lhs.rows() != rhs.rows() || lhs.columns() != rhs.columns())
+			throw std::invalid_argument("dynamic_matrix dimensions must agree for matrix_dot.");
+		return matrix_reduction_impl::axis_result(pool, lhs, axis,
+			matrix_reduction_impl::dot_reducer<Ty>{ lhs.data(), rhs.data(), std::vector<Ty>() }, cutoff);
+	}
+}
+
+#endif // !MATRIX_REDUCTION_H
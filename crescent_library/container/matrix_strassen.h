@@ -0,0 +1,312 @@
+#ifndef MATRIX_STRASSEN_H
+#define MATRIX_STRASSEN_H
+#include "dynamic_matrix.h"
+#include "matrix_kernels.h"
+#include "matrix_layout.h"
+#include "threading_utilities.h"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace crsc {
+	/**
+	 * \brief Detail namespace for implementation of the Strassen-Winograd matrix product.
+	 *
+	 * All operands are row-major blocks addressed by a pointer and a leading dimension (the distance between
+	 * consecutive rows); column-major matrices are handled as their row-major transposes.
+	 */
+	namespace strassen_impl {
+		// smallest dimension at or below which the classical kernel is used
+		constexpr std::size_t default_crossover = 512U;
+		// c = a + b, or c = a - b, on m by n blocks
+		template<kernels::elementwise_op Op, typename Ty>
+		void combine(std::size_t m, std::size_t n, const Ty* a, std::size_t lda, const Ty* b, std::size_t ldb, Ty* c, std::size_t ldc) {
+			for (std::size_t i = 0; i < m; ++i)
+				kernels::elementwise<Op>(a + i*lda, b + i*ldb, c + i*ldc, Ty(), n);
+		}
+		template<typename Ty>
+		void add(std::size_t m, std::size_t n, const Ty* a, std::size_t lda, const Ty* b, std::size_t ldb, Ty* c, std::size_t ldc) {
+			combine<kernels::elementwise_op::add>(m, n, a, lda, b, ldb, c, ldc);
+		}
+		template<typename Ty>
+		void subtract(std::size_t m, std::size_t n, const Ty* a, std::size_t lda, const Ty* b, std::size_t ldb, Ty* c, std::size_t ldc) {
+			combine<kernels::elementwise_op::subtract>(m, n, a, lda, b, ldb, c, ldc);
+		}
+		// c = a*b by the classical kernel, for a m by k and b k by n
+		template<typename Ty>
+		void classical(std::size_t m, std::size_t n, std::size_t k, const Ty* a, std::size_t lda,
+			const Ty* b, std::size_t ldb, Ty* c, std::size_t ldc) {
+			for (std::size_t i = 0; i < m; ++i) std::fill_n(c + i*ldc, n, Ty());
+			kernels::gemm(m, n, k, a, lda, 1, b, ldb, 1, c, ldc, 1);
+		}
+		inline bool recurse(std::size_t m, std::size_t n, std::size_t k, std::size_t crossover) noexcept {
+			return std::min(m, std::min(n, k)) > std::max<std::size_t>(crossover, 1U);
+		}
+		// elements of workspace used by multiply(m, n, k): two temporaries per level of recursion
+		inline std::size_t workspace(std::size_t m, std::size_t n, std::size_t k, std::size_t crossover) noexcept {
+			if (!recurse(m, n, k, crossover)) return 0U;
+			const std::size_t m2 = m / 2U, n2 = n / 2U, k2 = k / 2U;
+			return m2*std::max(k2, n2) + k2*n2 + workspace(m2, n2, k2, crossover);
+		}
+		// completes c = a*b for odd dimensions once the leading even-sized blocks have been multiplied, i.e.
+		// dynamic peeling of the last row, column and inner index
+		template<typename Ty>
+		void peel(std::size_t m, std::size_t n, std::size_t k, const Ty* a, std::size_t lda,
+			const Ty* b, std::size_t ldb, Ty* c, std::size_t ldc) {
+			const std::size_t me = m / 2U*2U, ne = n / 2U*2U, ke = k / 2U*2U;
+			if (k != ke) kernels::gemm(me, ne, 1U, a + ke, lda, 1, b + ke*ldb, ldb, 1, c, ldc, 1);
+			if (n != ne) classical(me, 1U, k, a, lda, b + ne, ldb, c + ne, ldc);
+			if (m != me) classical(1U, n, k, a + me*lda, lda, b, ldb, c + me*ldc, ldc);
+		}
+		/**
+		 * Computes c = a*b, for a m by k and b k by n, by the Winograd variant of Strassen's algorithm (7 products
+		 * and 15 additions of quarter blocks per level) in the schedule of Boyer, Dumas, Pernet and Zhou which
+		 * needs only two temporaries, x of m/2 by max(k/2, n/2) and y of k/2 by n/2, the four quadrants of c holding
+		 * the remaining intermediate results. ws must hold workspace(m, n, k, crossover) elements.
+		 */
+		template<typename Ty>
+		void multiply(std::size_t m, std::size_t n, std::size_t k, const Ty* a, std::size_t lda,
+			const Ty* b, std::size_t ldb, Ty* c, std::size_t ldc, Ty* ws, std::size_t crossover) {
+			if (!recurse(m, n, k, crossover)) {
+				classical(m, n, k, a, lda, b, ldb, c, ldc);
+				return;
+			}
+			const std::size_t m2 = m / 2U, n2 = n / 2U, k2 = k / 2U;
+			const Ty* a11 = a;
+			const Ty* a12 = a + k2;
+			const Ty* a21 = a + m2*lda;
+			const Ty* a22 = a21 + k2;
+			const Ty* b11 = b;
+			const Ty* b12 = b + n2;
+			const Ty* b21 = b + k2*ldb;
+			const Ty* b22 = b21 + n2;
+			Ty* c11 = c;
+			Ty* c12 = c + n2;
+			Ty* c21 = c + m2*ldc;
+			Ty* c22 = c21 + n2;
+			const std::size_t ldx = std::max(k2, n2), ldy = n2;
+			Ty* x = ws;
+			Ty* y = x + m2*ldx;
+			Ty* next = y + k2*ldy;
+			subtract(m2, k2, a11, lda, a21, lda, x, ldx);                       // s3 = a11 - a21
+			subtract(k2, n2, b22, ldb, b12, ldb, y, ldy);                       // t3 = b22 - b12
+			multiply(m2, n2, k2, x, ldx, y, ldy, c21, ldc, next, crossover);    // p7 = s3*t3
+			add(m2, k2, a21, lda, a22, lda, x, ldx);                            // s1 = a21 + a22
+			subtract(k2, n2, b12, ldb, b11, ldb, y, ldy);                       // t1 = b12 - b11
+			multiply(m2, n2, k2, x, ldx, y, ldy, c22, ldc, next, crossover);    // p5 = s1*t1
+			subtract(m2, k2, x, ldx, a11, lda, x, ldx);                         // s2 = s1 - a11
+			subtract(k2, n2, b22, ldb, y, ldy, y, ldy);                         // t2 = b22 - t1
+			multiply(m2, n2, k2, x, ldx, y, ldy, c12, ldc, next, crossover);    // p6 = s2*t2
+			subtract(m2, k2, a12, lda, x, ldx, x, ldx);                         // s4 = a12 - s2
+			multiply(m2, n2, k2, x, ldx, b22, ldb, c11, ldc, next, crossover);  // p3 = s4*b22
+			multiply(m2, n2, k2, a11, lda, b11, ldb, x, ldx, next, crossover);  // p1 = a11*b11
+			add(m2, n2, x, ldx, c12, ldc, c12, ldc);                            // u2 = p1 + p6
+			add(m2, n2, c12, ldc, c21, ldc, c21, ldc);                          // u3 = u2 + p7
+			add(m2, n2, c12, ldc, c22, ldc, c12, ldc);                          // u4 = u2 + p5
+			add(m2, n2, c21, ldc, c22, ldc, c22, ldc);                          // u7 = u3 + p5
+			add(m2, n2, c12, ldc, c11, ldc, c12, ldc);                          // u5 = u4 + p3
+			subtract(k2, n2, y, ldy, b21, ldb, y, ldy);                         // t4 = t2 - b21
+			multiply(m2, n2, k2, a22, lda, y, ldy, c11, ldc, next, crossover);  // p4 = a22*t4
+			subtract(m2, n2, c21, ldc, c11, ldc, c21, ldc);                     // u6 = u3 - p4
+			multiply(m2, n2, k2, a12, lda, b21, ldb, c11, ldc, next, crossover); // p2 = a12*b21
+			add(m2, n2, x, ldx, c11, ldc, c11, ldc);                            // u1 = p1 + p2
+			peel(m, n, k, a, lda, b, ldb, c, ldc);
+		}
+		// elements of workspace used by multiply_parallel(m, n, k): the eight sums of quarter blocks, three
+		// quarter products and the workspace of each of the seven concurrent products
+		inline std::size_t workspace_parallel(std::size_t m, std::size_t n, std::size_t k, std::size_t crossover) noexcept {
+			if (!recurse(m, n, k, crossover)) return 0U;
+			const std::size_t m2 = m / 2U, n2 = n / 2U, k2 = k / 2U;
+			return 4U*m2*k2 + 4U*k2*n2 + 3U*m2*n2 + 7U*workspace(m2, n2, k2, crossover);
+		}
+		/**
+		 * Computes c = a*b as multiply, with the seven products of the first level computed concurrently across
+		 * the threads of pool (each by the serial recursion) and the additions of the first level partitioned by
+		 * rows. Every product then needs its own operands and result, so the first level keeps all eight sums and
+		 * three of the products in ws, which must hold workspace_parallel(m, n, k, crossover) elements.
+		 */
+		template<typename Ty>
+		void multiply_parallel(thread_pool& pool, std::size_t m, std::size_t n, std::size_t k, const Ty* a, std::size_t lda,
+			const Ty* b, std::size_t ldb, Ty* c, std::size_t ldc, Ty* ws, std::size_t crossover) {
+			if (!recurse(m, n, k, crossover)) {
+				classical(m, n, k, a, lda, b, ldb, c, ldc);
+				return;
+			}
+			const std::size_t m2 = m / 2U, n2 = n / 2U, k2 = k / 2U;
+			const Ty* a11 = a;
+			const Ty* a12 = a + k2;
+			const Ty* a21 = a + m2*lda;
+			const Ty* a22 = a21 + k2;
+			const Ty* b11 = b;
+			const Ty* b12 = b + n2;
+			const Ty* b21 = b + k2*ldb;
+			const Ty* b22 = b21 + n2;
+			Ty* c11 = c;
+			Ty* c12 = c + n2;
+			Ty* c21 = c + m2*ldc;
+			Ty* c22 = c21 + n2;
+			Ty* s[4];
+			Ty* t[4];
+			Ty* p[3];
+			Ty* cursor = ws;
+			for (auto& si : s) { si = cursor; cursor += m2*k2; }
+			for (auto& ti : t) { ti = cursor; cursor += k2*n2; }
+			for (auto& pi : p) { pi = cursor; cursor += m2*n2; }
+			const std::size_t threads = pool.size() + 1U;
+			pool.parallel_for(0U, m2, dynamic_matrix_parallel_impl::chunk_size(m2, threads, 1U), [=](std::size_t first, std::size_t last) {
+				const std::size_t r = last - first;
+				add(r, k2, a21 + first*lda, lda, a22 + first*lda, lda, s[0] + first*k2, k2);           // s1 = a21 + a22
+				subtract(r, k2, s[0] + first*k2, k2, a11 + first*lda, lda, s[1] + first*k2, k2);       // s2 = s1 - a11
+				subtract(r, k2, a11 + first*lda, lda, a21 + first*lda, lda, s[2] + first*k2, k2);      // s3 = a11 - a21
+				subtract(r, k2, a12 + first*lda, lda, s[1] + first*k2, k2, s[3] + first*k2, k2);       // s4 = a12 - s2
+			});
+			pool.parallel_for(0U, k2, dynamic_matrix_parallel_impl::chunk_size(k2, threads, 1U), [=](std::size_t first, std::size_t last) {
+				const std::size_t r = last - first;
+				subtract(r, n2, b12 + first*ldb, ldb, b11 + first*ldb, ldb, t[0] + first*n2, n2);      // t1 = b12 - b11
+				subtract(r, n2, b22 + first*ldb, ldb, t[0] + first*n2, n2, t[1] + first*n2, n2);       // t2 = b22 - t1
+				subtract(r, n2, b22 + first*ldb, ldb, b12 + first*ldb, ldb, t[2] + first*n2, n2);      // t3 = b22 - b12
+				subtract(r, n2, t[1] + first*n2, n2, b21 + first*ldb, ldb, t[3] + first*n2, n2);       // t4 = t2 - b21
+			});
+			struct product {
+				const Ty* a;
+				std::size_t lda;
+				const Ty* b;
+				std::size_t ldb;
+				Ty* c;
+				std::size_t ldc;
+			};
+			const product products[7] = {
+				{ a11, lda, b11, ldb, p[0], n2 },   // p1
+				{ a12, lda, b21, ldb, c11, ldc },   // p2
+				{ s[3], k2, b22, ldb, c12, ldc },   // p3
+				{ a22, lda, t[3], n2, c21, ldc },   // p4
+				{ s[0], k2, t[0], n2, c22, ldc },   // p5
+				{ s[1], k2, t[1], n2, p[1], n2 },   // p6
+				{ s[2], k2, t[2], n2, p[2], n2 }    // p7
+			};
+			const std::size_t sub_workspace = workspace(m2, n2, k2, crossover);
+			pool.parallel_for(0U, 7U, 1U, [=, &products](std::size_t first, std::size_t last) {
+				for (std::size_t i = first; i < last; ++i) {
+					const product& q = products[i];
+					multiply(m2, n2, k2, q.a, q.lda, q.b, q.ldb, q.c, q.ldc, cursor + i*sub_workspace, crossover);
+				}
+			});
+			pool.parallel_for(0U, m2, dynamic_matrix_parallel_impl::chunk_size(m2, threads, 1U), [=](std::size_t first, std::size_t last) {
+				const std::size_t r = last - first;
+				Ty* p1 = p[0] + first*n2;
+				Ty* p6 = p[1] + first*n2;
+				Ty* p7 = p[2] + first*n2;
+				Ty* r11 = c11 + first*ldc;
+				Ty* r12 = c12 + first*ldc;
+				Ty* r21 = c21 + first*ldc;
+				Ty* r22 = c22 + first*ldc;
+				add(r, n2, r11, ldc, p1, n2, r11, ldc);   // u1 = p2 + p1
+				add(r, n2, p6, n2, p1, n2, p6, n2);       // u2 = p6 + p1
+				add(r, n2, p7, n2, p6, n2, p7, n2);       // u3 = p7 + u2
+				add(r, n2, p6, n2, r22, ldc, p6, n2);     // u4 = u2 + p5
+				add(r, n2, r12, ldc, p6, n2, r12, ldc);   // u5 = p3 + u4
+				subtract(r, n2, p7, n2, r21, ldc, r21, ldc); // u6 = u3 - p4
+				add(r, n2, r22, ldc, p7, n2, r22, ldc);   // u7 = p5 + u3
+			});
+			peel(m, n, k, a, lda, b, ldb, c, ldc);
+		}
+		// invokes f with the row-major operands of c = a*b for matrices stored in Layout
+		template<typename Ty, class Fn>
+		void dispatch(std::size_t m, std::size_t n, std::size_t k, const Ty* a, const Ty* b, Ty* c, row_major, Fn f) {
+			f(m, n, k, a, k, b, n, c, n);
+		}
+		// a column-major matrix is the row-major storage of its transpose, and c' = b'*a'
+		template<typename Ty, class Fn>
+		void dispatch(std::size_t m, std::size_t n, std::size_t k, const Ty* a, const Ty* b, Ty* c, column_major, Fn f) {
+			f(n, m, k, b, k, a, m, c, m);
+		}
+	}
+	/**
+	 * \brief Returns a `dynamic_matrix` which gives the matrix product of `lhs` with `rhs`, computed by the Winograd
+	 *        variant of Strassen's algorithm down to blocks whose smallest dimension is at most `crossover`, which
+	 *        are multiplied by the classical kernel of `matrix_product`.
+	 *
+	 * Each level of the recursion replaces the 8 products of quarter blocks of the classical algorithm by 7 and 15
+	 * additions, for a complexity of \[O(n^{2.81})\]. Odd dimensions are handled by peeling the last row, column or
+	 * inner index at each level, so the operands need not be square or of power-of-two size, although the
+	 * savings are greatest when all three dimensions halve evenly down to the crossover. All temporaries are
+	 * taken from a single workspace allocated once up front, of fewer than `(m*max(k, n) + k*n)/3` elements for
+	 * an `m` by `k` times `k` by `n` product.
+	 *
+	 * \warning This is opt-in: it is not numerically equivalent to `matrix_product`. The error of the result is
+	 *          bounded only norm-wise, by roughly `c*(n/crossover)^{log2(12)}*eps*|lhs|*|rhs|`, rather than
+	 *          element-wise, so elements of the product which are much smaller than the norms of the operands
+	 *          (e.g. for badly scaled or graded matrices) may lose most of their relative accuracy. Lower
+	 *          `crossover` values save more multiplications and lose more accuracy. Integer element types are
+	 *          exact up to overflow of the intermediate sums.
+	 * \param lhs First instance of `dynamic_matrix`.
+	 * \param rhs Second instance of `dynamic_matrix`.
+	 * \param crossover Smallest block dimension above which a level of Strassen-Winograd recursion is applied.
+	 * \return Container consisting of product of `lhs` and `rhs`.
+	 * \throw Throws `std::invalid_argument` exception if `lhs.columns() != rhs.rows()`.
+	 * \complexity \[O(n^{2.81})\] for `n` by `n` operands.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout> matrix_product_strassen(const dynamic_matrix<Ty, Allocator, Layout>& lhs, const dynamic_matrix<Ty, Allocator, Layout>& rhs,
+		std::size_t crossover = strassen_impl::default_crossover) {
+		static_assert(is_strided_layout<Layout>::value, "matrix_product_strassen requires a row_major or column_major layout.");
+		if (lhs.columns() != rhs.rows())
+			throw std::invalid_argument("dynamic_matrix dimensions must agree for matrix_product_strassen.");
+		const std::size_t m = lhs.rows(), n = rhs.columns(), k = lhs.columns();
+		dynamic_matrix<Ty, Allocator, Layout> product(m, n);
+		const Allocator alloc = lhs.get_allocator();
+		strassen_impl::dispatch(m, n, k, lhs.data(), rhs.data(), product.data(), Layout(),
+			[&alloc, crossover](std::size_t pm, std::size_t pn, std::size_t pk, const Ty* a, std::size_t lda, const Ty* b, std::size_t ldb, Ty* c, std::size_t ldc) {
+			std::vector<Ty, Allocator> workspace(strassen_impl::workspace(pm, pn, pk, crossover), Ty(), alloc);
+			strassen_impl::multiply(pm, pn, pk, a, lda, b, ldb, c, ldc, workspace.data(), crossover);
+		});
+		return product;
+	}
+	/**
+	 * \brief Returns a `dynamic_matrix` which gives the matrix product of `lhs` with `rhs` computed by the
+	 *        Strassen-Winograd algorithm as `matrix_product_strassen`, with the seven products of the first level
+	 *        of the recursion computed concurrently across the threads of `pool`.
+	 *
+	 * The additions of the first level are partitioned by rows across `pool`. Running the seven products
+	 * concurrently keeps all of the first-level temporaries alive at once, a workspace of about four times the
+	 * size of one operand, and at most seven threads take part in the products.
+	 *
+	 * \warning See `matrix_product_strassen` for the numerical caveats of this algorithm.
+	 * \param pool Thread pool on which to execute.
+	 * \param lhs First instance of `dynamic_matrix`.
+	 * \param rhs Second instance of `dynamic_matrix`.
+	 * \param crossover Smallest block dimension above which a level of Strassen-Winograd recursion is applied.
+	 * \param cutoff Number of multiply-adds (`lhs.rows()*rhs.columns()*lhs.columns()`) below which the serial
+	 *        `matrix_product_strassen` is used.
+	 * \return Container consisting of product of `lhs` and `rhs`.
+	 * \throw Throws `std::invalid_argument` exception if `lhs.columns() != rhs.rows()`.
+	 * \complexity \[O(n^{2.81})\] for `n` by `n` operands, the products divided across `min(7, pool.size() + 1)` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> dynamic_matrix<Ty, Allocator, Layout> matrix_product_strassen(thread_pool& pool, const dynamic_matrix<Ty, Allocator, Layout>& lhs,
+		const dynamic_matrix<Ty, Allocator, Layout>& rhs, std::size_t crossover = strassen_impl::default_crossover,
+		std::size_t cutoff = parallel_cutoffs::product) {
+		static_assert(is_strided_layout<Layout>::value, "matrix_product_strassen requires a row_major or column_major layout.");
+		if (lhs.columns() != rhs.rows())
+			throw std::invalid_argument("dynamic_matrix dimensions must agree for matrix_product_strassen.");
+		const std::size_t m = lhs.rows(), n = rhs.columns(), k = lhs.columns();
+		if (m*n*k < cutoff || pool.size() < 2U || !strassen_impl::recurse(m, n, k, crossover))
+			return matrix_product_strassen(lhs, rhs, crossover);
+		dynamic_matrix<Ty, Allocator, Layout> product(m, n);
+		const Allocator alloc = lhs.get_allocator();
+		strassen_impl::dispatch(m, n, k, lhs.data(), rhs.data(), product.data(), Layout(),
+			[&pool, &alloc, crossover](std::size_t pm, std::size_t pn, std::size_t pk, const Ty* a, std::size_t lda, const Ty* b, std::size_t ldb, Ty* c, std::size_t ldc) {
+			std::vector<Ty, Allocator> workspace(strassen_impl::workspace_parallel(pm, pn, pk, crossover), Ty(), alloc);
+			strassen_impl::multiply_parallel(pool, pm, pn, pk, a, lda, b, ldb, c, ldc, workspace.data(), crossover);
+		});
+		return product;
+	}
+}
+
+#endif // !MATRIX_STRASSEN_H
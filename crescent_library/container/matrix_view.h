@@ -0,0 +1,573 @@
+#ifndef MATRIX_VIEW_H
+#define MATRIX_VIEW_H
+#include "dynamic_matrix.h"
+#include "matrix_expression.h"
+#include "matrix_kernels.h"
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace crsc {
+	/**
+	 * \class strided_iterator
+	 *
+	 * \brief Random access iterator over elements separated by a constant stride in memory, as used by
+	 *        `crsc::matrix_vector_view` to traverse a row or column of a matrix in-place.
+	 *
+	 * \tparam Ty Type of the elements, `const`-qualified for a constant iterator.
+	 */
+	template<typename Ty>
+	class strided_iterator {
+	public:
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef std::remove_cv_t<Ty> value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef Ty* pointer;
+		typedef Ty& reference;
+		strided_iterator() noexcept : ptr(nullptr), stride(1) {}
+		strided_iterator(pointer _ptr, difference_type _stride) noexcept : ptr(_ptr), stride(_stride) {}
+		template<typename Uty,
+			class = std::enable_if_t<std::is_same<const Uty, Ty>::value>
+		> strided_iterator(const strided_iterator<Uty>& _other) noexcept : ptr(_other.base()), stride(_other.step()) {}
+		pointer base() const noexcept { return ptr; }
+		difference_type step() const noexcept { return stride; }
+		reference operator*() const noexcept { return *ptr; }
+		pointer operator->() const noexcept { return ptr; }
+		reference operator[](difference_type n) const noexcept { return ptr[n*stride]; }
+		strided_iterator& operator++() noexcept { ptr += stride; return *this; }
+		strided_iterator operator++(int) noexcept { strided_iterator tmp(*this); ptr += stride; return tmp; }
+		strided_iterator& operator--() noexcept { ptr -= stride; return *this; }
+		strided_iterator operator--(int) noexcept { strided_iterator tmp(*this); ptr -= stride; return tmp; }
+		strided_iterator& operator+=(difference_type n) noexcept { ptr += n*stride; return *this; }
+		strided_iterator& operator-=(difference_type n) noexcept { ptr -= n*stride; return *this; }
+		strided_iterator operator+(difference_type n) const noexcept { return strided_iterator(ptr + n*stride, stride); }
+		strided_iterator operator-(difference_type n) const noexcept { return strided_iterator(ptr - n*stride, stride); }
+		friend strided_iterator operator+(difference_type n, const strided_iterator& it) noexcept { return it + n; }
+		difference_type operator-(const strided_iterator& _other) const noexcept { return (ptr - _other.ptr) / stride; }
+		bool operator==(const strided_iterator& _other) const noexcept { return ptr == _other.ptr; }
+		bool operator!=(const strided_iterator& _other) const noexcept { return ptr != _other.ptr; }
+		bool operator<(const strided_iterator& _other) const noexcept { return (_other.ptr - ptr)*stride > 0; }
+		bool operator>(const strided_iterator& _other) const noexcept { return _other < *this; }
+		bool operator<=(const strided_iterator& _other) const noexcept { return !(_other < *this); }
+		bool operator>=(const strided_iterator& _other) const noexcept { return !(*this < _other); }
+	private:
+		pointer ptr;
+		difference_type stride;
+	};
+	/**
+	 * \class matrix_vector_view
+	 *
+	 * \brief Non-owning view of a row or column of a matrix, referring to `size()` elements of the viewed
+	 *        storage separated by `stride()` elements.
+	 *
+	 * A view never allocates and never copies the elements it refers to, modifying an element through a
+	 * view modifies the viewed matrix. Views are obtained via `crsc::row_view` and `crsc::column_view`.
+	 *
+	 * \warning A view does not extend the lifetime of the viewed matrix and is invalidated by any operation
+	 *          which invalidates iterators of the viewed matrix (e.g. insertion or removal of rows/columns).
+	 * \tparam Ty Type of the elements, `const`-qualified for a read-only view.
+	 */
+	template<typename Ty>
+	class matrix_vector_view {
+	public:
+		// PUBLIC API TYPE DEFINITIONS
+		typedef std::remove_cv_t<Ty> value_type;
+		typedef Ty& reference;
+		typedef const Ty& const_reference;
+		typedef Ty* pointer;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef strided_iterator<Ty> iterator;
+		typedef strided_iterator<const Ty> const_iterator;
+		typedef std::reverse_iterator<iterator> reverse_iterator;
+		// CONSTRUCTION
+		/**
+		 * \brief Constructs a view of the `_size` elements `_data[0], _data[_stride], ...`.
+		 */
+		matrix_vector_view(pointer _data, size_type _size, difference_type _stride) noexcept
+			: ptr(_data), n(_size), stride_(_stride) {}
+		/**
+		 * \brief Converts a mutable view into a read-only view of the same elements.
+		 */
+		template<typename Uty,
+			class = std::enable_if_t<std::is_same<const Uty, Ty>::value>
+		> matrix_vector_view(const matrix_vector_view<Uty>& _other) noexcept
+			: ptr(_other.data()), n(_other.size()), stride_(_other.stride()) {}
+		// CAPACITY
+		size_type size() const noexcept { return n; }
+		bool empty() const noexcept { return !n; }
+		difference_type stride() const noexcept { return stride_; }
+		// ELEMENT ACCESS
+		pointer data() const noexcept { return ptr; }
+		/**
+		 * \brief Gets reference to the element at index `_idx` of the view.
+		 *
+		 * \throw Throws `std::out_of_range` exception if `_idx >= size()`.
+		 * \complexity Constant.
+		 */
+		reference at(size_type _idx) const {
+			if (_idx >= n) throw std::out_of_range("matrix_vector_view index out of bounds.");
+			return ptr[static_cast<difference_type>(_idx)*stride_];
+		}
+		reference operator[](size_type _idx) const noexcept { return ptr[static_cast<difference_type>(_idx)*stride_]; }
+		reference front() const noexcept { return *ptr; }
+		reference back() const noexcept { return ptr[static_cast<difference_type>(n - 1)*stride_]; }
+		// ITERATORS
+		iterator begin() const noexcept { return iterator(ptr, stride_); }
+		iterator end() const noexcept { return iterator(ptr + static_cast<difference_type>(n)*stride_, stride_); }
+		const_iterator cbegin() const noexcept { return begin(); }
+		const_iterator cend() const noexcept { return end(); }
+		reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+		reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+		// OPERATIONS
+		/**
+		 * \brief Assigns `_val` to every element of the view.
+		 *
+		 * \complexity Linear in `size()`.
+		 */
+		void fill(const value_type& _val) const {
+			for (size_type k = 0; k < n; ++k) (*this)[k] = _val;
+		}
+	private:
+		pointer ptr;
+		size_type n;
+		difference_type stride_;
+	};
+	/**
+	 * \class matrix_block_view
+	 *
+	 * \brief Non-owning view of a rectangular block of a matrix, referring to the element `(i,j)` of the block
+	 *        at `data()[i*row_stride() + j*column_stride()]`.
+	 *
+	 * For a block of a row-major matrix `row_stride()` is the leading dimension of the viewed matrix (its number
+	 * of columns) and `column_stride() == 1`. A view never allocates and never copies the elements it refers to.
+	 * Block views are leaves of matrix expressions, such that a view can be used wherever a matrix expression is
+	 * accepted (e.g. `crsc::mathematical_dynamic_matrix<double> c = block_view(a, 0, 0, 2, 2) + 2.0*b;`) and a
+	 * view can itself be assigned the result of an expression via `assign`.
+	 *
+	 * \warning A view does not extend the lifetime of the viewed matrix and is invalidated by any operation
+	 *          which invalidates iterators of the viewed matrix (e.g. insertion or removal of rows/columns).
+	 * \tparam Ty Type of the elements, `const`-qualified for a read-only view.
+	 */
+	template<typename Ty>
+	class matrix_block_view : public matrix_expression<matrix_block_view<Ty>> {
+	public:
+		// PUBLIC API TYPE DEFINITIONS
+		typedef std::remove_cv_t<Ty> value_type;
+		typedef Ty& reference;
+		typedef const Ty& const_reference;
+		typedef Ty* pointer;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		// CONSTRUCTION
+		/**
+		 * \brief Constructs a view of the `_rows` by `_cols` block whose element `(i,j)` is at
+		 *        `_data[i*_row_stride + j*_col_stride]`.
+		 */
+		matrix_block_view(pointer _data, size_type _rows, size_type _cols, size_type _row_stride, size_type _col_stride = 1U) noexcept
+			: ptr(_data), rows_(_rows), cols_(_cols), rs(_row_stride), cs(_col_stride) {}
+		/**
+		 * \brief Converts a mutable view into a read-only view of the same elements.
+		 */
+		template<typename Uty,
+			class = std::enable_if_t<std::is_same<const Uty, Ty>::value>
+		> matrix_block_view(const matrix_block_view<Uty>& _other) noexcept
+			: ptr(_other.data()), rows_(_other.rows()), cols_(_other.columns()), rs(_other.row_stride()), cs(_other.column_stride()) {}
+		// CAPACITY
+		size_type rows() const noexcept { return rows_; }
+		size_type columns() const noexcept { return cols_; }
+		size_type size() const noexcept { return rows_*cols_; }
+		bool empty() const noexcept { return !rows_ || !cols_; }
+		size_type row_stride() const noexcept { return rs; }
+		size_type column_stride() const noexcept { return cs; }
+		// ELEMENT ACCESS
+		pointer data() const noexcept { return ptr; }
+		/**
+		 * \brief Gets reference to the element at the specified row-column indices of the block.
+		 *
+		 * \throw Throws `std::out_of_range` exception if `_row_index >= rows() || _col_index >= columns()`.
+		 * \complexity Constant.
+		 */
+		reference at(size_type _row_index, size_type _col_index) const {
+			if (_row_index >= rows_ || _col_index >= cols_)
+				throw std::out_of_range("matrix_block_view indices out of bounds.");
+			return ptr[_row_index*rs + _col_index*cs];
+		}
+		reference operator()(size_type _row_index, size_type _col_index) const noexcept {
+			return ptr[_row_index*rs + _col_index*cs];
+		}
+		// element k of the block in row-major order, for the matrix_expression interface
+		value_type linear_element(size_type _k) const { return (*this)(_k / cols_, _k % cols_); }
+		/**
+		 * \brief Gets a view of row `_row_index` of the block.
+		 *
+		 * \throw Throws `std::out_of_range` exception if `_row_index >= rows()`.
+		 */
+		matrix_vector_view<Ty> row(size_type _row_index) const {
+			if (_row_index >= rows_) throw std::out_of_range("_row_index must be < current value of rows().");
+			return matrix_vector_view<Ty>(ptr + _row_index*rs, cols_, static_cast<difference_type>(cs));
+		}
+		/**
+		 * \brief Gets a view of column `_col_index` of the block.
+		 *
+		 * \throw Throws `std::out_of_range` exception if `_col_index >= columns()`.
+		 */
+		matrix_vector_view<Ty> column(size_type _col_index) const {
+			if (_col_index >= cols_) throw std::out_of_range("_col_index must be < current value of columns().");
+			return matrix_vector_view<Ty>(ptr + _col_index*cs, rows_, static_cast<difference_type>(rs));
+		}
+		/**
+		 * \brief Gets a view of the `_rows` by `_cols` sub-block starting at `(_row_index, _col_index)` of this block.
+		 *
+		 * \throw Throws `std::out_of_range` exception if the sub-block does not lie within this block.
+		 */
+		matrix_block_view block(size_type _row_index, size_type _col_index, size_type _rows, size_type _cols) const {
+			if (_row_index > rows_ || _rows > rows_ - _row_index || _col_index > cols_ || _cols > cols_ - _col_index)
+				throw std::out_of_range("matrix_block_view sub-block out of bounds.");
+			return matrix_block_view(ptr + _row_index*rs + _col_index*cs, _rows, _cols, rs, cs);
+		}
+		// OPERATIONS
+		/**
+		 * \brief Assigns `_val` to every element of the block.
+		 *
+		 * \complexity Linear in `rows()*columns()`.
+		 */
+		void fill(const value_type& _val) const {
+			for (size_type i = 0; i < rows_; ++i) {
+				for (size_type j = 0; j < cols_; ++j) (*this)(i, j) = _val;
+			}
+		}
+		/**
+		 * \brief Assigns the result of evaluating the matrix expression `_expr` to the elements of the block.
+		 *
+		 * \warning `_expr` is evaluated directly into the viewed storage, so it must not refer to elements of
+		 *          the viewed matrix other than those at the same position of this block (e.g. an overlapping
+		 *          but offset view of the same matrix).
+		 * \param _expr Expression to evaluate, with dimensions equal to those of the block.
+		 * \return `*this`.
+		 * \throw Throws `std::invalid_argument` exception if the dimensions of `_expr` and the block differ.
+		 * \complexity Linear in `rows()*columns()`.
+		 */
+		template<class Expr>
+		const matrix_block_view& assign(const matrix_expression<Expr>& _expr) const {
+			const Expr& e = _expr.self();
+			if (e.rows() != rows_ || e.columns() != cols_)
+				throw std::invalid_argument("matrix_expression dimensions must agree with matrix_block_view dimensions.");
+			for (size_type i = 0; i < rows_; ++i) {
+				for (size_type j = 0; j < cols_; ++j) (*this)(i, j) = e(i, j);
+			}
+			return *this;
+		}
+	private:
+		pointer ptr;
+		size_type rows_;
+		size_type cols_;
+		size_type rs;
+		size_type cs;
+	};
+	// views are cheap to copy, so expression nodes hold them by value allowing views created inline
+	// (e.g. block_view(a, 0, 0, 2, 2) + b) to be stored in the expression safely
+	namespace matrix_expression_impl {
+		template<typename Ty>
+		struct operand<matrix_block_view<Ty>> {
+			typedef matrix_block_view<Ty> type;
+		};
+	}
+	template<typename Ty>
+	struct is_contiguous_expression<matrix_block_view<Ty>> : std::false_type {};
+	/**
+	 * \brief Gets a view of row `row` of `dm` which refers to the elements in-place.
+	 *
+	 * \param dm Instance of `dynamic_matrix` with a strided layout (`row_major` or `column_major`).
+	 * \param row Row index.
+	 * \return Mutable view of the row.
+	 * \throw Throws `std::out_of_range` exception if `row >= dm.rows()`.
+	 * \complexity Constant.
+	 */
+	template<typename Ty,
+		class Allocator,
+		class Layout
+	> matrix_vector_view<Ty> row_view(dynamic_matrix<Ty, Allocator, Layout>& dm, std::size_t row) {
+		static_assert(is_strided_layout<Layout>::value, "views require a strided dynamic_matrix layout.");
+		if (row >= dm.rows()) throw std::out_of_range("row must be < dm.rows().");
+		return matrix_vector_view<Ty>(dm.data() + Layout::offset(row, 0U, dm.rows(), dm.columns()), dm.columns(),
+			static_cast<std::ptrdiff_t>(Layout::column_stride(dm.rows(), dm.columns())));
+	}
+	/**
+	 * \brief Gets a read-only view of row `row` of `dm` which refers to the elements in-place.
+	 *
+	 * \param dm Instance of `dynamic_matrix` with a strided layout (`row_major` or `column_major`).
+	 * \param row Row index.
+	 * \return Read-only view of the row.
+	 * \throw Throws `std::out_of_range` exception if `row >= dm.rows()`.
+	 * \complexity Constant.
+	 */
+	template<typename Ty,
+		class Allocator,
+		class Layout
+	> matrix_vector_view<const Ty> row_view(const dynamic_matrix<Ty, Allocator, Layout>& dm, std::size_t row) {
+		static_assert(is_strided_layout<Layout>::value, "views require a strided dynamic_matrix layout.");
+		if (row >= dm.rows()) throw std::out_of_range("row must be < dm.rows().");
+		return matrix_vector_view<const Ty>(dm.data() + Layout::offset(row, 0U, dm.rows(), dm.columns()), dm.columns(),
+			static_cast<std::ptrdiff_t>(Layout::column_stride(dm.rows(), dm.columns())));
+	}
+	/**
+	 * \brief Gets a view of column `col` of `dm` which refers to the elements in-place.
+	 *
+	 * \param dm Instance of `dynamic_matrix` with a strided layout (`row_major` or `column_major`).
+	 * \param col Column index.
+	 * \return Mutable view of the column.
+	 * \throw Throws `std::out_of_range` exception if `col >= dm.columns()`.
+	 * \complexity Constant.
+	 */
+	template<typename Ty,
+		class Allocator,
+		class Layout
+	> matrix_vector_view<Ty> column_view(dynamic_matrix<Ty, Allocator, Layout>& dm, std::size_t col) {
+		static_assert(is_strided_layout<Layout>::value, "views require a strided dynamic_matrix layout.");
+		if (col >= dm.columns()) throw std::out_of_range("col must be < dm.columns().");
+		return matrix_vector_view<Ty>(dm.data() + Layout::offset(0U, col, dm.rows(), dm.columns()), dm.rows(),
+			static_cast<std::ptrdiff_t>(Layout::row_stride(dm.rows(), dm.columns())));
+	}
+	/**
+	 * \brief Gets a read-only view of column `col` of `dm` which refers to the elements in-place.
+	 *
+	 * \param dm Instance of `dynamic_matrix` with a strided layout (`row_major` or `column_major`).
+	 * \param col Column index.
+	 * \return Read-only view of the column.
+	 * \throw Throws `std::out_of_range` exception if `col >= dm.columns()`.
+	 * \complexity Constant.
+	 */
+	template<typename Ty,
+		class Allocator,
+		class Layout
+	> matrix_vector_view<const Ty> column_view(const dynamic_matrix<Ty, Allocator, Layout>& dm, std::size_t col) {
+		static_assert(is_strided_layout<Layout>::value, "views require a strided dynamic_matrix layout.");
+		if (col >= dm.columns()) throw std::out_of_range("col must be < dm.columns().");
+		return matrix_vector_view<const Ty>(dm.data() + Layout::offset(0U, col, dm.rows(), dm.columns()), dm.rows(),
+			static_cast<std::ptrdiff_t>(Layout::row_stride(dm.rows(), dm.columns())));
+	}
+	/**
+	 * \brief Gets a view of the `rows` by `cols` block of `dm` whose top-left element is `(row, col)`, the
+	 *        zero-copy counterpart of extracting a submatrix.
+	 *
+	 * \param dm Instance of `dynamic_matrix` with a strided layout (`row_major` or `column_major`).
+	 * \param row Row index of the top-left element of the block.
+	 * \param col Column index of the top-left element of the block.
+	 * \param rows Number of rows in the block.
+	 * \param cols Number of columns in the block.
+	 * \return Mutable view of the block.
+	 * \throw Throws `std::out_of_range` exception if the block does not lie within `dm`.
+	 * \complexity Constant.
+	 */
+	template<typename Ty,
+		class Allocator,
+		class Layout
+	> matrix_block_view<Ty> block_view(dynamic_matrix<Ty, Allocator, Layout>& dm, std::size_t row, std::size_t col,
+		std::size_t rows, std::size_t cols) {
+		static_assert(is_strided_layout<Layout>::value, "views require a strided dynamic_matrix layout.");
+		if (row > dm.rows() || rows > dm.rows() - row || col > dm.columns() || cols > dm.columns() - col)
+			throw std::out_of_range("block must lie within dm.");
+		return matrix_block_view<Ty>(dm.data() + Layout::offset(row, col, dm.rows(), dm.columns()), rows, cols,
+			Layout::row_stride(dm.rows(), dm.columns()), Layout::column_stride(dm.rows(), dm.columns()));
+	}
+	/**
+	 * \brief Gets a read-only view of the `rows` by `cols` block of `dm` whose top-left element is `(row, col)`,
+	 *        the zero-copy counterpart of extracting a submatrix.
+	 *
+	 * \param dm Instance of `dynamic_matrix` with a strided layout (`row_major` or `column_major`).
+	 * \param row Row index of the top-left element of the block.
+	 * \param col Column index of the top-left element of the block.
+	 * \param rows Number of rows in the block.
+	 * \param cols Number of columns in the block.
+	 * \return Read-only view of the block.
+	 * \throw Throws `std::out_of_range` exception if the block does not lie within `dm`.
+	 * \complexity Constant.
+	 */
+	template<typename Ty,
+		class Allocator,
+		class Layout
+	> matrix_block_view<const Ty> block_view(const dynamic_matrix<Ty, Allocator, Layout>& dm, std::size_t row, std::size_t col,
+		std::size_t rows, std::size_t cols) {
+		static_assert(is_strided_layout<Layout>::value, "views require a strided dynamic_matrix layout.");
+		if (row > dm.rows() || rows > dm.rows() - row || col > dm.columns() || cols > dm.columns() - col)
+			throw std::out_of_range("block must lie within dm.");
+		return matrix_block_view<const Ty>(dm.data() + Layout::offset(row, col, dm.rows(), dm.columns()), rows, cols,
+			Layout::row_stride(dm.rows(), dm.columns()), Layout::column_stride(dm.rows(), dm.columns()));
+	}
+	/**
+	 * \brief Gets a view of the whole of `dm`, such that `dm` can take part in matrix expressions.
+	 *
+	 * \param dm Instance of `dynamic_matrix` with a strided layout (`row_major` or `column_major`).
+	 * \return Mutable view of `dm`.
+	 * \complexity Constant.
+	 */
+	template<typename Ty,
+		class Allocator,
+		class Layout
+	> matrix_block_view<Ty> block_view(dynamic_matrix<Ty, Allocator, Layout>& dm) {
+		return block_view(dm, 0U, 0U, dm.rows(), dm.columns());
+	}
+	/**
+	 * \brief Gets a read-only view of the whole of `dm`, such that `dm` can take part in matrix expressions.
+	 *
+	 * \param dm Instance of `dynamic_matrix` with a strided layout (`row_major` or `column_major`).
+	 * \return Read-only view of `dm`.
+	 * \complexity Constant.
+	 */
+	template<typename Ty,
+		class Allocator,
+		class Layout
+	> matrix_block_view<const Ty> block_view(const dynamic_matrix<Ty, Allocator, Layout>& dm) {
+		return block_view(dm, 0U, 0U, dm.rows(), dm.columns());
+	}
+	/**
+	 * \brief Detail namespace for implementation of the free algorithms on views.
+	 */
+	namespace matrix_view_impl {
+		// evaluates the elementwise operation Op of lhs and rhs (or lhs and the scalar s) into the row-major
+		// storage out, a row at a time through the vectorized kernels when the rows of both operands are
+		// contiguous, otherwise element by element through fn
+		template<kernels::elementwise_op Op, typename Lty, typename Rty, typename Ty, class Fn>
+		void elementwise(const matrix_block_view<Lty>& lhs, const matrix_block_view<Rty>& rhs, Ty* out, const Ty& s, Fn fn) {
+			const std::size_t rows = lhs.rows(), cols = lhs.columns();
+			if (lhs.column_stride() == 1U && rhs.column_stride() == 1U) {
+				for (std::size_t i = 0; i < rows; ++i)
+					kernels::elementwise<Op>(lhs.data() + i*lhs.row_stride(), rhs.data() + i*rhs.row_stride(), out + i*cols, s, cols);
+				return;
+			}
+			for (std::size_t i = 0; i < rows; ++i) {
+				for (std::size_t j = 0; j < cols; ++j)
+					out[i*cols + j] = fn(lhs(i, j), rhs(i, j));
+			}
+		}
+		template<typename Lty, typename Rty>
+		void check_dimensions(const matrix_block_view<Lty>& lhs, const matrix_block_view<Rty>& rhs, const char* what) {
+			static_assert(std::is_same<std::remove_cv_t<Lty>, std::remove_cv_t<Rty>>::value, "matrix_block_view element types must agree.");
+			if (lhs.rows() != rhs.rows() || lhs.columns() != rhs.columns())
+				throw std::invalid_argument(what);
+		}
+	}
+	/**
+	 * \brief Returns a `dynamic_matrix` whose elements equal the component-wise addition of the blocks viewed by
+	 *        `lhs` and `rhs`.
+	 *
+	 * \param lhs First block view.
+	 * \param rhs Second block view.
+	 * \return Container consisting of sum of `lhs` and `rhs`.
+	 * \throw Throws `std::invalid_argument` exception if `lhs.rows() != rhs.rows() ||
+	 *        lhs.columns() != rhs.columns()`.
+	 * \complexity Linear in `rows()*columns()`, vectorized via `crsc::kernels::add` when the rows of both
+	 *             blocks are contiguous.
+	 */
+	template<typename Lty,
+		typename Rty
+	> dynamic_matrix<std::remove_cv_t<Lty>> matrix_sum(const matrix_block_view<Lty>& lhs, const matrix_block_view<Rty>& rhs) {
+		matrix_view_impl::check_dimensions(lhs, rhs, "matrix_block_view dimensions must agree for component-wise addition.");
+		dynamic_matrix<std::remove_cv_t<Lty>> sum(lhs.rows(), lhs.columns());
+		matrix_view_impl::elementwise<kernels::elementwise_op::add>(lhs, rhs, sum.data(), std::remove_cv_t<Lty>(),
+			[](const std::remove_cv_t<Lty>& l, const std::remove_cv_t<Lty>& r) { return l + r; });
+		return sum;
+	}
+	/**
+	 * \brief Returns a `dynamic_matrix` whose elements equal the component-wise subtraction of the block viewed
+	 *        by `rhs` from that viewed by `lhs`.
+	 *
+	 * \param lhs First block view.
+	 * \param rhs Second block view.
+	 * \return Container consisting of difference of `lhs` and `rhs`.
+	 * \throw Throws `std::invalid_argument` exception if `lhs.rows() != rhs.rows() ||
+	 *        lhs.columns() != rhs.columns()`.
+	 * \complexity Linear in `rows()*columns()`, vectorized via `crsc::kernels::subtract` when the rows of both
+	 *             blocks are contiguous.
+	 */
+	template<typename Lty,
+		typename Rty
+	> dynamic_matrix<std::remove_cv_t<Lty>> matrix_difference(const matrix_block_view<Lty>& lhs, const matrix_block_view<Rty>& rhs) {
+		matrix_view_impl::check_dimensions(lhs, rhs, "matrix_block_view dimensions must agree for component-wise subtraction.");
+		dynamic_matrix<std::remove_cv_t<Lty>> difference(lhs.rows(), lhs.columns());
+		matrix_view_impl::elementwise<kernels::elementwise_op::subtract>(lhs, rhs, difference.data(), std::remove_cv_t<Lty>(),
+			[](const std::remove_cv_t<Lty>& l, const std::remove_cv_t<Lty>& r) { return l - r; });
+		return difference;
+	}
+	/**
+	 * \brief Returns a `dynamic_matrix` whose elements equal the component-wise (Hadamard) product of the blocks
+	 *        viewed by `lhs` and `rhs`.
+	 *
+	 * \param lhs First block view.
+	 * \param rhs Second block view.
+	 * \return Container consisting of Hadamard product of `lhs` and `rhs`.
+	 * \throw Throws `std::invalid_argument` exception if `lhs.rows() != rhs.rows() ||
+	 *        lhs.columns() != rhs.columns()`.
+	 * \complexity Linear in `rows()*columns()`, vectorized via `crsc::kernels::hadamard` when the rows of both
+	 *             blocks are contiguous.
+	 */
+	template<typename Lty,
+		typename Rty
+	> dynamic_matrix<std::remove_cv_t<Lty>> matrix_hadamard_product(const matrix_block_view<Lty>& lhs, const matrix_block_view<Rty>& rhs) {
+		matrix_view_impl::check_dimensions(lhs, rhs, "matrix_block_view dimensions must agree for component-wise multiplication.");
+		dynamic_matrix<std::remove_cv_t<Lty>> product(lhs.rows(), lhs.columns());
+		matrix_view_impl::elementwise<kernels::elementwise_op::multiply>(lhs, rhs, product.data(), std::remove_cv_t<Lty>(),
+			[](const std::remove_cv_t<Lty>& l, const std::remove_cv_t<Lty>& r) { return l * r; });
+		return product;
+	}
+	/**
+	 * \brief Returns a `dynamic_matrix` whose elements equal those of the block viewed by `view` multiplied
+	 *        by `scale`.
+	 *
+	 * \param view Block view.
+	 * \param scale Scalar to multiply each element by.
+	 * \return Container consisting of `view` scaled by `scale`.
+	 * \complexity Linear in `rows()*columns()`, vectorized via `crsc::kernels::scale` when the rows of
+	 *             the block are contiguous.
+	 */
+	template<typename Ty
+	> dynamic_matrix<std::remove_cv_t<Ty>> matrix_scalar_product(const matrix_block_view<Ty>& view, const std::remove_cv_t<Ty>& scale) {
+		dynamic_matrix<std::remove_cv_t<Ty>> product(view.rows(), view.columns());
+		matrix_view_impl::elementwise<kernels::elementwise_op::scale>(view, view, product.data(), scale,
+			[&scale](const std::remove_cv_t<Ty>& l, const std::remove_cv_t<Ty>&) { return l * scale; });
+		return product;
+	}
+	/**
+	 * \brief Returns a `dynamic_matrix` which gives the matrix product of the blocks viewed by `lhs` and `rhs`,
+	 *        computed by `crsc::kernels::gemm` directly from the viewed storage.
+	 *
+	 * \param lhs First block view.
+	 * \param rhs Second block view.
+	 * \return Container consisting of product of `lhs` and `rhs`.
+	 * \throw Throws `std::invalid_argument` exception if `lhs.columns() != rhs.rows()`.
+	 * \complexity Linear in `lhs.rows()*rhs.columns()*lhs.columns()`.
+	 */
+	template<typename Lty,
+		typename Rty
+	> dynamic_matrix<std::remove_cv_t<Lty>> matrix_product(const matrix_block_view<Lty>& lhs, const matrix_block_view<Rty>& rhs) {
+		static_assert(std::is_same<std::remove_cv_t<Lty>, std::remove_cv_t<Rty>>::value, "matrix_block_view element types must agree.");
+		if (lhs.columns() != rhs.rows())
+			throw std::invalid_argument("matrix_block_view dimensions must agree for matrix_product.");
+		dynamic_matrix<std::remove_cv_t<Lty>> product(lhs.rows(), rhs.columns());
+		kernels::gemm(lhs.rows(), rhs.columns(), lhs.columns(),
+			static_cast<const std::remove_cv_t<Lty>*>(lhs.data()), lhs.row_stride(), lhs.column_stride(),
+			static_cast<const std::remove_cv_t<Rty>*>(rhs.data()), rhs.row_stride(), rhs.column_stride(),
+			product.data(), product.columns(), 1);
+		return product;
+	}
+	/**
+	 * \brief Computes the trace of the block viewed by `view`.
+	 *
+	 * \param view Block view.
+	 * \return Matrix trace of `view`.
+	 * \throw Throws `std::invalid_argument` exception if `view.rows() != view.columns()`.
+	 * \complexity Linear in `view.rows()`.
+	 */
+	template<typename Ty
+	> std::remove_cv_t<Ty> matrix_trace(const matrix_block_view<Ty>& view) {
+		if (view.rows() != view.columns()) throw std::invalid_argument("cannot compute trace of non-square matrix_block_view.");
+		std::remove_cv_t<Ty> trace = std::remove_cv_t<Ty>();
+		for (std::size_t i = 0; i < view.rows(); ++i)
+			trace += view(i, i);
+		return trace;
+	}
+}
+
+#endif // !MATRIX_VIEW_H
@@ -0,0 +1,516 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace crsc {
+	/**
+	 * \class small_buffer_allocator
+	 *
+	 * \brief Allocator requesting inline storage for `N` elements from the containers which recognise it, allocating
+	 *        through `Allocator` only beyond that.
+	 *
+	 * `dynamic_matrix<Ty, small_buffer_allocator<Ty, N>>` stores its elements in a `small_vector<Ty, N>`, such that
+	 * matrices of up to `N` elements never allocate. Every other container (and every function which creates
+	 * temporary storage with the allocator of a matrix) treats it as `Allocator`, from which all allocations are made.
+	 *
+	 * \tparam Ty Type of the elements.
+	 * \tparam N Number of elements held inline.
+	 * \tparam Allocator Allocator used for storage exceeding `N` elements.
+	 */
+	template<typename Ty,
+		std::size_t N,
+		class Allocator = std::allocator<Ty>
+	> class small_buffer_allocator : public std::allocator_traits<Allocator>::template rebind_alloc<Ty> {
+	public:
+		typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Ty> base_type;
+		typedef Ty value_type;
+		static constexpr std::size_t inline_capacity = N;
+		template<class Uty>
+		struct rebind {
+			typedef small_buffer_allocator<Uty, N, typename std::allocator_traits<Allocator>::template rebind_alloc<Uty>> other;
+		};
+		small_buffer_allocator() noexcept(noexcept(base_type())) {}
+		small_buffer_allocator(const base_type& _alloc) noexcept : base_type(_alloc) {}
+		template<class Uty, class UAllocator>
+		small_buffer_allocator(const small_buffer_allocator<Uty, N, UAllocator>& _other) noexcept
+			: base_type(static_cast<const UAllocator&>(_other)) {}
+	};
+	template<typename Ty, std::size_t N, class Allocator>
+	constexpr std::size_t small_buffer_allocator<Ty, N, Allocator>::inline_capacity;
+	template<typename Ty, typename Uty, std::size_t N, class Allocator, class UAllocator>
+	bool operator==(const small_buffer_allocator<Ty, N, Allocator>& _lhs, const small_buffer_allocator<Uty, N, UAllocator>& _rhs) noexcept {
+		return static_cast<const typename small_buffer_allocator<Ty, N, Allocator>::base_type&>(_lhs)
+			== static_cast<const typename small_buffer_allocator<Uty, N, UAllocator>::base_type&>(_rhs);
+	}
+	template<typename Ty, typename Uty, std::size_t N, class Allocator, class UAllocator>
+	bool operator!=(const small_buffer_allocator<Ty, N, Allocator>& _lhs, const small_buffer_allocator<Uty, N, UAllocator>& _rhs) noexcept {
+		return !(_lhs == _rhs);
+	}
+	/**
+	 * \class small_vector
+	 *
+	 * \brief A sequence container with the interface of `std::vector` which holds up to `N` elements inside the
+	 *        object itself, allocating through `Allocator` only when its size exceeds `N`.
+	 *
+	 * Creating, copying and destroying a `small_vector` of at most `N` elements performs no allocation, which makes
+	 * large numbers of short-lived small containers (e.g. 3x3 or 4x4 matrices) as cheap as plain arrays. Once the
+	 * storage has spilled to the heap the container behaves as a `std::vector`; `shrink_to_fit` returns it to the
+	 * inline storage when its size permits.
+	 *
+	 * Elements are constructed and destroyed through `std::allocator_traits<Allocator>`, in both storages.
+	 *
+	 * \remark Unlike `std::vector`, moving or swapping containers whose elements are held inline moves or swaps
+	 *         the elements individually and so invalidates iterators; it is linear in `N` rather than constant.
+	 * \tparam Ty Type of the elements.
+	 * \tparam N Number of elements held inline, greater than zero.
+	 * \tparam Allocator Allocator used for storage exceeding `N` elements.
+	 */
+	template<typename Ty,
+		std::size_t N,
+		class Allocator = std::allocator<Ty>
+	> class small_vector {
+		static_assert(N > 0U, "small_vector requires N > 0, use std::vector otherwise.");
+		typedef std::allocator_traits<Allocator> alloc_traits;
+	public:
+		// PUBLIC API TYPE DEFINITIONS
+		typedef Ty value_type;
+		typedef Allocator allocator_type;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef Ty& reference;
+		typedef const Ty& const_reference;
+		typedef Ty* pointer;
+		typedef const Ty* const_pointer;
+		typedef Ty* iterator;
+		typedef const Ty* const_iterator;
+		typedef std::reverse_iterator<iterator> reverse_iterator;
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+		static constexpr size_type inline_capacity = N;
+		// CONSTRUCTION/ASSIGNMENT
+		small_vector() noexcept(noexcept(Allocator())) : small_vector(Allocator()) {}
+		explicit small_vector(const Allocator& _alloc) noexcept : impl(_alloc, inline_data()) {}
+		/**
+		 * \brief Constructs the container with `_count` default-inserted elements.
+		 *
+		 * \complexity Linear in `_count`, allocating only if `_count > N`.
+		 */
+		explicit small_vector(size_type _count, const Allocator& _alloc = Allocator()) : small_vector(_alloc) {
+			resize(_count);
+		}
+		small_vector(size_type _count, const value_type& _val, const Allocator& _alloc = Allocator()) : small_vector(_alloc) {
+			resize(_count, _val);
+		}
+		template<class InputIt,
+			class = std::enable_if_t<!std::is_integral<InputIt>::value>
+		> small_vector(InputIt _first, InputIt _last, const Allocator& _alloc = Allocator()) : small_vector(_alloc) {
+			insert(end(), _first, _last);
+		}
+		small_vector(std::initializer_list<value_type> _init_list, const Allocator& _alloc = Allocator())
+			: small_vector(_init_list.begin(), _init_list.end(), _alloc) {}
+		small_vector(const small_vector& _other)
+			: small_vector(_other, alloc_traits::select_on_container_copy_construction(_other.get_allocator())) {}
+		small_vector(const small_vector& _other, const Allocator& _alloc) : small_vector(_alloc) {
+			reserve(_other.size());
+			append(_other.begin(), _other.end());
+		}
+		/**
+		 * \brief Move constructor. Takes ownership of the heap storage of `_other`, or moves its elements if they
+		 *        are held inline, leaving `_other` empty.
+		 *
+		 * \complexity Constant if `_other` has spilled to the heap, otherwise linear in `_other.size()`.
+		 */
+		small_vector(small_vector&& _other) noexcept(std::is_nothrow_move_constructible<value_type>::value)
+			: small_vector(static_cast<const Allocator&>(_other.impl)) {
+			steal_or_move(_other, std::true_type());
+		}
+		small_vector(small_vector&& _other, const Allocator& _alloc) : small_vector(_alloc) {
+			steal_or_move(_other, std::false_type());
+		}
+		~small_vector() {
+			clear();
+			release();
+		}
+		small_vector& operator=(const small_vector& _other) {
+			if (this != &_other) {
+				clear();
+				copy_assign_allocator(_other, typename alloc_traits::propagate_on_container_copy_assignment());
+				reserve(_other.size());
+				append(_other.begin(), _other.end());
+			}
+			return *this;
+		}
+		small_vector& operator=(small_vector&& _other) noexcept(std::is_nothrow_move_constructible<value_type>::value
+			&& (typename alloc_traits::propagate_on_container_move_assignment() || typename alloc_traits::is_always_equal())) {
+			if (this != &_other) {
+				clear();
+				move_assign_allocator(_other, typename alloc_traits::propagate_on_container_move_assignment());
+				steal_or_move(_other, std::false_type());
+			}
+			return *this;
+		}
+		small_vector& operator=(std::initializer_list<value_type> _init_list) {
+			assign(_init_list.begin(), _init_list.end());
+			return *this;
+		}
+		template<class InputIt,
+			class = std::enable_if_t<!std::is_integral<InputIt>::value>
+		> void assign(InputIt _first, InputIt _last) {
+			clear();
+			insert(end(), _first, _last);
+		}
+		void assign(size_type _count, const value_type& _val) {
+			clear();
+			resize(_count, _val);
+		}
+		allocator_type get_allocator() const { return impl; }
+		// CAPACITY
+		bool empty() const noexcept { return impl.first == impl.last; }
+		size_type size() const noexcept { return static_cast<size_type>(impl.last - impl.first); }
+		size_type max_size() const noexcept { return alloc_traits::max_size(impl); }
+		size_type capacity() const noexcept { return static_cast<size_type>(impl.cap - impl.first); }
+		/**
+		 * \brief Determines whether the elements are held in the inline storage of the container.
+		 */
+		bool is_inline() const noexcept { return impl.first == inline_data(); }
+		/**
+		 * \brief Increases the capacity of the container to at least `_new_cap`.
+		 *
+		 * \throw Throws `std::length_error` exception if `_new_cap > max_size()`.
+		 * \complexity At most linear in `size()`.
+		 * \exceptionsafety Strong guarantee if `value_type` is nothrow move constructible or copy constructible.
+		 */
+		void reserve(size_type _new_cap) {
+			if (_new_cap > capacity()) {
+				if (_new_cap > max_size()) throw std::length_error("small_vector::reserve _new_cap exceeds max_size().");
+				reallocate(_new_cap);
+			}
+		}
+		/**
+		 * \brief Reduces the capacity to `size()`, returning the elements to the inline storage if `size() <= N`.
+		 *
+		 * \complexity At most linear in `size()`.
+		 */
+		void shrink_to_fit() {
+			if (is_inline() || size() == capacity()) return;
+			if (size() <= N) move_inline();
+			else reallocate(size());
+		}
+		// ELEMENT ACCESS
+		reference at(size_type _pos) {
+			if (_pos >= size()) throw std::out_of_range("small_vector::at _pos out of range.");
+			return impl.first[_pos];
+		}
+		const_reference at(size_type _pos) const {
+			if (_pos >= size()) throw std::out_of_range("small_vector::at _pos out of range.");
+			return impl.first[_pos];
+		}
+		reference operator[](size_type _pos) noexcept { return impl.first[_pos]; }
+		const_reference operator[](size_type _pos) const noexcept { return impl.first[_pos]; }
+		reference front() noexcept { return *impl.first; }
+		const_reference front() const noexcept { return *impl.first; }
+		reference back() noexcept { return *(impl.last - 1); }
+		const_reference back() const noexcept { return *(impl.last - 1); }
+		pointer data() noexcept { return impl.first; }
+		const_pointer data() const noexcept { return impl.first; }
+		// ITERATORS
+		iterator begin() noexcept { return impl.first; }
+		const_iterator begin() const noexcept { return impl.first; }
+		const_iterator cbegin() const noexcept { return impl.first; }
+		iterator end() noexcept { return impl.last; }
+		const_iterator end() const noexcept { return impl.last; }
+		const_iterator cend() const noexcept { return impl.last; }
+		reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+		reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+		const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+		// MODIFIERS
+		void clear() noexcept {
+			destroy(impl.first, impl.last);
+			impl.last = impl.first;
+		}
+		/**
+		 * \brief Constructs an element in-place at the end of the container.
+		 *
+		 * \complexity Amortized constant.
+		 * \exceptionsafety Strong guarantee if `value_type` is nothrow move constructible or copy constructible.
+		 */
+		template<class... Args>
+		reference emplace_back(Args&&... _args) {
+			if (impl.last == impl.cap) {
+				// construct the new element before relocating, as _args may refer to existing elements
+				const size_type count = size();
+				const size_type new_cap = recommend(count + 1U);
+				pointer new_first = alloc_traits::allocate(impl, new_cap);
+				try {
+					alloc_traits::construct(impl, new_first + count, std::forward<Args>(_args)...);
+				}
+				catch (...) {
+					alloc_traits::deallocate(impl, new_first, new_cap);
+					throw;
+				}
+				try {
+					relocate(new_first);
+				}
+				catch (...) {
+					alloc_traits::destroy(impl, new_first + count);
+					alloc_traits::deallocate(impl, new_first, new_cap);
+					throw;
+				}
+				adopt(new_first, count, new_cap);
+			}
+			else alloc_traits::construct(impl, impl.last, std::forward<Args>(_args)...);
+			return *impl.last++;
+		}
+		void push_back(const value_type& _val) { emplace_back(_val); }
+		void push_back(value_type&& _val) { emplace_back(std::move(_val)); }
+		void pop_back() noexcept { alloc_traits::destroy(impl, --impl.last); }
+		template<class... Args>
+		iterator emplace(const_iterator _pos, Args&&... _args) {
+			const size_type index = static_cast<size_type>(_pos - begin());
+			emplace_back(std::forward<Args>(_args)...);
+			std::rotate(begin() + index, end() - 1, end());
+			return begin() + index;
+		}
+		iterator insert(const_iterator _pos, const value_type& _val) { return emplace(_pos, _val); }
+		iterator insert(const_iterator _pos, value_type&& _val) { return emplace(_pos, std::move(_val)); }
+		iterator insert(const_iterator _pos, size_type _count, const value_type& _val) {
+			const size_type index = static_cast<size_type>(_pos - begin());
+			const size_type old_size = size();
+			if (_count > capacity() - old_size) {
+				// _val may refer to an element of this container
+				const value_type val(_val);
+				reserve(recommend(old_size + _count));
+				for (size_type k = 0; k < _count; ++k) { alloc_traits::construct(impl, impl.last, val); ++impl.last; }
+			}
+			else {
+				for (size_type k = 0; k < _count; ++k) { alloc_traits::construct(impl, impl.last, _val); ++impl.last; }
+			}
+			std::rotate(begin() + index, begin() + old_size, end());
+			return begin() + index;
+		}
+		/**
+		 * \brief Inserts the elements of the range `[_first, _last)` before `_pos`, which must not refer to
+		 *        elements of this container.
+		 *
+		 * \return Iterator to the first inserted element, or `_pos` if the range is empty.
+		 * \complexity Linear in `std::distance(_first, _last)` plus linear in `std::distance(_pos, end())`.
+		 */
+		template<class InputIt,
+			class = std::enable_if_t<!std::is_integral<InputIt>::value>
+		> iterator insert(const_iterator _pos, InputIt _first, InputIt _last) {
+			const size_type index = static_cast<size_type>(_pos - begin());
+			const size_type old_size = size();
+			insert_reserve(_first, _last, typename std::iterator_traits<InputIt>::iterator_category());
+			for (; _first != _last; ++_first) emplace_back(*_first);
+			std::rotate(begin() + index, begin() + old_size, end());
+			return begin() + index;
+		}
+		iterator insert(const_iterator _pos, std::initializer_list<value_type> _init_list) {
+			return insert(_pos, _init_list.begin(), _init_list.end());
+		}
+		iterator erase(const_iterator _pos) { return erase(_pos, _pos + 1); }
+		/**
+		 * \brief Erases the elements in the range `[_first, _last)`.
+		 *
+		 * \return Iterator following the last removed element.
+		 * \complexity Linear in `std::distance(_first, end())`.
+		 */
+		iterator erase(const_iterator _first, const_iterator _last) {
+			iterator first = begin() + (_first - cbegin());
+			if (_first != _last) {
+				iterator new_last = std::move(first + (_last - _first), end(), first);
+				destroy(new_last, impl.last);
+				impl.last = new_last;
+			}
+			return first;
+		}
+		void resize(size_type _count) {
+			if (_count < size()) erase(begin() + _count, end());
+			else {
+				reserve(_count);
+				while (impl.last != impl.first + _count) { alloc_traits::construct(impl, impl.last); ++impl.last; }
+			}
+		}
+		void resize(size_type _count, const value_type& _val) {
+			if (_count < size()) erase(begin() + _count, end());
+			else {
+				reserve(_count);
+				while (impl.last != impl.first + _count) { alloc_traits::construct(impl, impl.last, _val); ++impl.last; }
+			}
+		}
+		/**
+		 * \brief Exchanges the contents of the container with those of `_other`.
+		 *
+		 * \complexity Constant if both containers have spilled to the heap, otherwise linear in the sizes of both.
+		 */
+		void swap(small_vector& _other) noexcept(std::is_nothrow_move_constructible<value_type>::value) {
+			if (this == &_other) return;
+			if (!is_inline() && !_other.is_inline()) {
+				swap_allocator(_other, typename alloc_traits::propagate_on_container_swap());
+				std::swap(impl.first, _other.impl.first);
+				std::swap(impl.last, _other.impl.last);
+				std::swap(impl.cap, _other.impl.cap);
+			}
+			else {
+				small_vector tmp(std::move(_other));
+				_other = std::move(*this);
+				*this = std::move(tmp);
+			}
+		}
+	private:
+		// allocator stored as a base for the empty base optimisation
+		struct storage : Allocator {
+			storage(const Allocator& _alloc, pointer _first) noexcept
+				: Allocator(_alloc), first(_first), last(_first), cap(_first + N) {}
+			pointer first;
+			pointer last;
+			pointer cap;
+		} impl;
+		typename std::aligned_storage<sizeof(Ty)*N, alignof(Ty)>::type buffer;
+		pointer inline_data() noexcept { return reinterpret_cast<pointer>(&buffer); }
+		const_pointer inline_data() const noexcept { return reinterpret_cast<const_pointer>(&buffer); }
+		size_type recommend(size_type _new_size) const {
+			if (_new_size > max_size()) throw std::length_error("small_vector size would exceed max_size().");
+			const size_type cap = capacity();
+			return cap >= max_size() / 2U ? max_size() : std::max(2U*cap, _new_size);
+		}
+		void destroy(pointer _first, pointer _last) noexcept {
+			for (; _first != _last; ++_first) alloc_traits::destroy(impl, _first);
+		}
+		// deallocates heap storage, without destroying elements, and returns to the empty inline storage
+		void release() noexcept {
+			if (!is_inline()) alloc_traits::deallocate(impl, impl.first, capacity());
+			impl.first = impl.last = inline_data();
+			impl.cap = inline_data() + N;
+		}
+		// moves (or copies, if moving may throw) the elements to uninitialized storage at _dest
+		void relocate(pointer _dest) {
+			pointer out = _dest;
+			try {
+				for (pointer p = impl.first; p != impl.last; ++p, ++out)
+					alloc_traits::construct(impl, out, std::move_if_noexcept(*p));
+			}
+			catch (...) {
+				destroy(_dest, out);
+				throw;
+			}
+		}
+		// replaces the storage with _first, holding _count relocated elements and a capacity of _cap
+		void adopt(pointer _first, size_type _count, size_type _cap) noexcept {
+			destroy(impl.first, impl.last);
+			release();
+			impl.first = _first;
+			impl.last = _first + _count;
+			impl.cap = _first + _cap;
+		}
+		// returns the elements of a container which has spilled to the heap to the (unused) inline storage
+		void move_inline() {
+			const size_type count = size();
+			pointer old_first = impl.first;
+			pointer old_last = impl.last;
+			const size_type old_cap = capacity();
+			relocate(inline_data());
+			destroy(old_first, old_last);
+			alloc_traits::deallocate(impl, old_first, old_cap);
+			impl.first = inline_data();
+			impl.last = inline_data() + count;
+			impl.cap = inline_data() + N;
+		}
+		void reallocate(size_type _new_cap) {
+			const size_type count = size();
+			pointer new_first = alloc_traits::allocate(impl, _new_cap);
+			try {
+				relocate(new_first);
+			}
+			catch (...) {
+				alloc_traits::deallocate(impl, new_first, _new_cap);
+				throw;
+			}
+			adopt(new_first, count, _new_cap);
+		}
+		template<class InputIt>
+		void append(InputIt _first, InputIt _last) {
+			for (; _first != _last; ++_first) { alloc_traits::construct(impl, impl.last, *_first); ++impl.last; }
+		}
+		template<class InputIt>
+		void insert_reserve(InputIt, InputIt, std::input_iterator_tag) {}
+		template<class ForwardIt>
+		void insert_reserve(ForwardIt _first, ForwardIt _last, std::forward_iterator_tag) {
+			const size_type count = static_cast<size_type>(std::distance(_first, _last));
+			if (count > capacity() - size()) reserve(recommend(size() + count));
+		}
+		// empties this (already cleared) container and takes the contents of _other, stealing its heap storage
+		// when the allocators permit (always, if Steal) and moving its elements otherwise
+		template<class Steal>
+		void steal_or_move(small_vector& _other, Steal) {
+			if (!_other.is_inline() && (Steal::value || alloc_equal(_other, typename alloc_traits::is_always_equal()))) {
+				release();
+				impl.first = _other.impl.first;
+				impl.last = _other.impl.last;
+				impl.cap = _other.impl.cap;
+				_other.impl.first = _other.impl.last = _other.inline_data();
+				_other.impl.cap = _other.inline_data() + N;
+			}
+			else {
+				reserve(_other.size());
+				for (pointer p = _other.impl.first; p != _other.impl.last; ++p) {
+					alloc_traits::construct(impl, impl.last, std::move(*p));
+					++impl.last;
+				}
+				_other.clear();
+			}
+		}
+		bool alloc_equal(const small_vector&, std::true_type) const noexcept { return true; }
+		bool alloc_equal(const small_vector& _other, std::false_type) const noexcept {
+			return static_cast<const Allocator&>(impl) == static_cast<const Allocator&>(_other.impl);
+		}
+		void move_assign_allocator(small_vector& _other, std::true_type) {
+			if (!alloc_equal(_other, typename alloc_traits::is_always_equal())) {
+				release();
+				static_cast<Allocator&>(impl) = std::move(static_cast<Allocator&>(_other.impl));
+			}
+		}
+		void move_assign_allocator(small_vector&, std::false_type) noexcept {}
+		void copy_assign_allocator(const small_vector& _other, std::true_type) {
+			if (!alloc_equal(_other, typename alloc_traits::is_always_equal())) {
+				release();
+				static_cast<Allocator&>(impl) = static_cast<const Allocator&>(_other.impl);
+			}
+		}
+		void copy_assign_allocator(const small_vector&, std::false_type) noexcept {}
+		void swap_allocator(small_vector& _other, std::true_type) noexcept {
+			using std::swap;
+			swap(static_cast<Allocator&>(impl), static_cast<Allocator&>(_other.impl));
+		}
+		void swap_allocator(small_vector&, std::false_type) noexcept {}
+	};
+	template<typename Ty, std::size_t N, class Allocator>
+	constexpr typename small_vector<Ty, N, Allocator>::size_type small_vector<Ty, N, Allocator>::inline_capacity;
+	template<typename Ty, std::size_t N, class Allocator>
+	bool operator==(const small_vector<Ty, N, Allocator>& _lhs, const small_vector<Ty, N, Allocator>& _rhs) {
+		return _lhs.size() == _rhs.size() && std::equal(_lhs.begin(), _lhs.end(), _rhs.begin());
+	}
+	template<typename Ty, std::size_t N, class Allocator>
+	bool operator!=(const small_vector<Ty, N, Allocator>& _lhs, const small_vector<Ty, N, Allocator>& _rhs) {
+		return !(_lhs == _rhs);
+	}
+	template<typename Ty, std::size_t N, class Allocator>
+	bool operator<(const small_vector<Ty, N, Allocator>& _lhs, const small_vector<Ty, N, Allocator>& _rhs) {
+		return std::lexicographical_compare(_lhs.begin(), _lhs.end(), _rhs.begin(), _rhs.end());
+	}
+	template<typename Ty, std::size_t N, class Allocator>
+	void swap(small_vector<Ty, N, Allocator>& _lhs, small_vector<Ty, N, Allocator>& _rhs) noexcept(noexcept(_lhs.swap(_rhs))) {
+		_lhs.swap(_rhs);
+	}
+}
+
+#endif // !SMALL_VECTOR_H
@@ -0,0 +1,643 @@
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+#include "dynamic_matrix.h"
+#include "matrix_kernels.h"
+#include "matrix_layout.h"
+#include "threading_utilities.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace crsc {
+	template<typename Ty,
+		class Allocator,
+		class Layout
+	> class sparse_matrix;
+	/**
+	 * \brief Detail namespace for implementation of `sparse_matrix` and its algorithms.
+	 */
+	namespace sparse_matrix_impl {
+		// maps (row, column) to (major, minor) and back for the compressed dimension of a layout
+		template<class Layout> struct compressed_axes;
+		template<> struct compressed_axes<row_major> {
+			static std::size_t major(std::size_t i, std::size_t) noexcept { return i; }
+			static std::size_t minor(std::size_t, std::size_t j) noexcept { return j; }
+			static std::size_t majors(std::size_t rows, std::size_t) noexcept { return rows; }
+			static std::size_t minors(std::size_t, std::size_t cols) noexcept { return cols; }
+			typedef column_major transposed_layout;
+		};
+		template<> struct compressed_axes<column_major> {
+			static std::size_t major(std::size_t, std::size_t j) noexcept { return j; }
+			static std::size_t minor(std::size_t i, std::size_t) noexcept { return i; }
+			static std::size_t majors(std::size_t, std::size_t cols) noexcept { return cols; }
+			static std::size_t minors(std::size_t rows, std::size_t) noexcept { return rows; }
+			typedef row_major transposed_layout;
+		};
+		// selects the constructor of sparse_matrix which adopts compressed arrays known to be valid
+		struct unchecked {};
+	}
+	/**
+	 * \class sparse_matrix
+	 *
+	 * \brief Container storing only the non-zero elements of a matrix in compressed form, either row by row (CSR,
+	 *        `Layout = row_major`) or column by column (CSC, `Layout = column_major`).
+	 *
+	 * Three arrays describe the matrix: `offsets()` of `majors + 1` entries, where the non-zeros of row (CSR) or
+	 * column (CSC) `k` occupy positions `[offsets()[k], offsets()[k+1])` of the other two arrays; `indices()`
+	 * giving the column (CSR) or row (CSC) of each non-zero in strictly increasing order within each row or
+	 * column; and `values()` giving the value of each non-zero. Storage is linear in the number of non-zeros
+	 * rather than in `rows()*columns()`.
+	 *
+	 * Matrices are usually assembled from unordered `(row, column, value)` triplets with a
+	 * `sparse_matrix_builder`, or converted from a `dynamic_matrix`. The sparsity pattern is fixed once
+	 * constructed, although the values of existing non-zeros may be modified through `values()`.
+	 *
+	 * \tparam Ty Type of the elements.
+	 * \tparam Allocator Type of the allocator used for the values, rebound for the index arrays.
+	 * \tparam Layout Compressed dimension, `row_major` for CSR or `column_major` for CSC.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> class sparse_matrix {
+		typedef sparse_matrix_impl::compressed_axes<Layout> axes;
+	public:
+		// PUBLIC API TYPE DEFINITIONS
+		typedef Ty value_type;
+		typedef Ty& reference;
+		typedef const Ty& const_reference;
+		typedef std::size_t size_type;
+		typedef Allocator allocator_type;
+		typedef Layout layout_type;
+		typedef typename std::allocator_traits<Allocator>::template rebind_alloc<size_type> index_allocator_type;
+		typedef std::vector<size_type, index_allocator_type> index_vector;
+		typedef std::vector<value_type, allocator_type> value_vector;
+		// CONSTRUCTION/ASSIGNMENT
+		/**
+		 * \brief Constructs an empty container of zero rows and columns.
+		 *
+		 * \complexity Constant.
+		 */
+		sparse_matrix() : sparse_matrix(0U, 0U) {}
+		/**
+		 * \brief Constructs a `_rows` by `_cols` container with no non-zero elements.
+		 *
+		 * \param _rows Number of rows.
+		 * \param _cols Number of columns.
+		 * \param alloc Allocator to use for all memory allocations of this container.
+		 * \complexity Linear in `_rows` (CSR) or `_cols` (CSC).
+		 */
+		explicit sparse_matrix(size_type _rows, size_type _cols, const Allocator& alloc = Allocator())
+			: offsets_(axes::majors(_rows, _cols) + 1U, 0U, index_allocator_type(alloc)),
+			indices_(index_allocator_type(alloc)), values_(alloc), rows_(_rows), cols_(_cols) {}
+		/**
+		 * \brief Constructs the container from existing compressed arrays.
+		 *
+		 * \param _rows Number of rows.
+		 * \param _cols Number of columns.
+		 * \param _offsets Offsets of each row (CSR) or column (CSC), see class description.
+		 * \param _indices Column (CSR) or row (CSC) index of each non-zero.
+		 * \param _values Value of each non-zero.
+		 * \throw Throws `std::invalid_argument` exception if the arrays do not describe a valid `_rows` by `_cols`
+		 *        matrix, including if the indices are not strictly increasing within each row (CSR) or column (CSC).
+		 * \complexity Linear in `_offsets.size() + _indices.size()` (validation).
+		 */
+		sparse_matrix(size_type _rows, size_type _cols, index_vector _offsets, index_vector _indices, value_vector _values)
+			: offsets_(std::move(_offsets)), indices_(std::move(_indices)), values_(std::move(_values)), rows_(_rows), cols_(_cols) {
+			const size_type majors = axes::majors(rows_, cols_), minors = axes::minors(rows_, cols_);
+			if (offsets_.size() != majors + 1U || offsets_.front() != 0U || offsets_.back() != indices_.size()
+				|| indices_.size() != values_.size())
+				throw std::invalid_argument("sparse_matrix arrays are of inconsistent sizes.");
+			for (size_type k = 0; k < majors; ++k) {
+				if (offsets_[k] > offsets_[k + 1])
+					throw std::invalid_argument("sparse_matrix offsets must be non-decreasing.");
+				for (size_type p = offsets_[k]; p < offsets_[k + 1]; ++p) {
+					if (indices_[p] >= minors || (p > offsets_[k] && indices_[p] <= indices_[p - 1]))
+						throw std::invalid_argument("sparse_matrix indices must be in range and strictly increasing.");
+				}
+			}
+		}
+		/**
+		 * \brief Constructs the container from the non-zero elements of the dense matrix `dm`.
+		 *
+		 * \param dm Dense matrix of any layout to compress.
+		 * \param alloc Allocator to use for all memory allocations of this container.
+		 * \complexity Linear in `dm.rows()*dm.columns()`.
+		 */
+		template<class DenseLayout>
+		explicit sparse_matrix(const dynamic_matrix<Ty, Allocator, DenseLayout>& dm, const Allocator& alloc = Allocator())
+			: sparse_matrix(dm.rows(), dm.columns(), alloc) {
+			const size_type majors = axes::majors(rows_, cols_), minors = axes::minors(rows_, cols_);
+			for (size_type k = 0; k < majors; ++k) {
+				for (size_type l = 0; l < minors; ++l) {
+					const Ty& val = (std::is_same<Layout, row_major>::value) ? dm(k, l) : dm(l, k);
+					if (!(val == Ty())) {
+						indices_.push_back(l);
+						values_.push_back(val);
+					}
+				}
+				offsets_[k + 1] = indices_.size();
+			}
+		}
+		/**
+		 * \brief Constructs the container from `other` stored in the other compressed layout, i.e. converts CSC
+		 *        to CSR or CSR to CSC.
+		 *
+		 * \param other Container to convert.
+		 * \complexity Linear in `other.nonzeros() + other.rows() + other.columns()`.
+		 */
+		explicit sparse_matrix(const sparse_matrix<Ty, Allocator, typename axes::transposed_layout>& other)
+			: sparse_matrix(other.rows(), other.columns(), other.get_allocator()) {
+			// counting sort of the non-zeros of other by their minor index, the major order of other keeps the
+			// indices within each new line sorted
+			const index_vector& ooff = other.offsets();
+			const index_vector& oidx = other.indices();
+			for (size_type p = 0; p < oidx.size(); ++p) ++offsets_[oidx[p] + 1];
+			std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+			indices_.resize(oidx.size());
+			values_.resize(oidx.size());
+			index_vector next(offsets_.begin(), offsets_.end() - 1, offsets_.get_allocator());
+			for (size_type k = 0; k + 1 < ooff.size(); ++k) {
+				for (size_type p = ooff[k]; p < ooff[k + 1]; ++p) {
+					const size_type q = next[oidx[p]]++;
+					indices_[q] = k;
+					values_[q] = other.values()[p];
+				}
+			}
+		}
+		allocator_type get_allocator() const { return values_.get_allocator(); }
+		// CAPACITY
+		/**
+		 * \brief Returns the number of rows.
+		 */
+		size_type rows() const noexcept { return rows_; }
+		/**
+		 * \brief Returns the number of columns.
+		 */
+		size_type columns() const noexcept { return cols_; }
+		/**
+		 * \brief Returns the number of stored (structurally non-zero) elements.
+		 */
+		size_type nonzeros() const noexcept { return values_.size(); }
+		/**
+		 * \brief Returns `true` if the container has no rows or no columns.
+		 */
+		bool empty() const noexcept { return !rows_ || !cols_; }
+		// ELEMENT ACCESS
+		/**
+		 * \brief Returns the value of element `(_row_index, _col_index)`, which is `Ty()` if it is not stored.
+		 *
+		 * \throw Throws `std::out_of_range` exception if either index is out of range.
+		 * \complexity Logarithmic in the number of non-zeros of the row (CSR) or column (CSC).
+		 */
+		value_type at(size_type _row_index, size_type _col_index) const {
+			if (_row_index >= rows_ || _col_index >= cols_)
+				throw std::out_of_range("sparse_matrix index out of bounds.");
+			return (*this)(_row_index, _col_index);
+		}
+		/**
+		 * \brief Returns the value of element `(_row_index, _col_index)`, which is `Ty()` if it is not stored. No
+		 *        bounds checking is performed.
+		 *
+		 * \complexity Logarithmic in the number of non-zeros of the row (CSR) or column (CSC).
+		 */
+		value_type operator()(size_type _row_index, size_type _col_index) const {
+			const size_type k = axes::major(_row_index, _col_index), l = axes::minor(_row_index, _col_index);
+			const auto first = indices_.begin() + offsets_[k], last = indices_.begin() + offsets_[k + 1];
+			const auto it = std::lower_bound(first, last, l);
+			return (it != last && *it == l) ? values_[it - indices_.begin()] : value_type();
+		}
+		/**
+		 * \brief Returns the offsets of each row (CSR) or column (CSC) into `indices()` and `values()`.
+		 */
+		const index_vector& offsets() const noexcept { return offsets_; }
+		/**
+		 * \brief Returns the column (CSR) or row (CSC) index of each non-zero.
+		 */
+		const index_vector& indices() const noexcept { return indices_; }
+		/**
+		 * \brief Returns the value of each non-zero.
+		 */
+		const value_vector& values() const noexcept { return values_; }
+		/**
+		 * \brief Returns the value of each non-zero, which may be modified without changing the sparsity pattern.
+		 */
+		value_vector& values() noexcept { return values_; }
+		// OPERATIONS
+		/**
+		 * \brief Returns the transpose of the container in the other compressed layout, which shares the same
+		 *        compressed arrays, e.g. the transpose of a CSR matrix is the CSC matrix with identical arrays.
+		 *
+		 * \complexity Linear in `nonzeros()` (copy of the arrays).
+		 */
+		sparse_matrix<Ty, Allocator, typename axes::transposed_layout> transposed() const {
+			return sparse_matrix<Ty, Allocator, typename axes::transposed_layout>(cols_, rows_, offsets_, indices_, values_, sparse_matrix_impl::unchecked());
+		}
+		/**
+		 * \brief Returns the dense equivalent of the container.
+		 *
+		 * \tparam DenseLayout Layout of the returned `dynamic_matrix`.
+		 * \complexity Linear in `rows()*columns()`.
+		 */
+		template<class DenseLayout = row_major>
+		dynamic_matrix<Ty, Allocator, DenseLayout> to_dense() const {
+			dynamic_matrix<Ty, Allocator, DenseLayout> dm(rows_, cols_, value_type(), get_allocator());
+			for (size_type k = 0; k + 1 < offsets_.size(); ++k) {
+				for (size_type p = offsets_[k]; p < offsets_[k + 1]; ++p) {
+					if (std::is_same<Layout, row_major>::value) dm(k, indices_[p]) = values_[p];
+					else dm(indices_[p], k) = values_[p];
+				}
+			}
+			return dm;
+		}
+		/**
+		 * \brief Exchanges the contents of the container with those of `_other`.
+		 *
+		 * \complexity Constant.
+		 */
+		void swap(sparse_matrix& _other) {
+			offsets_.swap(_other.offsets_);
+			indices_.swap(_other.indices_);
+			values_.swap(_other.values_);
+			std::swap(rows_, _other.rows_);
+			std::swap(cols_, _other.cols_);
+		}
+		/**
+		 * \brief Checks for equality of the dimensions, sparsity patterns and values of this container and `_other`.
+		 *
+		 * \complexity Linear in `nonzeros()`.
+		 */
+		bool operator==(const sparse_matrix& _other) const {
+			return rows_ == _other.rows_ && cols_ == _other.cols_ && offsets_ == _other.offsets_
+				&& indices_ == _other.indices_ && values_ == _other.values_;
+		}
+		bool operator!=(const sparse_matrix& _other) const { return !(*this == _other); }
+	private:
+		template<typename, class, class> friend class sparse_matrix;
+		template<typename, class> friend class sparse_matrix_builder;
+		index_vector offsets_;
+		index_vector indices_;
+		value_vector values_;
+		size_type rows_;
+		size_type cols_;
+		sparse_matrix(size_type _rows, size_type _cols, index_vector _offsets, index_vector _indices, value_vector _values, sparse_matrix_impl::unchecked)
+			: offsets_(std::move(_offsets)), indices_(std::move(_indices)), values_(std::move(_values)), rows_(_rows), cols_(_cols) {}
+	};
+	/**
+	 * \brief Alias for a `sparse_matrix` in compressed sparse row format.
+	 */
+	template<typename Ty, class Allocator = std::allocator<Ty>>
+	using csr_matrix = sparse_matrix<Ty, Allocator, row_major>;
+	/**
+	 * \brief Alias for a `sparse_matrix` in compressed sparse column format.
+	 */
+	template<typename Ty, class Allocator = std::allocator<Ty>>
+	using csc_matrix = sparse_matrix<Ty, Allocator, column_major>;
+	/**
+	 * \class sparse_matrix_builder
+	 *
+	 * \brief Incremental builder of a `sparse_matrix` from `(row, column, value)` triplets (coordinate or "COO"
+	 *        format) given in any order, duplicate positions being summed.
+	 *
+	 * \tparam Ty Type of the elements.
+	 * \tparam Allocator Type of the allocator used for the values, rebound for the indices.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>
+	> class sparse_matrix_builder {
+	public:
+		typedef Ty value_type;
+		typedef std::size_t size_type;
+		typedef Allocator allocator_type;
+		/**
+		 * \brief Constructs a builder for a `_rows` by `_cols` matrix with no triplets.
+		 */
+		explicit sparse_matrix_builder(size_type _rows, size_type _cols, const Allocator& alloc = Allocator())
+			: row_idx(index_allocator_type(alloc)), col_idx(index_allocator_type(alloc)), vals(alloc), rows_(_rows), cols_(_cols) {}
+		size_type rows() const noexcept { return rows_; }
+		size_type columns() const noexcept { return cols_; }
+		/**
+		 * \brief Returns the number of triplets added, counting duplicates.
+		 */
+		size_type size() const noexcept { return vals.size(); }
+		/**
+		 * \brief Reserves storage for `_count` triplets.
+		 */
+		void reserve(size_type _count) {
+			row_idx.reserve(_count);
+			col_idx.reserve(_count);
+			vals.reserve(_count);
+		}
+		/**
+		 * \brief Adds `_val` to the element at `(_row_index, _col_index)`.
+		 *
+		 * \throw Throws `std::out_of_range` exception if either index is out of range.
+		 * \complexity Amortised constant.
+		 * \exceptionsafety Strong guarantee.
+		 */
+		void add(size_type _row_index, size_type _col_index, const value_type& _val) {
+			if (_row_index >= rows_ || _col_index >= cols_)
+				throw std::out_of_range("sparse_matrix_builder index out of bounds.");
+			row_idx.push_back(_row_index);
+			try {
+				col_idx.push_back(_col_index);
+				try { vals.push_back(_val); }
+				catch (...) { col_idx.pop_back(); throw; }
+			}
+			catch (...) { row_idx.pop_back(); throw; }
+		}
+		/**
+		 * \brief Removes all triplets, keeping the dimensions.
+		 */
+		void clear() noexcept {
+			row_idx.clear();
+			col_idx.clear();
+			vals.clear();
+		}
+		/**
+		 * \brief Compresses the triplets into a `sparse_matrix`, summing the values of duplicate positions. The
+		 *        builder is left unchanged.
+		 *
+		 * \tparam Layout `row_major` to build a CSR matrix, `column_major` to build a CSC matrix.
+		 * \complexity Linear in `size()` plus the cost of sorting the triplets of each row (CSR) or column (CSC).
+		 */
+		template<class Layout = row_major>
+		sparse_matrix<Ty, Allocator, Layout> build() const {
+			typedef sparse_matrix_impl::compressed_axes<Layout> axes;
+			typedef sparse_matrix<Ty, Allocator, Layout> result_type;
+			const size_type n = vals.size();
+			const index_vector& major = std::is_same<Layout, row_major>::value ? row_idx : col_idx;
+			const index_vector& minor = std::is_same<Layout, row_major>::value ? col_idx : row_idx;
+			index_vector offsets(axes::majors(rows_, cols_) + 1U, 0U, row_idx.get_allocator());
+			for (size_type t = 0; t < n; ++t) ++offsets[major[t] + 1];
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+			// triplet numbers bucketed by line, then ordered by minor index within each line such that duplicates
+			// are adjacent and summed in the order they were added
+			index_vector order(n, 0U, row_idx.get_allocator());
+			{
+				index_vector next(offsets.begin(), offsets.end() - 1, row_idx.get_allocator());
+				for (size_type t = 0; t < n; ++t) order[next[major[t]]++] = t;
+			}
+			index_vector indices(row_idx.get_allocator());
+			typename result_type::value_vector values(vals.get_allocator());
+			indices.reserve(n);
+			values.reserve(n);
+			size_type line_first = 0U;
+			for (size_type k = 0; k + 1 < offsets.size(); ++k) {
+				const auto first = order.begin() + offsets[k], last = order.begin() + offsets[k + 1];
+				std::stable_sort(first, last, [&minor](size_type s, size_type t) { return minor[s] < minor[t]; });
+				for (auto it = first; it != last; ++it) {
+					if (indices.size() > line_first && indices.back() == minor[*it]) values.back() += vals[*it];
+					else {
+						indices.push_back(minor[*it]);
+						values.push_back(vals[*it]);
+					}
+				}
+				offsets[k] = line_first;
+				line_first = indices.size();
+			}
+			offsets.back() = line_first;
+			return result_type(rows_, cols_, std::move(offsets), std::move(indices), std::move(values),
+				sparse_matrix_impl::unchecked());
+		}
+	private:
+		typedef typename std::allocator_traits<Allocator>::template rebind_alloc<size_type> index_allocator_type;
+		typedef std::vector<size_type, index_allocator_type> index_vector;
+		index_vector row_idx;
+		index_vector col_idx;
+		std::vector<value_type, allocator_type> vals;
+		size_type rows_;
+		size_type cols_;
+	};
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> void swap(sparse_matrix<Ty, Allocator, Layout>& lhs, sparse_matrix<Ty, Allocator, Layout>& rhs) {
+		lhs.swap(rhs);
+	}
+	namespace parallel_cutoffs {
+		// non-zeros of the sparse operand
+		constexpr std::size_t sparse_product = 1U << 15;
+	}
+	namespace sparse_matrix_impl {
+		// y[first, last) = A[first, last)*x for rows of a CSR matrix, each row a dot product of its non-zeros with x
+		template<typename Ty, class IndexVector>
+		void csr_spmv_rows(std::size_t first, std::size_t last, const IndexVector& off, const IndexVector& idx,
+			const Ty* val, const Ty* x, Ty* y) {
+			for (std::size_t i = first; i < last; ++i) {
+				Ty sum = Ty();
+				for (std::size_t p = off[i]; p < off[i + 1]; ++p) sum += val[p] * x[idx[p]];
+				y[i] = sum;
+			}
+		}
+		// y += A[:, first, last)*x[first, last) for columns of a CSC matrix, scattering each column scaled by x
+		template<typename Ty, class IndexVector>
+		void csc_spmv_columns(std::size_t first, std::size_t last, const IndexVector& off, const IndexVector& idx,
+			const Ty* val, const Ty* x, Ty* y) {
+			for (std::size_t j = first; j < last; ++j) {
+				const Ty& xj = x[j];
+				for (std::size_t p = off[j]; p < off[j + 1]; ++p) y[idx[p]] += val[p] * xj;
+			}
+		}
+		template<typename Ty, class Allocator>
+		void spmv(thread_pool* pool, const sparse_matrix<Ty, Allocator, row_major>& sm, const Ty* x, Ty* y) {
+			const std::size_t m = sm.rows();
+			const auto& off = sm.offsets();
+			const auto& idx = sm.indices();
+			const Ty* val = sm.values().data();
+			if (!pool) {
+				csr_spmv_rows(0U, m, off, idx, val, x, y);
+				return;
+			}
+			// rows differ in their numbers of non-zeros, so several chunks per thread balance the load
+			pool->parallel_for(0U, m, dynamic_matrix_parallel_impl::chunk_size(m, 4U * (pool->size() + 1U), 64U),
+				[&off, &idx, val, x, y](std::size_t first, std::size_t last) {
+				csr_spmv_rows(first, last, off, idx, val, x, y);
+			});
+		}
+		// columns of a CSC matrix scatter into every row, so each chunk of columns accumulates into its own vector
+		// and the partial vectors are summed
+		template<typename Ty, class Allocator>
+		void spmv(thread_pool* pool, const sparse_matrix<Ty, Allocator, column_major>& sm, const Ty* x, Ty* y) {
+			const std::size_t m = sm.rows(), n = sm.columns();
+			const auto& off = sm.offsets();
+			const auto& idx = sm.indices();
+			const Ty* val = sm.values().data();
+			if (!pool) {
+				std::fill(y, y + m, Ty());
+				csc_spmv_columns(0U, n, off, idx, val, x, y);
+				return;
+			}
+			const std::size_t chunk = dynamic_matrix_parallel_impl::chunk_size(n, pool->size() + 1U, 64U);
+			std::vector<std::vector<Ty>> partials((n + chunk - 1) / chunk);
+			pool->parallel_for(0U, n, chunk, [&off, &idx, val, x, m, chunk, &partials](std::size_t first, std::size_t last) {
+				std::vector<Ty>& part = partials[first / chunk];
+				part.assign(m, Ty());
+				csc_spmv_columns(first, last, off, idx, val, x, part.data());
+			});
+			pool->parallel_for(0U, m, dynamic_matrix_parallel_impl::chunk_size(m, pool->size() + 1U, 64U),
+				[&partials, y](std::size_t first, std::size_t last) {
+				for (std::size_t i = first; i < last; ++i) {
+					Ty sum = Ty();
+					for (const auto& part : partials) sum += part[i];
+					y[i] = sum;
+				}
+			});
+		}
+		template<typename Ty>
+		void strided_axpy(std::size_t n, const Ty& alpha, const Ty* x, std::ptrdiff_t incx, Ty* y, std::ptrdiff_t incy) {
+			if (incx == 1 && incy == 1) kernels::axpy(alpha, x, y, n);
+			else {
+				for (std::size_t k = 0; k < n; ++k) y[k*incy] += alpha * x[k*incx];
+			}
+		}
+		// C[first, last) += A[first, last)*B for rows of a CSR matrix A, where B and C are strided dense matrices of
+		// n columns - each non-zero scales a row of B into a row of C
+		template<typename Ty, class Allocator>
+		void spmm(std::size_t first, std::size_t last, const sparse_matrix<Ty, Allocator, row_major>& a, std::size_t n,
+			const Ty* b, std::ptrdiff_t rsb, std::ptrdiff_t csb, Ty* c, std::ptrdiff_t rsc, std::ptrdiff_t csc) {
+			const auto& off = a.offsets();
+			const auto& idx = a.indices();
+			const auto& val = a.values();
+			for (std::size_t i = first; i < last; ++i) {
+				for (std::size_t p = off[i]; p < off[i + 1]; ++p)
+					strided_axpy(n, val[p], b + idx[p]*rsb, csb, c + i*rsc, csc);
+			}
+		}
+		// C[:, first, last) += A*B[:, first, last) for a CSC matrix A, i.e. over a range of the dense columns as
+		// every column of A scatters into all rows of C
+		template<typename Ty, class Allocator>
+		void spmm(std::size_t first, std::size_t last, const sparse_matrix<Ty, Allocator, column_major>& a, std::size_t,
+			const Ty* b, std::ptrdiff_t rsb, std::ptrdiff_t csb, Ty* c, std::ptrdiff_t rsc, std::ptrdiff_t csc) {
+			const auto& off = a.offsets();
+			const auto& idx = a.indices();
+			const auto& val = a.values();
+			for (std::size_t j = 0; j + 1 < off.size(); ++j) {
+				for (std::size_t p = off[j]; p < off[j + 1]; ++p)
+					strided_axpy(last - first, val[p], b + j*rsb + first*csb, csb, c + idx[p]*rsc + first*csc, csc);
+			}
+		}
+		// extent of the range partitioned by spmm, rows of the result for CSR and columns for CSC
+		template<typename Ty, class Allocator>
+		std::size_t spmm_extent(const sparse_matrix<Ty, Allocator, row_major>& a, std::size_t) { return a.rows(); }
+		template<typename Ty, class Allocator>
+		std::size_t spmm_extent(const sparse_matrix<Ty, Allocator, column_major>&, std::size_t n) { return n; }
+	}
+	/**
+	 * \brief Computes the product `sm*x` of a sparse matrix with a dense vector.
+	 *
+	 * \param sm Instance of `sparse_matrix`.
+	 * \param x Vector of `sm.columns()` elements.
+	 * \return Vector of `sm.rows()` elements.
+	 * \throw Throws `std::invalid_argument` exception if `x.size() != sm.columns()`.
+	 * \complexity Linear in `sm.nonzeros()` plus linear in `sm.rows()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<Ty, Allocator> matrix_vector_product(const sparse_matrix<Ty, Allocator, Layout>& sm, const std::vector<Ty, Allocator>& x) {
+		if (x.size() != sm.columns())
+			throw std::invalid_argument("sparse_matrix columns must equal vector size for matrix_vector_product.");
+		std::vector<Ty, Allocator> y(sm.rows(), Ty(), x.get_allocator());
+		sparse_matrix_impl::spmv(nullptr, sm, x.data(), y.data());
+		return y;
+	}
+	/**
+	 * \brief Computes the product `sm*x` of a sparse matrix with a dense vector across the threads of `pool`.
+	 *
+	 * For CSR matrices the rows of the result are partitioned across the threads. For CSC matrices each thread
+	 * accumulates the contribution of a range of columns into a private vector and these are then summed, so CSR
+	 * is preferable for repeated products.
+	 *
+	 * \param pool Thread pool on which to execute.
+	 * \param sm Instance of `sparse_matrix`.
+	 * \param x Vector of `sm.columns()` elements.
+	 * \param cutoff Number of non-zeros below which the serial `matrix_vector_product` is used.
+	 * \return Vector of `sm.rows()` elements.
+	 * \throw Throws `std::invalid_argument` exception if `x.size() != sm.columns()`.
+	 * \complexity Linear in `sm.nonzeros()` plus linear in `sm.rows()`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major
+	> std::vector<Ty, Allocator> matrix_vector_product(thread_pool& pool, const sparse_matrix<Ty, Allocator, Layout>& sm, const std::vector<Ty, Allocator>& x,
+		std::size_t cutoff = parallel_cutoffs::sparse_product) {
+		if (sm.nonzeros() < cutoff || pool.size() < 2U) return matrix_vector_product(sm, x);
+		if (x.size() != sm.columns())
+			throw std::invalid_argument("sparse_matrix columns must equal vector size for matrix_vector_product.");
+		std::vector<Ty, Allocator> y(sm.rows(), Ty(), x.get_allocator());
+		sparse_matrix_impl::spmv(&pool, sm, x.data(), y.data());
+		return y;
+	}
+	/**
+	 * \brief Computes the product of a sparse matrix `lhs` with a dense matrix `rhs`.
+	 *
+	 * Each non-zero of `lhs` adds a scaled row of `rhs` to a row of the result, such that the dense operands are
+	 * only accessed by whole rows when they are `row_major`.
+	 *
+	 * \param lhs Instance of `sparse_matrix`.
+	 * \param rhs Instance of `dynamic_matrix` with a strided layout.
+	 * \return Dense product with the layout of `rhs`.
+	 * \throw Throws `std::invalid_argument` exception if `lhs.columns() != rhs.rows()`.
+	 * \complexity Linear in `lhs.nonzeros()*rhs.columns()` plus linear in `lhs.rows()*rhs.columns()`.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major,
+		class DenseLayout = row_major
+	> dynamic_matrix<Ty, Allocator, DenseLayout> matrix_product(const sparse_matrix<Ty, Allocator, Layout>& lhs, const dynamic_matrix<Ty, Allocator, DenseLayout>& rhs) {
+		static_assert(is_strided_layout<DenseLayout>::value, "sparse matrix_product requires a strided dense layout.");
+		if (lhs.columns() != rhs.rows())
+			throw std::invalid_argument("matrix dimensions must agree for matrix_product.");
+		const std::size_t m = lhs.rows(), k = rhs.rows(), n = rhs.columns();
+		dynamic_matrix<Ty, Allocator, DenseLayout> product(m, n, Ty(), rhs.get_allocator());
+		sparse_matrix_impl::spmm(0U, sparse_matrix_impl::spmm_extent(lhs, n), lhs, n,
+			rhs.data(), DenseLayout::row_stride(k, n), DenseLayout::column_stride(k, n),
+			product.data(), DenseLayout::row_stride(m, n), DenseLayout::column_stride(m, n));
+		return product;
+	}
+	/**
+	 * \brief Computes the product of a sparse matrix `lhs` with a dense matrix `rhs` across the threads of `pool`,
+	 *        partitioning the rows of the result for CSR `lhs` and the columns of the result for CSC `lhs`.
+	 *
+	 * \param pool Thread pool on which to execute.
+	 * \param lhs Instance of `sparse_matrix`.
+	 * \param rhs Instance of `dynamic_matrix` with a strided layout.
+	 * \param cutoff Number of multiply-adds, `lhs.nonzeros()*rhs.columns()`, below which the serial
+	 *        `matrix_product` is used.
+	 * \return Dense product with the layout of `rhs`.
+	 * \throw Throws `std::invalid_argument` exception if `lhs.columns() != rhs.rows()`.
+	 * \complexity Linear in `lhs.nonzeros()*rhs.columns()` plus linear in `lhs.rows()*rhs.columns()`, divided
+	 *             across `pool.size() + 1` threads.
+	 */
+	template<typename Ty,
+		class Allocator = std::allocator<Ty>,
+		class Layout = row_major,
+		class DenseLayout = row_major
+	> dynamic_matrix<Ty, Allocator, DenseLayout> matrix_product(thread_pool& pool, const sparse_matrix<Ty, Allocator, Layout>& lhs, const dynamic_matrix<Ty, Allocator, DenseLayout>& rhs,
+		std::size_t cutoff = parallel_cutoffs::sparse_product) {
+		static_assert(is_strided_layout<DenseLayout>::value, "sparse matrix_product requires a strided dense layout.");
+		if (lhs.nonzeros()*rhs.columns() < cutoff || pool.size() < 2U) return matrix_product(lhs, rhs);
+		if (lhs.columns() != rhs.rows())
+			throw std::invalid_argument("matrix dimensions must agree for matrix_product.");
+		const std::size_t m = lhs.rows(), k = rhs.rows(), n = rhs.columns();
+		dynamic_matrix<Ty, Allocator, DenseLayout> product(m, n, Ty(), rhs.get_allocator());
+		const std::size_t extent = sparse_matrix_impl::spmm_extent(lhs, n);
+		const Ty* b = rhs.data();
+		Ty* c = product.data();
+		const std::ptrdiff_t rsb = DenseLayout::row_stride(k, n), csb = DenseLayout::column_stride(k, n);
+		const std::ptrdiff_t rsc = DenseLayout::row_stride(m, n), csc = DenseLayout::column_stride(m, n);
+		pool.parallel_for(0U, extent, dynamic_matrix_parallel_impl::chunk_size(extent, 4U * (pool.size() + 1U), 16U),
+			[&lhs, n, b, rsb, csb, c, rsc, csc](std::size_t first, std::size_t last) {
+			sparse_matrix_impl::spmm(first, last, lhs, n, b, rsb, csb, c, rsc, csc);
+		});
+		return product;
+	}
+}
+
+#endif // !SPARSE_MATRIX_H
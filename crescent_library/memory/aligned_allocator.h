@@ -0,0 +1,207 @@
+#ifndef ALIGNED_ALLOCATOR_H
+#define ALIGNED_ALLOCATOR_H
+#include "threading_utilities.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#if defined(_WIN32)
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace crsc {
+	/**
+	 * \brief Sizes assumed by `aligned_allocator` and `first_touch`.
+	 *
+	 * - `cache_line_size` - bytes per cache line, the default alignment of `aligned_allocator`.
+	 * - `page_size` - bytes per (small) virtual memory page.
+	 * - `huge_page_size` - bytes per transparent huge page.
+	 */
+	namespace memory_constants {
+		constexpr std::size_t cache_line_size = 64U;
+		constexpr std::size_t page_size = 4096U;
+		constexpr std::size_t huge_page_size = 2U * 1024U * 1024U;
+	}
+	/**
+	 * \brief Options of `aligned_allocator`, which may be combined with bitwise or.
+	 *
+	 * - `none` - aligned allocation only.
+	 * - `huge_pages` - blocks of at least `memory_constants::huge_page_size` bytes are aligned to, and padded to a
+	 *                  multiple of, the huge page size and the operating system is advised to back them with
+	 *                  transparent huge pages (`madvise(MADV_HUGEPAGE)`), reducing TLB misses for large matrices.
+	 *                  The advice is ignored where unsupported.
+	 * - `uninitialized` - elements of trivially default constructible types are default-initialized rather than
+	 *                     value-initialized when a container constructs them without a value, e.g. in
+	 *                     `dynamic_matrix(rows, cols)`, such that their pages are not touched (and so not yet
+	 *                     placed on a NUMA node) until `first_touch` or the first write.
+	 */
+	namespace allocation_options {
+		constexpr unsigned none = 0U;
+		constexpr unsigned huge_pages = 1U;
+		constexpr unsigned uninitialized = 2U;
+	}
+	/**
+	 * \brief Detail namespace for implementation of `aligned_allocator`.
+	 */
+	namespace aligned_allocator_impl {
+		inline void* allocate(std::size_t bytes, std::size_t alignment) {
+			alignment = std::max(alignment, sizeof(void*));
+			void* p = nullptr;
+#if defined(_WIN32)
+			p = _aligned_malloc(bytes, alignment);
+#else
+			if (posix_memalign(&p, alignment, bytes)) p = nullptr;
+#endif
+			if (!p) throw std::bad_alloc();
+			return p;
+		}
+		inline void deallocate(void* p) noexcept {
+#if defined(_WIN32)
+			_aligned_free(p);
+#else
+			std::free(p);
+#endif
+		}
+		inline void advise_huge_pages(void* p, std::size_t bytes) noexcept {
+#if defined(MADV_HUGEPAGE)
+			madvise(p, bytes, MADV_HUGEPAGE);
+#else
+			(void)p;
+			(void)bytes;
+#endif
+		}
+	}
+	/**
+	 * \class aligned_allocator
+	 *
+	 * \brief Stateless allocator returning storage aligned to at least `Alignment` bytes, by default a cache line,
+	 *        such that vector loads of the elements of a container never straddle two cache lines.
+	 *
+	 * Usable as the `Allocator` of `dynamic_matrix`, `mathematical_dynamic_matrix` and any standard container,
+	 * e.g. `dynamic_matrix<double, aligned_allocator<double>>`. All instances compare equal.
+	 *
+	 * \tparam Ty Type of the elements.
+	 * \tparam Alignment Minimum alignment in bytes, a power of two.
+	 * \tparam Options Combination of `allocation_options`.
+	 */
+	template<typename Ty,
+		std::size_t Alignment = memory_constants::cache_line_size,
+		unsigned Options = allocation_options::none
+	> class aligned_allocator {
+		static_assert(Alignment && !(Alignment & (Alignment - 1U)), "aligned_allocator Alignment must be a power of two.");
+	public:
+		typedef Ty value_type;
+		typedef Ty* pointer;
+		typedef const Ty* const_pointer;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef std::true_type is_always_equal;
+		typedef std::true_type propagate_on_container_move_assignment;
+		template<class Uty>
+		struct rebind {
+			typedef aligned_allocator<Uty, Alignment, Options> other;
+		};
+		aligned_allocator() noexcept {}
+		template<class Uty>
+		aligned_allocator(const aligned_allocator<Uty, Alignment, Options>&) noexcept {}
+		/**
+		 * \brief Allocates uninitialized storage for `n` objects of type `Ty`.
+		 *
+		 * \throw Throws `std::bad_alloc` exception if the allocation fails or `n > max_size()`.
+		 * \complexity Unspecified, the pages of the storage are not touched.
+		 */
+		Ty* allocate(size_type n) {
+			if (n > max_size()) throw std::bad_alloc();
+			if (!n) return nullptr;
+			std::size_t bytes = n*sizeof(Ty);
+			std::size_t alignment = std::max(Alignment, alignof(Ty));
+			const bool huge = (Options & allocation_options::huge_pages) && bytes >= memory_constants::huge_page_size;
+			if (huge) {
+				alignment = std::max(alignment, memory_constants::huge_page_size);
+				bytes = (bytes + memory_constants::huge_page_size - 1U) / memory_constants::huge_page_size * memory_constants::huge_page_size;
+			}
+			void* p = aligned_allocator_impl::allocate(bytes, alignment);
+			if (huge) aligned_allocator_impl::advise_huge_pages(p, bytes);
+			return static_cast<Ty*>(p);
+		}
+		/**
+		 * \brief Deallocates the storage pointed to by `p`, which must have been obtained from `allocate`.
+		 */
+		void deallocate(Ty* p, size_type) noexcept {
+			if (p) aligned_allocator_impl::deallocate(p);
+		}
+		size_type max_size() const noexcept {
+			return std::numeric_limits<size_type>::max() / sizeof(Ty);
+		}
+		/**
+		 * \brief Constructs an object of type `Uty` at `p` from `args`. Without arguments the object is
+		 *        value-initialized, or default-initialized if `Options` includes `allocation_options::uninitialized`
+		 *        and `Uty` is trivially default constructible.
+		 */
+		template<class Uty, class... Args>
+		void construct(Uty* p, Args&&... args) {
+			construct_impl(p, std::integral_constant<bool, sizeof...(Args) == 0U
+				&& (Options & allocation_options::uninitialized) != 0U
+				&& std::is_trivially_default_constructible<Uty>::value>(), std::forward<Args>(args)...);
+		}
+		template<class Uty>
+		void destroy(Uty* p) {
+			p->~Uty();
+		}
+	private:
+		template<class Uty>
+		static void construct_impl(Uty* p, std::true_type) {
+			::new (static_cast<void*>(p)) Uty;
+		}
+		template<class Uty, class... Args>
+		static void construct_impl(Uty* p, std::false_type, Args&&... args) {
+			::new (static_cast<void*>(p)) Uty(std::forward<Args>(args)...);
+		}
+	};
+	template<typename Ty, typename Uty, std::size_t Alignment, unsigned Options>
+	bool operator==(const aligned_allocator<Ty, Alignment, Options>&, const aligned_allocator<Uty, Alignment, Options>&) noexcept {
+		return true;
+	}
+	template<typename Ty, typename Uty, std::size_t Alignment, unsigned Options>
+	bool operator!=(const aligned_allocator<Ty, Alignment, Options>&, const aligned_allocator<Uty, Alignment, Options>&) noexcept {
+		return false;
+	}
+	/**
+	 * \brief Allocator for large matrices: cache line aligned, backed by transparent huge pages where possible and
+	 *        leaving arithmetic elements uninitialized for `first_touch`.
+	 */
+	template<typename Ty>
+	using huge_page_allocator = aligned_allocator<Ty, memory_constants::cache_line_size,
+		allocation_options::huge_pages | allocation_options::uninitialized>;
+	/**
+	 * \brief Writes `value` to each of the `n` elements starting at `first`, with contiguous runs of whole pages
+	 *        written by each of the threads of `pool`.
+	 *
+	 * Operating systems place a page on the NUMA node of the thread which first writes to it. Initializing storage
+	 * which has not yet been touched (see `allocation_options::uninitialized`) with the same partitioning as the
+	 * parallel algorithms which later process it therefore keeps most accesses local to the node of the accessing
+	 * thread. The threads of `pool` are not pinned, so placement follows the operating system's scheduling.
+	 *
+	 * \param pool Thread pool on which to execute.
+	 * \param first Pointer to the first element, e.g. `dm.data()`.
+	 * \param n Number of elements.
+	 * \param value Value to assign to each element.
+	 * \complexity Linear in `n`, divided across `pool.size() + 1` threads.
+	 */
+	template<typename Ty>
+	void first_touch(thread_pool& pool, Ty* first, std::size_t n, const Ty& value = Ty()) {
+		const std::size_t per_page = std::max<std::size_t>(1U, memory_constants::page_size / sizeof(Ty));
+		const std::size_t threads = pool.size() + 1U;
+		const std::size_t grain = ((n + threads - 1U) / threads + per_page - 1U) / per_page * per_page;
+		pool.parallel_for(0U, n, grain, [first, &value](std::size_t chunk_first, std::size_t chunk_last) {
+			std::fill(first + chunk_first, first + chunk_last, value);
+		});
+	}
+}
+
+#endif // !ALIGNED_ALLOCATOR_H
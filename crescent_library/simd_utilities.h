@@ -0,0 +1,251 @@
+#ifndef SIMD_UTILITIES_H
+#define SIMD_UTILITIES_H
+#include <cstddef>
+
+// x86/x64 targets get explicit SSE2/AVX2/AVX-512 kernels, everything else uses the scalar fallbacks
+#if !defined(CRSC_DISABLE_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define CRSC_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang require functions using intrinsics beyond the baseline instruction set to be annotated
+// with the target they are compiled for, MSVC allows any intrinsic in any function
+#if defined(__GNUC__) || defined(__clang__)
+#define CRSC_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CRSC_TARGET(isa)
+#endif
+
+// kernels with vector paths which are also constexpr select their scalar path during constant evaluation, compilers
+// without the builtin always take the scalar path
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define CRSC_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+#if !defined(CRSC_IS_CONSTANT_EVALUATED)
+#if (defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#define CRSC_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#define CRSC_IS_CONSTANT_EVALUATED() true
+#endif
+#endif
+
+// instruction sets the compiler may emit unconditionally for the build target, kernels too small to amortise
+// a run-time dispatch (e.g. those of `crsc::fixed_matrix`) use these directly so they inline to vector code
+#if defined(CRSC_SIMD_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define CRSC_SIMD_BASELINE_SSE2 1
+#endif
+#if defined(CRSC_SIMD_X86) && defined(__AVX2__)
+#define CRSC_SIMD_BASELINE_AVX2 1
+#endif
+
+namespace crsc {
+	/**
+	 * \enum simd_level
+	 *
+	 * \brief Widest vector instruction set usable by kernels on the executing CPU, in increasing order.
+	 */
+	enum class simd_level {
+		scalar,
+		sse2,
+		avx2,
+		avx512
+	};
+	/**
+	 * \brief Detail namespace for implementation of `detect_simd_level`.
+	 */
+	namespace simd_level_impl {
+		inline simd_level query_cpu() noexcept {
+#if defined(CRSC_SIMD_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 0);
+			const int max_leaf = info[0];
+			__cpuid(info, 1);
+			const bool sse2 = (info[3] & (1 << 26)) != 0;
+			const bool osxsave = (info[2] & (1 << 27)) != 0;
+			// the OS must save the ymm/zmm register state on context switch for AVX/AVX-512 to be usable
+			const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0ULL;
+			bool avx2 = false, avx512 = false;
+			if (max_leaf >= 7) {
+				__cpuidex(info, 7, 0);
+				avx2 = (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+				avx512 = (info[1] & (1 << 16)) != 0 && (xcr0 & 0xe6) == 0xe6;
+			}
+			if (avx512) return simd_level::avx512;
+			if (avx2) return simd_level::avx2;
+			if (sse2) return simd_level::sse2;
+#else
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx512f")) return simd_level::avx512;
+			if (__builtin_cpu_supports("avx2")) return simd_level::avx2;
+			if (__builtin_cpu_supports("sse2")) return simd_level::sse2;
+#endif
+#endif
+			return simd_level::scalar;
+		}
+	}
+	/**
+	 * \brief Detects the widest vector instruction set supported by both the executing CPU and operating
+	 *        system. The CPU is queried once, subsequent calls return the cached result.
+	 *
+	 * \return `simd_level` usable on this machine, always `simd_level::scalar` on non-x86 targets or if
+	 *         `CRSC_DISABLE_SIMD` is defined.
+	 * \complexity Constant.
+	 * \exceptionsafety No-throw guarantee, `noexcept` specification.
+	 */
+	inline simd_level detect_simd_level() noexcept {
+		static const simd_level level = simd_level_impl::query_cpu();
+		return level;
+	}
+#if defined(CRSC_SIMD_X86)
+	/**
+	 * \brief Thin wrappers over the vector registers of each supported instruction set, giving kernels a
+	 *        uniform interface (`load`, `store`, `set1`, `add`, `sub`, `mul`, `div`, `min`, `max`,
+	 *        `abs`) parameterised on the element type. Each wrapper exposes `value_type`, the register type `reg`
+	 *        and the number of lanes `width`. The SSE2 and AVX2 wrappers also provide `transpose(reg* rows)`, which
+	 *        transposes the square tile held in `width` consecutive registers in place.
+	 *
+	 * \warning Functions using these wrappers must themselves be annotated with the matching
+	 *          `CRSC_TARGET` so that the wrappers are inlined.
+	 */
+	namespace simd {
+		template<typename Ty> struct sse2_vec;
+		template<typename Ty> struct avx2_vec;
+		template<typename Ty> struct avx512_vec;
+		template<> struct sse2_vec<double> {
+			typedef double value_type;
+			typedef __m128d reg;
+			static constexpr std::size_t width = 2U;
+			CRSC_TARGET("sse2") static reg load(const double* p) { return _mm_loadu_pd(p); }
+			CRSC_TARGET("sse2") static void store(double* p, reg v) { _mm_storeu_pd(p, v); }
+			CRSC_TARGET("sse2") static reg set1(double s) { return _mm_set1_pd(s); }
+			CRSC_TARGET("sse2") static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+			CRSC_TARGET("sse2") static reg sub(reg a, reg b) { return _mm_sub_pd(a, b); }
+			CRSC_TARGET("sse2") static reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+			CRSC_TARGET("sse2") static reg div(reg a, reg b) { return _mm_div_pd(a, b); }
+			CRSC_TARGET("sse2") static reg min(reg a, reg b) { return _mm_min_pd(a, b); }
+			CRSC_TARGET("sse2") static reg max(reg a, reg b) { return _mm_max_pd(a, b); }
+			CRSC_TARGET("sse2") static reg abs(reg a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+			CRSC_TARGET("sse2") static void transpose(reg* rows) {
+				const reg lo = _mm_unpacklo_pd(rows[0], rows[1]);
+				rows[1] = _mm_unpackhi_pd(rows[0], rows[1]);
+				rows[0] = lo;
+			}
+		};
+		template<> struct sse2_vec<float> {
+			typedef float value_type;
+			typedef __m128 reg;
+			static constexpr std::size_t width = 4U;
+			CRSC_TARGET("sse2") static reg load(const float* p) { return _mm_loadu_ps(p); }
+			CRSC_TARGET("sse2") static void store(float* p, reg v) { _mm_storeu_ps(p, v); }
+			CRSC_TARGET("sse2") static reg set1(float s) { return _mm_set1_ps(s); }
+			CRSC_TARGET("sse2") static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+			CRSC_TARGET("sse2") static reg sub(reg a, reg b) { return _mm_sub_ps(a, b); }
+			CRSC_TARGET("sse2") static reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+			CRSC_TARGET("sse2") static reg div(reg a, reg b) { return _mm_div_ps(a, b); }
+			CRSC_TARGET("sse2") static reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+			CRSC_TARGET("sse2") static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+			CRSC_TARGET("sse2") static reg abs(reg a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+			CRSC_TARGET("sse2") static void transpose(reg* rows) {
+				_MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+			}
+		};
+		template<> struct avx2_vec<double> {
+			typedef double value_type;
+			typedef __m256d reg;
+			static constexpr std::size_t width = 4U;
+			CRSC_TARGET("avx2") static reg load(const double* p) { return _mm256_loadu_pd(p); }
+			CRSC_TARGET("avx2") static void store(double* p, reg v) { _mm256_storeu_pd(p, v); }
+			CRSC_TARGET("avx2") static reg set1(double s) { return _mm256_set1_pd(s); }
+			CRSC_TARGET("avx2") static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+			CRSC_TARGET("avx2") static reg sub(reg a, reg b) { return _mm256_sub_pd(a, b); }
+			CRSC_TARGET("avx2") static reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+			CRSC_TARGET("avx2") static reg div(reg a, reg b) { return _mm256_div_pd(a, b); }
+			CRSC_TARGET("avx2") static reg min(reg a, reg b) { return _mm256_min_pd(a, b); }
+			CRSC_TARGET("avx2") static reg max(reg a, reg b) { return _mm256_max_pd(a, b); }
+			CRSC_TARGET("avx2") static reg abs(reg a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+			CRSC_TARGET("avx2") static void transpose(reg* rows) {
+				const reg t0 = _mm256_unpacklo_pd(rows[0], rows[1]);
+				const reg t1 = _mm256_unpackhi_pd(rows[0], rows[1]);
+				const reg t2 = _mm256_unpacklo_pd(rows[2], rows[3]);
+				const reg t3 = _mm256_unpackhi_pd(rows[2], rows[3]);
+				rows[0] = _mm256_permute2f128_pd(t0, t2, 0x20);
+				rows[1] = _mm256_permute2f128_pd(t1, t3, 0x20);
+				rows[2] = _mm256_permute2f128_pd(t0, t2, 0x31);
+				rows[3] = _mm256_permute2f128_pd(t1, t3, 0x31);
+			}
+		};
+		template<> struct avx2_vec<float> {
+			typedef float value_type;
+			typedef __m256 reg;
+			static constexpr std::size_t width = 8U;
+			CRSC_TARGET("avx2") static reg load(const float* p) { return _mm256_loadu_ps(p); }
+			CRSC_TARGET("avx2") static void store(float* p, reg v) { _mm256_storeu_ps(p, v); }
+			CRSC_TARGET("avx2") static reg set1(float s) { return _mm256_set1_ps(s); }
+			CRSC_TARGET("avx2") static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+			CRSC_TARGET("avx2") static reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+			CRSC_TARGET("avx2") static reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+			CRSC_TARGET("avx2") static reg div(reg a, reg b) { return _mm256_div_ps(a, b); }
+			CRSC_TARGET("avx2") static reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+			CRSC_TARGET("avx2") static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+			CRSC_TARGET("avx2") static reg abs(reg a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+			CRSC_TARGET("avx2") static void transpose(reg* rows) {
+				reg t[8], u[8];
+				for (int i = 0; i < 8; i += 2) {
+					t[i] = _mm256_unpacklo_ps(rows[i], rows[i + 1]);
+					t[i + 1] = _mm256_unpackhi_ps(rows[i], rows[i + 1]);
+				}
+				for (int i = 0; i < 8; i += 4) {
+					u[i] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+					u[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+					u[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+					u[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+				}
+				for (int i = 0; i < 4; ++i) {
+					rows[i] = _mm256_permute2f128_ps(u[i], u[i + 4], 0x20);
+					rows[i + 4] = _mm256_permute2f128_ps(u[i], u[i + 4], 0x31);
+				}
+			}
+		};
+		// min and max use the masked forms with every lane selected, as the unmasked forms merge into an
+		// undefined register which GCC reports as possibly uninitialized
+		template<> struct avx512_vec<double> {
+			typedef double value_type;
+			typedef __m512d reg;
+			static constexpr std::size_t width = 8U;
+			CRSC_TARGET("avx512f") static reg load(const double* p) { return _mm512_loadu_pd(p); }
+			CRSC_TARGET("avx512f") static void store(double* p, reg v) { _mm512_storeu_pd(p, v); }
+			CRSC_TARGET("avx512f") static reg set1(double s) { return _mm512_set1_pd(s); }
+			CRSC_TARGET("avx512f") static reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+			CRSC_TARGET("avx512f") static reg sub(reg a, reg b) { return _mm512_sub_pd(a, b); }
+			CRSC_TARGET("avx512f") static reg mul(reg a, reg b) { return _mm512_mul_pd(a, b); }
+			CRSC_TARGET("avx512f") static reg div(reg a, reg b) { return _mm512_div_pd(a, b); }
+			CRSC_TARGET("avx512f") static reg min(reg a, reg b) { return _mm512_mask_min_pd(a, 0xFF, a, b); }
+			CRSC_TARGET("avx512f") static reg max(reg a, reg b) { return _mm512_mask_max_pd(a, 0xFF, a, b); }
+			CRSC_TARGET("avx512f") static reg abs(reg a) { return _mm512_abs_pd(a); }
+		};
+		template<> struct avx512_vec<float> {
+			typedef float value_type;
+			typedef __m512 reg;
+			static constexpr std::size_t width = 16U;
+			CRSC_TARGET("avx512f") static reg load(const float* p) { return _mm512_loadu_ps(p); }
+			CRSC_TARGET("avx512f") static void store(float* p, reg v) { _mm512_storeu_ps(p, v); }
+			CRSC_TARGET("avx512f") static reg set1(float s) { return _mm512_set1_ps(s); }
+			CRSC_TARGET("avx512f") static reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+			CRSC_TARGET("avx512f") static reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+			CRSC_TARGET("avx512f") static reg mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+			CRSC_TARGET("avx512f") static reg div(reg a, reg b) { return _mm512_div_ps(a, b); }
+			CRSC_TARGET("avx512f") static reg min(reg a, reg b) { return _mm512_mask_min_ps(a, 0xFFFF, a, b); }
+			CRSC_TARGET("avx512f") static reg max(reg a, reg b) { return _mm512_mask_max_ps(a, 0xFFFF, a, b); }
+			CRSC_TARGET("avx512f") static reg abs(reg a) { return _mm512_abs_ps(a); }
+		};
+	}
+#endif
+}
+
+#endif // !SIMD_UTILITIES_H
@@ -1,7 +1,16 @@
 #ifndef SEMAPHORE_H
 #define SEMAPHORE_H
-#include <mutex>
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace crsc {
     /**
@@ -41,6 +50,134 @@ namespace crsc {
         std::condition_variable cv;
         std::size_t count;
     };
+    /**
+     * \class thread_pool
+     *
+     * \brief A fixed-size pool of worker threads executing tasks from a shared FIFO queue.
+     *
+     * Tasks are submitted via `submit`, which returns a `std::future` for the result of the task. Loops over an
+     * index range may be distributed across the pool via `parallel_for`, in which the calling thread also takes
+     * part such that nested use from within a task cannot deadlock.
+     */
+    class thread_pool {
+    public:
+        /**
+         * \brief Constructs the pool with `_nthreads` worker threads.
+         *
+         * \param _nthreads Number of worker threads, defaults to `std::thread::hardware_concurrency()` (or 1 if
+         *        this is not computable).
+         */
+        explicit thread_pool(std::size_t _nthreads = std::max(1U, std::thread::hardware_concurrency()))
+            : stopping(false) {
+            workers.reserve(_nthreads);
+            for (std::size_t i = 0; i < _nthreads; ++i)
+                workers.emplace_back([this]() { worker_loop(); });
+        }
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+        /**
+         * \brief Finishes all queued tasks then joins the worker threads.
+         */
+        ~thread_pool() {
+            {
+                std::unique_lock<std::mutex> lock(mut);
+                stopping = true;
+            }
+            cv.notify_all();
+            for (auto& w : workers) w.join();
+        }
+        /**
+         * \brief Returns the number of worker threads in the pool.
+         */
+        std::size_t size() const noexcept { return workers.size(); }
+        /**
+         * \brief Enqueues the callable `f` for execution by a worker thread.
+         *
+         * \param f Callable taking no arguments.
+         * \return `std::future` holding the result of `f()` or any exception it throws.
+         */
+        template<class F>
+        std::future<decltype(std::declval<F&>()())> submit(F&& f) {
+            typedef decltype(std::declval<F&>()()) result_type;
+            auto task = std::make_shared<std::packaged_task<result_type()>>(std::forward<F>(f));
+            std::future<result_type> fut = task->get_future();
+            {
+                std::unique_lock<std::mutex> lock(mut);
+                tasks.emplace_back([task]() { (*task)(); });
+            }
+            cv.notify_one();
+            return fut;
+        }
+        /**
+         * \brief Invokes `f(chunk_first, chunk_last)` over consecutive chunks of at most `grain` indices covering
+         *        `[first, last)`, distributing the chunks across the worker threads and the calling thread. Returns
+         *        once every chunk has been processed.
+         *
+         * \param first Beginning of the index range.
+         * \param last End of the index range.
+         * \param grain Maximum number of indices per chunk, values of zero are treated as one.
+         * \param f Callable with signature `void(std::size_t, std::size_t)`, must be safe to invoke concurrently
+         *        on disjoint chunks.
+         * \throw Rethrows the first exception thrown by any invocation of `f` after all chunks are done.
+         */
+        template<class F>
+        void parallel_for(std::size_t first, std::size_t last, std::size_t grain, F f) {
+            if (first >= last) return;
+            if (!grain) grain = 1;
+            const std::size_t nchunks = (last - first + grain - 1) / grain;
+            if (nchunks == 1) { f(first, last); return; }
+            // state is shared with helper tasks which may only start after the loop has completed
+            struct loop_state {
+                std::atomic<std::size_t> next_chunk{ 0 };
+                std::size_t done_chunks = 0;
+                std::exception_ptr error;
+                std::mutex mut;
+                std::condition_variable cv;
+            };
+            auto state = std::make_shared<loop_state>();
+            auto run_chunks = [state, first, last, grain, nchunks, f]() {
+                for (std::size_t c = state->next_chunk++; c < nchunks; c = state->next_chunk++) {
+                    const std::size_t cfirst = first + c*grain;
+                    try { f(cfirst, std::min(last, cfirst + grain)); }
+                    catch (...) {
+                        std::unique_lock<std::mutex> lock(state->mut);
+                        if (!state->error) state->error = std::current_exception();
+                    }
+                    std::unique_lock<std::mutex> lock(state->mut);
+                    if (++state->done_chunks == nchunks) state->cv.notify_all();
+                }
+            };
+            const std::size_t helpers = std::min(size(), nchunks - 1);
+            {
+                std::unique_lock<std::mutex> lock(mut);
+                for (std::size_t i = 0; i < helpers; ++i) tasks.emplace_back(run_chunks);
+            }
+            cv.notify_all();
+            run_chunks();
+            std::unique_lock<std::mutex> lock(state->mut);
+            state->cv.wait(lock, [&state, nchunks]() { return state->done_chunks == nchunks; });
+            if (state->error) std::rethrow_exception(state->error);
+        }
+    private:
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+        std::mutex mut;
+        std::condition_variable cv;
+        bool stopping;
+        void worker_loop() {
+            for (;;) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(mut);
+                    cv.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                    if (tasks.empty()) return;
+                    task = std::move(tasks.front());
+                    tasks.pop_front();
+                }
+                task();
+            }
+        }
+    };
 }
 
 #endif // !SEMAPHORE_H
\ No newline at end of file